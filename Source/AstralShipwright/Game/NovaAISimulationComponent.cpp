@@ -174,7 +174,7 @@ void UNovaAISimulationComponent::Load(const FNovaAIStateSave& SaveData)
 	// New game
 	else
 	{
-		CreateGame();
+		CreateGame(InitialTechnicalSpacecraftCount);
 	}
 }
 
@@ -197,12 +197,67 @@ void UNovaAISimulationComponent::TickComponent(float DeltaTime, ELevelTick TickT
 	}
 }
 
+double UNovaAISimulationComponent::GetSpawnDistance()
+{
+	return SpacecraftSpawnDistanceKm;
+}
+
+FNovaTime UNovaAISimulationComponent::GetNextEventTime() const
+{
+	const ANovaGameState* GameState = Cast<ANovaGameState>(GetOwner());
+	NCHECK(GameState);
+	const UNovaOrbitalSimulationComponent* OrbitalSimulation = GameState->GetOrbitalSimulation();
+	NCHECK(OrbitalSimulation);
+
+	const FNovaTime CurrentTime   = GameState->GetCurrentTime();
+	FNovaTime       NextEventTime = FNovaTime::FromMinutes(DBL_MAX);
+
+	auto AddEvent = [&](FNovaTime Time)
+	{
+		if (Time > CurrentTime)
+		{
+			NextEventTime = FMath::Min(NextEventTime, Time);
+		}
+	};
+
+	// Match the transitions of ProcessNavigation
+	for (const TPair<FGuid, FNovaAISpacecraftState>& IdentifierAndSpacecraft : SpacecraftDatabase)
+	{
+		const FNovaAISpacecraftState& SpacecraftState = IdentifierAndSpacecraft.Value;
+
+		if (SpacecraftState.CurrentState == ENovaAISpacecraftState::Trajectory)
+		{
+			const FNovaTime        MinArrivalTime = SpacecraftState.CurrentStateStartTime + FNovaTime::FromMinutes(TrajectoryMinDuration);
+			const FNovaTrajectory* Trajectory     = OrbitalSimulation->GetSpacecraftTrajectory(IdentifierAndSpacecraft.Key);
+
+			if (Trajectory)
+			{
+				AddEvent(Trajectory->GetFirstManeuverStartTime());
+				AddEvent(FMath::Max(Trajectory->GetArrivalTime(), MinArrivalTime));
+			}
+			else
+			{
+				AddEvent(MinArrivalTime);
+			}
+		}
+		else if (SpacecraftState.CurrentState == ENovaAISpacecraftState::Station)
+		{
+			AddEvent(SpacecraftState.CurrentStateStartTime + FNovaTime::FromMinutes(StationWaitTime));
+			AddEvent(SpacecraftState.CurrentStateStartTime + FNovaTime::FromMinutes(StationPatrolTimeout));
+		}
+	}
+
+	return NextEventTime;
+}
+
 /*----------------------------------------------------
     Internals high level
 ----------------------------------------------------*/
 
 void UNovaAISimulationComponent::ProcessQuotas()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAIQuotas);
+
 	AreasQuotas.Empty();
 
 	// Iterate over the AI database
@@ -227,6 +282,8 @@ void UNovaAISimulationComponent::ProcessQuotas()
 
 void UNovaAISimulationComponent::ProcessSpawning()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAISpawning);
+
 	// Get game state pointers
 	ANovaGameState* GameState = Cast<ANovaGameState>(GetOwner());
 	NCHECK(GameState);
@@ -234,45 +291,70 @@ void UNovaAISimulationComponent::ProcessSpawning()
 	NCHECK(OrbitalSimulation);
 	const FNovaOrbitalLocation* PlayerLocation = OrbitalSimulation->GetPlayerLocation();
 
-	// Iterate over all spacecraft locations
+	// Only process spacecraft near the player, as well as the ones already spawned
 	if (PlayerLocation)
 	{
-		for (const TPair<FGuid, FNovaOrbitalLocation>& IdentifierAndLocation : OrbitalSimulation->GetSpacecraftLocations())
+		const TNovaOrbitalLocationStore<FGuid>& SpacecraftLocations     = OrbitalSimulation->GetSpacecraftLocations();
+		const FVector2D                         PlayerCartesianLocation = OrbitalSimulation->GetPlayerCartesianLocation();
+
+		// Ships are considered private when they're at any unloaded station
+		auto IsStationPrivate = [GameState](const FNovaAISpacecraftState& SpacecraftState)
+		{
+			return SpacecraftState.CurrentState == ENovaAISpacecraftState::Station && IsValid(SpacecraftState.TargetArea) &&
+			       SpacecraftState.TargetArea->LevelName != GameState->GetCurrentLevelName();
+		};
+
+		// Spawn
+		TArray<int32> NearbyIndices;
+		SpacecraftLocations.FindInRadius(PlayerCartesianLocation, SpacecraftSpawnDistanceKm, NearbyIndices);
+		const int32 AlwaysLoadedIndex = AlwaysLoadedSpacecraft.IsValid() ? SpacecraftLocations.Find(AlwaysLoadedSpacecraft) : INDEX_NONE;
+		if (AlwaysLoadedIndex != INDEX_NONE)
 		{
-			FGuid                         Identifier         = IdentifierAndLocation.Key;
-			double                        DistanceFromPlayer = IdentifierAndLocation.Value.GetDistanceTo(*PlayerLocation);
-			const FNovaAISpacecraftState* SpacecraftStatePtr = SpacecraftDatabase.Find(Identifier);
+			NearbyIndices.AddUnique(AlwaysLoadedIndex);
+		}
+		for (int32 Index : NearbyIndices)
+		{
+			const FGuid&            Identifier         = SpacecraftLocations.GetKey(Index);
+			FNovaAISpacecraftState* SpacecraftStatePtr = SpacecraftDatabase.Find(Identifier);
 
-			if (SpacecraftStatePtr)
+			if (SpacecraftStatePtr && !IsValid(SpacecraftStatePtr->PhysicalSpacecraft) && !IsStationPrivate(*SpacecraftStatePtr))
 			{
-				// Ships are considered private when they're at any unloaded station
-				bool StationPrivate = SpacecraftStatePtr->CurrentState == ENovaAISpacecraftState::Station &&
-				                      IsValid(SpacecraftStatePtr->TargetArea) &&
-				                      SpacecraftStatePtr->TargetArea->LevelName != GameState->GetCurrentLevelName();
-
-				// Spawn
-				if (!IsValid(SpacecraftStatePtr->PhysicalSpacecraft) && !StationPrivate &&
-					(Identifier == AlwaysLoadedSpacecraft || DistanceFromPlayer < SpacecraftSpawnDistanceKm))
-				{
-					ANovaSpacecraftPawn* NewSpacecraft = GetWorld()->SpawnActor<ANovaSpacecraftPawn>();
-					NCHECK(NewSpacecraft);
-					NewSpacecraft->SetSpacecraftIdentifier(Identifier);
+				ANovaSpacecraftPawn* NewSpacecraft = GetWorld()->SpawnActor<ANovaSpacecraftPawn>();
+				NCHECK(NewSpacecraft);
+				NewSpacecraft->SetSpacecraftIdentifier(Identifier);
 
-					NLOG("UNovaAISimulationComponent::ProcessSpawning : spawning '%s'", *Identifier.ToString(EGuidFormats::Short));
+				NLOG("UNovaAISimulationComponent::ProcessSpawning : spawning '%s'", *Identifier.ToString(EGuidFormats::Short));
 
-					SpacecraftDatabase[Identifier].PhysicalSpacecraft = NewSpacecraft;
+				SpacecraftStatePtr->PhysicalSpacecraft = NewSpacecraft;
+				PhysicalSpacecraftIdentifiers.Add(Identifier);
 
-					GameState->SetTimeDilation(ENovaTimeDilation::Normal);
-				}
+				GameState->SetTimeDilation(ENovaTimeDilation::Normal);
+			}
+		}
+
+		// De-spawn
+		for (auto Iterator = PhysicalSpacecraftIdentifiers.CreateIterator(); Iterator; ++Iterator)
+		{
+			const FGuid&            Identifier         = *Iterator;
+			FNovaAISpacecraftState* SpacecraftStatePtr = SpacecraftDatabase.Find(Identifier);
+
+			if (SpacecraftStatePtr == nullptr || !IsValid(SpacecraftStatePtr->PhysicalSpacecraft))
+			{
+				Iterator.RemoveCurrent();
+			}
+			else if (!AlwaysLoadedSpacecraft.IsValid())
+			{
+				const FNovaCartesianLocation* SpacecraftLocation = SpacecraftLocations.FindCartesianLocation(Identifier);
+				const double                  DistanceFromPlayer =
+					SpacecraftLocation ? FVector2D::Distance(SpacecraftLocation->Location, PlayerCartesianLocation) : 0.0;
 
-				// De-spawn
-				if (IsValid(SpacecraftStatePtr->PhysicalSpacecraft) && !AlwaysLoadedSpacecraft.IsValid() &&
-					(DistanceFromPlayer > SpacecraftDespawnDistanceKm || StationPrivate))
+				if (SpacecraftLocation && (DistanceFromPlayer > SpacecraftDespawnDistanceKm || IsStationPrivate(*SpacecraftStatePtr)))
 				{
 					NLOG("UNovaAISimulationComponent::ProcessSpawning : removing '%s'", *Identifier.ToString(EGuidFormats::Short));
 
 					SpacecraftStatePtr->PhysicalSpacecraft->Destroy();
-					SpacecraftDatabase[Identifier].PhysicalSpacecraft = nullptr;
+					SpacecraftStatePtr->PhysicalSpacecraft = nullptr;
+					Iterator.RemoveCurrent();
 				}
 			}
 		}
@@ -281,6 +363,8 @@ void UNovaAISimulationComponent::ProcessSpawning()
 
 void UNovaAISimulationComponent::ProcessNavigation()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAINavigation);
+
 	// Get game state pointers
 	ANovaGameState* GameState = Cast<ANovaGameState>(GetOwner());
 	NCHECK(GameState);
@@ -430,9 +514,9 @@ void UNovaAISimulationComponent::ProcessNavigation()
     Helpers
 ----------------------------------------------------*/
 
-void UNovaAISimulationComponent::CreateGame()
+void UNovaAISimulationComponent::CreateGame(int32 SpacecraftCount)
 {
-	NLOG("UNovaAISimulationComponent::CreateGame");
+	NLOG("UNovaAISimulationComponent::CreateGame : creating %d spacecraft", SpacecraftCount);
 
 	if (GetOwner()->GetLocalRole() == ROLE_Authority)
 	{
@@ -449,7 +533,7 @@ void UNovaAISimulationComponent::CreateGame()
 
 		// Spawn spacecraft
 		FRandomStream RandomStream;
-		for (int32 Index = 0; Index < InitialTechnicalSpacecraftCount; Index++)
+		for (int32 Index = 0; Index < SpacecraftCount; Index++)
 		{
 			// Get the location
 			const double InitialAltitude = RandomStream.FRandRange(InitialMinAltitude, InitialMaxAltitude);
@@ -504,18 +588,19 @@ void UNovaAISimulationComponent::StartTrajectory(const FNovaOrbit& SourceOrbit,
 	// Compute the best staging altitude
 	if (ExplicitAltitude == 0)
 	{
-		// Compute trajectory candidates
-		TArray<FNovaTrajectory>   Candidates;
 		FNovaTrajectoryParameters Parameters = OrbitalSimulation->PrepareTrajectory(SourceOrbit, DestinationOrbit, DeltaTime, Spacecraft);
+
+		// Compute trajectory candidates from their cost alone
+		TArray<TPair<double, FNovaTrajectoryCost>> Candidates;
 		for (double Altitude = 300; Altitude <= 1500; Altitude += 200)
 		{
 			if (Altitude != Parameters.DestinationAltitude && Altitude != Parameters.Source.Geometry.StartAltitude &&
 				Altitude != Parameters.Source.Geometry.OppositeAltitude)
 			{
-				FNovaTrajectory NewTrajectory = OrbitalSimulation->ComputeTrajectory(Parameters, Altitude);
-				if (NewTrajectory.IsValid() && NewTrajectory.TotalTravelDuration.AsDays() < 20)
+				FNovaTrajectoryCost NewCost = OrbitalSimulation->ComputeTrajectoryCost(Parameters, Altitude);
+				if (NewCost.IsValid() && NewCost.TotalTravelDuration.AsDays() < 20)
 				{
-					Candidates.Add(NewTrajectory);
+					Candidates.Add(TPair<double, FNovaTrajectoryCost>(Altitude, NewCost));
 				}
 			}
 		}
@@ -524,13 +609,15 @@ void UNovaAISimulationComponent::StartTrajectory(const FNovaOrbit& SourceOrbit,
 
 		// Sort trajectories
 		Candidates.Sort(
-			[](const FNovaTrajectory& A, const FNovaTrajectory& B)
+			[](const TPair<double, FNovaTrajectoryCost>& A, const TPair<double, FNovaTrajectoryCost>& B)
 			{
-				return A.TotalTravelDuration < B.TotalTravelDuration && A.TotalDeltaV < B.TotalDeltaV;
+				return A.Value.TotalTravelDuration < B.Value.TotalTravelDuration && A.Value.TotalDeltaV < B.Value.TotalDeltaV;
 			});
 
-		// Start trajectory
-		OrbitalSimulation->CommitTrajectory(Spacecraft, Candidates[0]);
+		// Build and start the best trajectory
+		FNovaTrajectory NewTrajectory = OrbitalSimulation->ComputeTrajectory(Parameters, Candidates[0].Key);
+		NCHECK(NewTrajectory.IsValid());
+		OrbitalSimulation->CommitTrajectory(Spacecraft, NewTrajectory);
 	}
 
 	// Use the provided altitude
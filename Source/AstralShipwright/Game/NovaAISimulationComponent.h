@@ -87,6 +87,8 @@ struct FNovaAISpacecraftState
 UCLASS(ClassGroup = (Nova))
 class UNovaAISimulationComponent : public UActorComponent
 {
+	friend class UNovaSimulationBenchmarkCommandlet;
+
 	GENERATED_BODY()
 
 public:
@@ -120,6 +122,12 @@ public:
 		AlwaysLoadedSpacecraft = Identifier;
 	}
 
+	/** Get the distance to the player in km below which physical spacecraft are spawned */
+	static double GetSpawnDistance();
+
+	/** Get the earliest upcoming time at which a spacecraft departs, arrives or leaves a station */
+	FNovaTime GetNextEventTime() const;
+
 	/*----------------------------------------------------
 	    Internals high-level
 	----------------------------------------------------*/
@@ -141,8 +149,8 @@ protected:
 
 protected:
 
-	/** Create new game data */
-	void CreateGame();
+	/** Create new game data with SpacecraftCount AI spacecraft */
+	void CreateGame(int32 SpacecraftCount);
 
 	/** Get a ship name for a tug or mining ship */
 	FString GetTechnicalShipName(FRandomStream& RandomStream, int32 Index) const;
@@ -170,6 +178,9 @@ private:
 	UPROPERTY()
 	TMap<FGuid, FNovaAISpacecraftState> SpacecraftDatabase;
 
+	// Spacecraft that currently have a physical pawn
+	TSet<FGuid> PhysicalSpacecraftIdentifiers;
+
 	// General state
 	TArray<FString>                     TechnicalNamePrefixes;
 	TArray<FString>                     TechnicalNameSuffixes;
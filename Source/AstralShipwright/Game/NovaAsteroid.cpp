@@ -2,7 +2,6 @@
 
 #include "NovaAsteroid.h"
 
-#include "NovaPlanetarium.h"
 #include "NovaGameState.h"
 #include "NovaOrbitalSimulationComponent.h"
 
@@ -24,12 +23,15 @@ FNovaAsteroidMineralSource::FNovaAsteroidMineralSource(FRandomStream& RandomStre
     Constructor
 ----------------------------------------------------*/
 
-ANovaAsteroid::ANovaAsteroid() : Super(), LoadingAssets(false)
+ANovaAsteroid::ANovaAsteroid() : Super(), LoadingAssets(false), DustSunDirection(FVector::ZeroVector)
 {
 	// Create the main mesh
 	AsteroidMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Asteroid"));
 	SetRootComponent(AsteroidMesh);
 
+	// Setup dust traces
+	DustTraceDelegate.BindUObject(this, &ANovaAsteroid::OnDustTraceCompleted);
+
 	// Defaults
 	PrimaryActorTick.bCanEverTick = true;
 	SetReplicates(false);
@@ -162,6 +164,7 @@ void ANovaAsteroid::PostLoadInitialize()
 		Emitter->SetWorldScale3D(Asteroid.Scale * FVector(1, 1, 1));
 
 		DustEmitters.Add(Emitter);
+		DustTraceHandles.Add(FTraceHandle());
 	}
 }
 
@@ -177,7 +180,7 @@ void ANovaAsteroid::ProcessMovement()
 
 		// Get locations
 		const FVector2D PlayerLocation       = OrbitalSimulation->GetPlayerCartesianLocation();
-		const FVector2D AsteroidLocation     = OrbitalSimulation->GetAsteroidLocation(Asteroid.Identifier).GetCartesianLocation();
+		const FVector2D AsteroidLocation     = OrbitalSimulation->GetAsteroidCartesianLocation(Asteroid.Identifier);
 		FVector2D       LocationInKilometers = AsteroidLocation - PlayerLocation;
 
 		// Transform the location accounting for angle and scale
@@ -192,47 +195,65 @@ void ANovaAsteroid::ProcessMovement()
 
 void ANovaAsteroid::ProcessDust()
 {
-	// Get the planetarium
-	TArray<AActor*> PlanetariumCandidates;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ANovaPlanetarium::StaticClass(), PlanetariumCandidates);
-	NCHECK(PlanetariumCandidates.Num() > 0);
-	const ANovaPlanetarium* Planetarium = Cast<ANovaPlanetarium>(PlanetariumCandidates[0]);
-
-	// Get world data
-	FVector AsteroidLocation = GetActorLocation();
-	FVector SunDirection     = Planetarium->GetSunDirection();
-	float   CollisionSize    = AsteroidMesh->GetCollisionShape().GetExtent().Size();
-
-	// Compute new FX locations
+	static constexpr double DustRefreshAngle = 2.0;
+
+	// Get the sun direction published by the planetarium, and only refresh anchors when it moved enough
+	const ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
+	NCHECK(GameState);
+	const FVector SunDirection = GameState->GetSunDirection();
+	if (SunDirection.IsZero() ||
+		(!DustSunDirection.IsZero() && (SunDirection | DustSunDirection) > FMath::Cos(FMath::DegreesToRadians(DustRefreshAngle))))
+	{
+		return;
+	}
+
+	// Get world data, the asteroid only moves afterwards, so anchors are stored relative to it
+	const FVector AsteroidLocation = GetActorLocation();
+	const float   CollisionSize    = AsteroidMesh->GetCollisionShape().GetExtent().Size();
+	DustSunDirection               = SunDirection;
+	DustTraceTransform             = AsteroidMesh->GetComponentTransform();
+
+	// Trace params
+	FCollisionQueryParams TraceParams(FName(TEXT("Asteroid Trace")), false, NULL);
+	TraceParams.bTraceComplex           = true;
+	TraceParams.bReturnPhysicalMaterial = false;
+	ECollisionChannel CollisionChannel  = ECollisionChannel::ECC_WorldDynamic;
+
+	// Issue all traces as one asynchronous batch, results are processed next frame
 	for (int32 Index = 0; Index < DustEmitters.Num(); Index++)
 	{
 		FVector RandomDirection = FVector::CrossProduct(SunDirection, DustSources[Index]);
 		RandomDirection.Normalize();
 		FVector StartPoint = AsteroidLocation + RandomDirection * CollisionSize;
 
-		// Trace params
-		FHitResult            HitResult(ForceInit);
-		FCollisionQueryParams TraceParams(FName(TEXT("Asteroid Trace")), false, NULL);
-		TraceParams.bTraceComplex           = true;
-		TraceParams.bReturnPhysicalMaterial = false;
-		ECollisionChannel CollisionChannel  = ECollisionChannel::ECC_WorldDynamic;
+		DustTraceHandles[Index] = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartPoint, AsteroidLocation,
+			CollisionChannel, TraceParams, FCollisionResponseParams::DefaultResponseParam, &DustTraceDelegate, Index);
+	}
+}
 
-		// Trace
-		bool FoundHit = GetWorld()->LineTraceSingleByChannel(HitResult, StartPoint, AsteroidLocation, CollisionChannel, TraceParams);
-		if (FoundHit && HitResult.GetActor() == this && IsValid(DustEmitters[Index]))
-		{
-			FVector EffectLocation = HitResult.Location;
+void ANovaAsteroid::OnDustTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	// Ignore results from a batch that was replaced since
+	const int32 Index = Datum.UserData;
+	if (!DustTraceHandles.IsValidIndex(Index) || DustTraceHandles[Index] != Handle || !IsValid(DustEmitters[Index]))
+	{
+		return;
+	}
+	DustTraceHandles[Index] = FTraceHandle();
 
-			if (!DustEmitters[Index]->IsActive())
-			{
-				DustEmitters[Index]->Activate();
-			}
-			DustEmitters[Index]->SetWorldLocation(EffectLocation);
-			DustEmitters[Index]->SetWorldRotation(SunDirection.Rotation());
-		}
-		else
+	// Emitters are attached to the mesh, so a relative location follows the asteroid
+	const FHitResult* HitResult = Datum.OutHits.Num() ? &Datum.OutHits[0] : nullptr;
+	if (HitResult && HitResult->bBlockingHit && HitResult->GetActor() == this)
+	{
+		if (!DustEmitters[Index]->IsActive())
 		{
-			DustEmitters[Index]->Deactivate();
+			DustEmitters[Index]->Activate();
 		}
+		DustEmitters[Index]->SetRelativeLocation(DustTraceTransform.InverseTransformPosition(HitResult->Location));
+		DustEmitters[Index]->SetWorldRotation(DustSunDirection.Rotation());
+	}
+	else
+	{
+		DustEmitters[Index]->Deactivate();
 	}
 }
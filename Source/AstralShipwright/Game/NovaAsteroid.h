@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WorldCollision.h"
 
 #include "NovaAsteroidSimulationComponent.h"
 
@@ -64,9 +65,12 @@ public:
 	/** Run the movement process */
 	void ProcessMovement();
 
-	/** Run the dust particles */
+	/** Run the dust particles, refreshing their anchors when the sun moved */
 	void ProcessDust();
 
+	/** Place a dust emitter on the surface found by an asynchronous trace */
+	void OnDustTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
 	/*----------------------------------------------------
 	    Components
 	----------------------------------------------------*/
@@ -95,4 +99,8 @@ private:
 	// Dust state
 	TArray<FVector>                  DustSources;
 	TArray<class UNiagaraComponent*> DustEmitters;
+	TArray<FTraceHandle>             DustTraceHandles;
+	FTraceDelegate                   DustTraceDelegate;
+	FTransform                       DustTraceTransform;
+	FVector                          DustSunDirection;
 };
@@ -10,6 +10,7 @@
 
 #include "Nova.h"
 
+#include "Async/Async.h"
 #include "Curves/CurveFloat.h"
 
 // Definitions
@@ -17,6 +18,8 @@ static constexpr int32 AltitudeDistributionValues = 100;
 static constexpr int32 IntegralValues             = 100;
 static constexpr int32 AsteroidSpawnDistanceKm    = 500;
 static constexpr int32 AsteroidDespawnDistanceKm  = 600;
+static constexpr int32 AsteroidChunkSize          = 256;
+static constexpr int32 AsteroidCatalogSeed        = 0;
 
 /*----------------------------------------------------
     Asteroid
@@ -42,7 +45,7 @@ FNovaAsteroid::FNovaAsteroid(FRandomStream& RandomStream, const UNovaAsteroidCon
     Constructor
 ----------------------------------------------------*/
 
-UNovaAsteroidSimulationComponent::UNovaAsteroidSimulationComponent() : Super()
+UNovaAsteroidSimulationComponent::UNovaAsteroidSimulationComponent() : Super(), CatalogRevision(0)
 {
 	// Settings
 	PrimaryComponentTick.bCanEverTick = true;
@@ -54,8 +57,13 @@ UNovaAsteroidSimulationComponent::UNovaAsteroidSimulationComponent() : Super()
 
 void UNovaAsteroidSimulationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAsteroidSpawning);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// Add asteroids generated in the background
+	PublishChunks();
+
 	// Get game state pointers
 	ANovaGameState* GameState = Cast<ANovaGameState>(GetOwner());
 	NCHECK(GameState);
@@ -63,17 +71,24 @@ void UNovaAsteroidSimulationComponent::TickComponent(float DeltaTime, ELevelTick
 	NCHECK(OrbitalSimulation);
 	const FNovaOrbitalLocation* PlayerLocation = OrbitalSimulation->GetPlayerLocation();
 
-	// Iterate over all asteroids
+	// Only process asteroids near the player, as well as the ones already spawned
 	if (PlayerLocation)
 	{
-		for (const TPair<FGuid, FNovaOrbitalLocation>& IdentifierAndLocation : OrbitalSimulation->GetAsteroidsLocations())
+		const TNovaOrbitalLocationStore<FGuid>& AsteroidLocations       = OrbitalSimulation->GetAsteroidsLocations();
+		const FVector2D                         PlayerCartesianLocation = PlayerLocation->GetCartesianLocation();
+
+		// Spawn
+		TArray<int32> NearbyIndices;
+		AsteroidLocations.FindInRadius(PlayerCartesianLocation, AsteroidSpawnDistanceKm, NearbyIndices);
+		const int32 AlwaysLoadedIndex = AlwaysLoadedAsteroid.IsValid() ? AsteroidLocations.Find(AlwaysLoadedAsteroid) : INDEX_NONE;
+		if (AlwaysLoadedIndex != INDEX_NONE)
 		{
-			FGuid  Identifier         = IdentifierAndLocation.Key;
-			double DistanceFromPlayer = IdentifierAndLocation.Value.GetDistanceTo(*PlayerLocation);
-
-			// Spawn
-			if (GetPhysicalAsteroid(Identifier) == nullptr &&
-				(Identifier == AlwaysLoadedAsteroid || DistanceFromPlayer < AsteroidSpawnDistanceKm))
+			NearbyIndices.AddUnique(AlwaysLoadedIndex);
+		}
+		for (int32 Index : NearbyIndices)
+		{
+			const FGuid& Identifier = AsteroidLocations.GetKey(Index);
+			if (GetPhysicalAsteroid(Identifier) == nullptr)
 			{
 				ANovaAsteroid* NewAsteroid = GetWorld()->SpawnActor<ANovaAsteroid>();
 				NCHECK(NewAsteroid);
@@ -84,24 +99,41 @@ void UNovaAsteroidSimulationComponent::TickComponent(float DeltaTime, ELevelTick
 
 				PhysicalAsteroidDatabase.Add(Identifier, NewAsteroid);
 			}
+		}
 
-			// De-spawn
-			if (GetPhysicalAsteroid(Identifier) != nullptr && !AlwaysLoadedAsteroid.IsValid() &&
-				DistanceFromPlayer > AsteroidDespawnDistanceKm)
+		// De-spawn
+		if (!AlwaysLoadedAsteroid.IsValid())
+		{
+			for (auto Iterator = PhysicalAsteroidDatabase.CreateIterator(); Iterator; ++Iterator)
 			{
-				ANovaAsteroid** AsteroidEntry = PhysicalAsteroidDatabase.Find(Identifier);
-				if (AsteroidEntry && !(*AsteroidEntry)->IsLoadingAssets())
+				const FNovaCartesianLocation* AsteroidLocation = AsteroidLocations.FindCartesianLocation(Iterator.Key());
+				const double                  DistanceFromPlayer =
+					AsteroidLocation ? FVector2D::Distance(AsteroidLocation->Location, PlayerCartesianLocation) : 0.0;
+
+				if (DistanceFromPlayer > AsteroidDespawnDistanceKm && !Iterator.Value()->IsLoadingAssets())
 				{
-					NLOG("UNovaAsteroidSimulationComponent::TickComponent : removing '%s'", *Identifier.ToString(EGuidFormats::Short));
+					NLOG("UNovaAsteroidSimulationComponent::TickComponent : removing '%s'", *Iterator.Key().ToString(EGuidFormats::Short));
 
-					(*AsteroidEntry)->Destroy();
-					PhysicalAsteroidDatabase.Remove(Identifier);
+					Iterator.Value()->Destroy();
+					Iterator.RemoveCurrent();
 				}
 			}
 		}
 	}
 }
 
+void UNovaAsteroidSimulationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// Running tasks only reference the job, which they release when done
+	if (GenerationJob.IsValid())
+	{
+		GenerationJob->IsCancelled = true;
+		GenerationJob.Reset();
+	}
+}
+
 /*----------------------------------------------------
     Asteroid spawning
 ----------------------------------------------------*/
@@ -112,11 +144,23 @@ void UNovaAsteroidSimulationComponent::Initialize(const UNovaAsteroidConfigurati
 	NCHECK(Configuration != nullptr);
 	NCHECK(Configuration->AltitudeDistribution != nullptr);
 
+	// Stop any previous generation
+	if (GenerationJob.IsValid())
+	{
+		GenerationJob->IsCancelled = true;
+		GenerationJob.Reset();
+	}
+
 	// Initialize our state
 	AsteroidConfiguration = Configuration;
-	SpawnedAsteroids      = 0;
-	RandomStream          = FRandomStream();
-	AsteroidDatabase.Empty();
+	AsteroidDatabase.Empty(Configuration->TotalAsteroidCount);
+	AsteroidIdentifiers.Empty(Configuration->TotalAsteroidCount);
+	CatalogRevision++;
+
+	// Setup a new generation job
+	TSharedRef<FNovaAsteroidGenerationJob, ESPMode::ThreadSafe> Job   = MakeShared<FNovaAsteroidGenerationJob, ESPMode::ThreadSafe>();
+	FNovaAsteroidGenerationSetup&                               Setup = Job->Setup;
+	Job->StartCycles = FPlatformTime::Cycles64();
 
 	// Identify quantization step
 	double MinAltitude, MaxAltitude;
@@ -131,7 +175,7 @@ void UNovaAsteroidSimulationComponent::Initialize(const UNovaAsteroidConfigurati
 	}
 
 	// Fill the lookup table, mapping integral to the source altitude with quantization for fast runs
-	IntegralToAltitudeTable.Empty();
+	Setup.AltitudesByKey.SetNum(IntegralValues);
 	double CurrentIntegral = 0.0;
 	for (double Value = 0.0; Value <= 1.0; Value += 1.0 / AltitudeDistributionValues)
 	{
@@ -139,48 +183,121 @@ void UNovaAsteroidSimulationComponent::Initialize(const UNovaAsteroidConfigurati
 		CurrentIntegral += Configuration->AltitudeDistribution->GetFloatValue(Altitude);
 
 		int32 RandomKey = FMath::RoundToInt(IntegralValues * CurrentIntegral / TotalIntegral);
-		IntegralToAltitudeTable.Add(RandomKey, Altitude);
+		if (RandomKey >= 0 && RandomKey < IntegralValues)
+		{
+			Setup.AltitudesByKey[RandomKey].Add(Altitude);
+		}
 	}
 
-	// Spawn asteroids
-	FNovaAsteroid NewAsteroid;
-	double        Altitude, Phase;
-	while (CreateAsteroid(Altitude, Phase, NewAsteroid))
+	// Resolve each random key to the nearest populated one ahead of time, instead of walking the table for every asteroid
+	Setup.ResolvedKeys.SetNum(IntegralValues);
+	for (int32 Key = 0; Key < IntegralValues; Key++)
 	{
-		AsteroidDatabase.Add(NewAsteroid.Identifier, NewAsteroid);
+		int32 ResolvedKey = Key;
+		int32 Direction   = Key < IntegralValues / 2 ? 1 : -1;
+		while (Setup.AltitudesByKey[ResolvedKey].Num() == 0)
+		{
+			ResolvedKey += Direction;
+			NCHECK(ResolvedKey >= 0 && ResolvedKey < IntegralValues);
+		}
+		Setup.ResolvedKeys[Key] = ResolvedKey;
+	}
+
+	// Start generating chunks in the background
+	Setup.Configuration = Configuration;
+	Setup.Seed          = AsteroidCatalogSeed;
+	Setup.AsteroidCount = Configuration->TotalAsteroidCount;
+	Setup.ChunkSize     = AsteroidChunkSize;
+	Setup.ChunkCount    = FMath::DivideAndRoundUp(Setup.AsteroidCount, Setup.ChunkSize);
+	if (Setup.ChunkCount > 0)
+	{
+		for (int32 ChunkIndex = 0; ChunkIndex < Setup.ChunkCount; ChunkIndex++)
+		{
+			Async(EAsyncExecution::ThreadPool,
+				[Job, ChunkIndex]()
+				{
+					GenerateChunk(Job, ChunkIndex);
+				});
+		}
+
+		GenerationJob = Job;
 	}
+
+	NLOG("UNovaAsteroidSimulationComponent::Initialize : scheduled %d asteroids in %d chunks after %.2fms", Setup.AsteroidCount,
+		Setup.ChunkCount, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Job->StartCycles));
 }
 
-bool UNovaAsteroidSimulationComponent::CreateAsteroid(double& Altitude, double& Phase, FNovaAsteroid& Asteroid)
+double UNovaAsteroidSimulationComponent::GetSpawnDistance()
 {
-	NCHECK(AsteroidConfiguration);
+	return AsteroidSpawnDistanceKm;
+}
+
+FNovaAsteroid UNovaAsteroidSimulationComponent::GenerateAsteroid(const FNovaAsteroidGenerationSetup& Setup, int32 Index)
+{
+	// Each asteroid has its own stream derived from its index, so that it doesn't depend on any other
+	FRandomStream RandomStream(static_cast<int32>(HashCombine(Setup.Seed, MurmurFinalize32(static_cast<uint32>(Index)))));
+
+	// Find altitude inputs that match the probability picked
+	const int32           RandomKey = Setup.ResolvedKeys[RandomStream.RandHelper(IntegralValues)];
+	const TArray<double>& Altitudes = Setup.AltitudesByKey[RandomKey];
 
-	if (SpawnedAsteroids < AsteroidConfiguration->TotalAsteroidCount)
+	// Get the altitude & phase
+	const double Altitude = Altitudes[RandomStream.RandHelper(Altitudes.Num() - 1)];
+	const double Phase    = RandomStream.FRandRange(0.0, 360.0);
+
+	// Generate the asteroid itself
+	return FNovaAsteroid(RandomStream, Setup.Configuration, Altitude, Phase);
+}
+
+/*----------------------------------------------------
+    Internals
+----------------------------------------------------*/
+
+void UNovaAsteroidSimulationComponent::PublishChunks()
+{
+	if (GenerationJob.IsValid())
 	{
-		// Find altitude inputs that match the probability picked
-		int32          RandomKey = RandomStream.RandHelper(IntegralValues);
-		TArray<double> Altitudes;
-		IntegralToAltitudeTable.MultiFind(RandomKey, Altitudes);
-
-		// Found one matching altitude
-		int32 Direction = RandomKey < IntegralValues / 2 ? 1 : -1;
-		while (IntegralToAltitudeTable.Find(RandomKey) == nullptr)
+		TArray<FNovaAsteroid> Chunk;
+		while (GenerationJob->CompletedChunks.Dequeue(Chunk))
 		{
-			RandomKey += Direction;
-			NCHECK(RandomKey >= 0 && RandomKey < IntegralValues);
+			for (const FNovaAsteroid& Asteroid : Chunk)
+			{
+				AsteroidDatabase.Add(Asteroid.Identifier, Asteroid);
+				AsteroidIdentifiers.Add(Asteroid.Identifier);
+			}
+			GenerationJob->PublishedChunks++;
 		}
 
-		// Get the altitude & phase
-		IntegralToAltitudeTable.MultiFind(RandomKey, Altitudes);
-		Altitude = Altitudes[RandomStream.RandHelper(Altitudes.Num() - 1)];
-		Phase    = RandomStream.FRandRange(0.0, 360.0);
+		SET_DWORD_STAT(STAT_NovaAsteroidCount, AsteroidDatabase.Num());
+		SET_MEMORY_STAT(STAT_NovaAsteroidCatalogMemory, AsteroidDatabase.GetAllocatedSize());
+
+		if (GenerationJob->PublishedChunks == GenerationJob->Setup.ChunkCount)
+		{
+			NLOG("UNovaAsteroidSimulationComponent::PublishChunks : generated %d asteroids in %.2fms", AsteroidDatabase.Num(),
+				FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - GenerationJob->StartCycles));
 
-		// Generate the asteroid itself
-		Asteroid = FNovaAsteroid(RandomStream, AsteroidConfiguration, Altitude, Phase);
+			GenerationJob.Reset();
+		}
+	}
+}
 
-		SpawnedAsteroids++;
-		return true;
+void UNovaAsteroidSimulationComponent::GenerateChunk(TSharedRef<FNovaAsteroidGenerationJob, ESPMode::ThreadSafe> Job, int32 ChunkIndex)
+{
+	if (Job->IsCancelled)
+	{
+		return;
+	}
+
+	const FNovaAsteroidGenerationSetup& Setup      = Job->Setup;
+	const int32                         FirstIndex = ChunkIndex * Setup.ChunkSize;
+	const int32                         LastIndex  = FMath::Min(FirstIndex + Setup.ChunkSize, Setup.AsteroidCount);
+
+	TArray<FNovaAsteroid> Chunk;
+	Chunk.Reserve(LastIndex - FirstIndex);
+	for (int32 Index = FirstIndex; Index < LastIndex; Index++)
+	{
+		Chunk.Add(GenerateAsteroid(Setup, Index));
 	}
 
-	return false;
+	Job->CompletedChunks.Enqueue(MoveTemp(Chunk));
 }
@@ -4,6 +4,7 @@
 
 #include "EngineMinimal.h"
 #include "NovaGameTypes.h"
+#include "Containers/Queue.h"
 #include "NovaAsteroidSimulationComponent.generated.h"
 
 /** Asteroid catalog & metadata */
@@ -79,6 +80,36 @@ struct FNovaAsteroid
 	const class UNovaResource* MineralResource;
 };
 
+/** Immutable inputs to asteroid generation, shared with the background tasks */
+struct FNovaAsteroidGenerationSetup
+{
+	FNovaAsteroidGenerationSetup() : Configuration(nullptr), Seed(0), AsteroidCount(0), ChunkSize(0), ChunkCount(0)
+	{}
+
+	const UNovaAsteroidConfiguration* Configuration;
+	uint32                            Seed;
+	int32                             AsteroidCount;
+	int32                             ChunkSize;
+	int32                             ChunkCount;
+
+	// Altitudes for each quantized integral value, and the nearest populated value for each random key
+	TArray<TArray<double>> AltitudesByKey;
+	TArray<int32>          ResolvedKeys;
+};
+
+/** Background generation of the asteroid catalog, published to the game thread chunk by chunk */
+struct FNovaAsteroidGenerationJob
+{
+	FNovaAsteroidGenerationJob() : IsCancelled(false), StartCycles(0), PublishedChunks(0)
+	{}
+
+	FNovaAsteroidGenerationSetup                    Setup;
+	TQueue<TArray<FNovaAsteroid>, EQueueMode::Mpsc> CompletedChunks;
+	TAtomic<bool>                                   IsCancelled;
+	uint64                                          StartCycles;
+	int32                                           PublishedChunks;
+};
+
 /** Asteroid spawning & update manager */
 UCLASS(ClassGroup = (Nova))
 class UNovaAsteroidSimulationComponent : public UActorComponent
@@ -95,7 +126,9 @@ public:
 
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-	/** Reset the component */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Reset the component and start generating the catalog in the background */
 	void Initialize(const UNovaAsteroidConfiguration* Configuration);
 
 	/** Get a specific asteroid */
@@ -104,12 +137,36 @@ public:
 		return AsteroidDatabase.Find(Identifier);
 	}
 
-	/** Get all asteroids */
+	/** Get all asteroids generated so far */
 	const TMap<FGuid, FNovaAsteroid>& GetAsteroids() const
 	{
 		return AsteroidDatabase;
 	}
 
+	/** Get the identifiers of all asteroids generated so far, in publication order, which only grows for a given catalog revision */
+	const TArray<FGuid>& GetAsteroidIdentifiers() const
+	{
+		return AsteroidIdentifiers;
+	}
+
+	/** Get the catalog revision, which changes whenever asteroids are replaced rather than added */
+	uint32 GetCatalogRevision() const
+	{
+		return CatalogRevision;
+	}
+
+	/** Get the distance to the player in km below which physical asteroids are spawned */
+	static double GetSpawnDistance();
+
+	/** Check whether the background generation has published the entire catalog */
+	bool IsCatalogComplete() const
+	{
+		return !GenerationJob.IsValid();
+	}
+
+	/** Regenerate a single asteroid from its index in the catalog, identically to the background generation */
+	static FNovaAsteroid GenerateAsteroid(const FNovaAsteroidGenerationSetup& Setup, int32 Index);
+
 	/** Get a physical asteroid */
 	const class ANovaAsteroid* GetPhysicalAsteroid(FGuid Identifier) const
 	{
@@ -129,8 +186,11 @@ public:
 
 protected:
 
-	/** Check if a new asteroid can be created and get its details */
-	bool CreateAsteroid(double& Altitude, double& Phase, FNovaAsteroid& Asteroid);
+	/** Move generated chunks into the asteroid database */
+	void PublishChunks();
+
+	/** Generate a contiguous range of asteroids on a worker thread */
+	static void GenerateChunk(TSharedRef<FNovaAsteroidGenerationJob, ESPMode::ThreadSafe> Job, int32 ChunkIndex);
 
 	/*----------------------------------------------------
 	    Data
@@ -141,13 +201,13 @@ private:
 	// Asteroid setup
 	const UNovaAsteroidConfiguration* AsteroidConfiguration;
 
-	// Asteroid spawning
-	int32                    SpawnedAsteroids;
-	FRandomStream            RandomStream;
-	TMultiMap<int32, double> IntegralToAltitudeTable;
+	// Asteroid generation
+	TSharedPtr<FNovaAsteroidGenerationJob, ESPMode::ThreadSafe> GenerationJob;
 
 	// Asteroid databases
 	FGuid                             AlwaysLoadedAsteroid;
 	TMap<FGuid, FNovaAsteroid>        AsteroidDatabase;
+	TArray<FGuid>                     AsteroidIdentifiers;
 	TMap<FGuid, class ANovaAsteroid*> PhysicalAsteroidDatabase;
+	uint32                            CatalogRevision;
 };
@@ -6,6 +6,8 @@
 #include "NovaGameModeStates.h"
 #include "NovaGameState.h"
 #include "NovaSaveData.h"
+#include "NovaAISimulationComponent.h"
+#include "NovaAsteroidSimulationComponent.h"
 #include "NovaOrbitalSimulationComponent.h"
 
 #include "Game/NovaPlayerStart.h"
@@ -36,6 +38,9 @@ ANovaGameMode::ANovaGameMode()
 	, DesiredStateIdentifier(ENovaGameStateIdentifier::Area)
 	, CurrentStateIdentifier(ENovaGameStateIdentifier::Area)
 	, CurrentStreamingLevelIndex(0)
+	, PrefetchedArea(nullptr)
+	, IsPrefetchingLevel(false)
+	, ShowingStreamingLevel(nullptr)
 {
 	// Defaults
 	GameStateClass        = ANovaGameState::StaticClass();
@@ -46,6 +51,7 @@ ANovaGameMode::ANovaGameMode()
 	// Settings
 	PrimaryActorTick.bCanEverTick = true;
 	bUseSeamlessTravel            = true;
+	ArrivalPrefetchLeadTime       = 30.0f;
 }
 
 /*----------------------------------------------------
@@ -81,7 +87,7 @@ void ANovaGameMode::StartPlay()
 		// Ensure valid save data exists even if the game was loaded directly on a map (PIE server)
 		if (GetLocalRole() == ROLE_Authority && !SaveManager->HasLoadedSaveData())
 		{
-			SaveManager->LoadGame<FNovaGameSave>("1");
+			FNovaSaveArchive::LoadGame("1");
 			// UNeutronContractManager::Get()->Load(SaveManager->GetCurrentSaveData<FNovaGameSave>()->ContractManagerData);
 		}
 
@@ -207,6 +213,7 @@ void ANovaGameMode::Tick(float DeltaTime)
 	if (StateMap.Num())
 	{
 		ProcessStateMachine();
+		ProcessArrivalPrefetch();
 	}
 }
 
@@ -249,14 +256,45 @@ void ANovaGameMode::ChangeArea(const UNovaArea* Area)
 		ANovaGameState* CurrentGameState = GetGameState<ANovaGameState>();
 		CurrentGameState->SetCurrentArea(Area);
 
-		// Change the level
+		// Change the level, which only has to be made visible if it was prefetched
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool   Prefetched  = Area == PrefetchedArea;
+		PrefetchedArea           = nullptr;
 		UnloadStreamingLevel(CurrentArea);
-		LoadStreamingLevel(Area,    //
-			FSimpleDelegate::CreateLambda(
-				[this]()
+
+		FSimpleDelegate OnAreaReady = FSimpleDelegate::CreateLambda(
+			[this, Area, StartCycles, Prefetched]()
+			{
+				ResetSpacecraft();
+
+				NLOG("ANovaGameMode::ChangeArea : '%s' became interactive after %.2fms (prefetched %d)", *Area->LevelName.ToString(),
+					FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles), Prefetched);
+			});
+
+		// The prefetch is still in flight, show the level when it completes instead of issuing a second load
+		if (Prefetched && IsPrefetchingLevel)
+		{
+			OnLevelPrefetchedCallback = FSimpleDelegate::CreateLambda(
+				[this, Area, OnAreaReady]()
 				{
-					ResetSpacecraft();
-				}));
+					if (GetGameState<ANovaGameState>()->GetCurrentArea() == Area)
+					{
+						ShowStreamingLevel(Area, OnAreaReady);
+					}
+				});
+		}
+
+		// The prefetch is done, the level is already loaded
+		else if (Prefetched)
+		{
+			ShowStreamingLevel(Area, OnAreaReady);
+		}
+
+		// The level has to be streamed in
+		else
+		{
+			LoadStreamingLevel(Area, OnAreaReady);
+		}
 	}
 
 	ResetSpacecraft();
@@ -414,6 +452,130 @@ void ANovaGameMode::UnloadStreamingLevel(const UNovaArea* Area, FSimpleDelegate
 	}
 }
 
+void ANovaGameMode::ShowStreamingLevel(const UNovaArea* Area, FSimpleDelegate Callback)
+{
+	NCHECK(Area);
+
+	ULevelStreaming* Level = UGameplayStatics::GetStreamingLevel(this, Area->LevelName);
+	NCHECK(Level);
+
+	NLOG("ANovaGameMode::ShowStreamingLevel : showing streaming level '%s'", *Area->LevelName.ToString());
+
+	if (Level->IsLevelVisible())
+	{
+		Callback.ExecuteIfBound();
+	}
+	else
+	{
+		ShowingStreamingLevel = Level;
+		OnLevelLoadedCallback = Callback;
+
+		Level->OnLevelShown.AddUniqueDynamic(this, &ANovaGameMode::OnLevelShown);
+		Level->SetShouldBeVisible(true);
+	}
+}
+
+void ANovaGameMode::ProcessArrivalPrefetch()
+{
+	const ANovaGameState* NovaGameState = GetGameState<ANovaGameState>();
+	NCHECK(IsValid(NovaGameState));
+	const UNovaOrbitalSimulationComponent* OrbitalSimulationComponent = NovaGameState->GetOrbitalSimulation();
+	NCHECK(IsValid(OrbitalSimulationComponent));
+
+	// Find the area we are going to arrive at soon, if any, ignoring arrivals in empty space
+	const UNovaArea*       DestinationArea  = nullptr;
+	const FNovaTrajectory* PlayerTrajectory = OrbitalSimulationComponent->GetPlayerTrajectory();
+	if (PlayerTrajectory &&
+		PlayerTrajectory->GetArrivalTime() - NovaGameState->GetCurrentTime() < FNovaTime::FromSeconds(ArrivalPrefetchLeadTime))
+	{
+		auto NearestAreaAndDistance = OrbitalSimulationComponent->GetPlayerNearestAreaAndDistanceAtArrival();
+		if (NearestAreaAndDistance.Value <= ENovaConstants::TrajectoryDistanceError)
+		{
+			DestinationArea = NearestAreaAndDistance.Key;
+		}
+	}
+
+	// Release a prefetched level that we are no longer going to, once it has finished loading
+	if (IsValid(PrefetchedArea) && !IsPrefetchingLevel && PrefetchedArea != DestinationArea &&
+		PrefetchedArea != NovaGameState->GetCurrentArea())
+	{
+		NLOG("ANovaGameMode::ProcessArrivalPrefetch : releasing '%s'", *PrefetchedArea->LevelName.ToString());
+
+		UnloadStreamingLevel(PrefetchedArea);
+		PrefetchedArea = nullptr;
+	}
+
+	// Start streaming the destination without showing it, so that the arrival only has to make it visible
+	if (IsValid(DestinationArea) && DestinationArea != NovaGameState->GetCurrentArea() && DestinationArea->LevelName != NAME_None &&
+		PrefetchedArea == nullptr && !IsPrefetchingLevel)
+	{
+		NLOG("ANovaGameMode::ProcessArrivalPrefetch : prefetching '%s'", *DestinationArea->LevelName.ToString());
+
+		FLatentActionInfo Info;
+		Info.CallbackTarget    = this;
+		Info.ExecutionFunction = "OnLevelPrefetched";
+		Info.UUID              = CurrentStreamingLevelIndex;
+		Info.Linkage           = 0;
+
+		UGameplayStatics::LoadStreamLevel(this, DestinationArea->LevelName, false, false, Info);
+		CurrentStreamingLevelIndex++;
+		PrefetchedArea     = DestinationArea;
+		IsPrefetchingLevel = true;
+
+		PrefetchAreaAssets(DestinationArea);
+	}
+}
+
+void ANovaGameMode::PrefetchAreaAssets(const UNovaArea* Area)
+{
+	const ANovaGameState* NovaGameState = GetGameState<ANovaGameState>();
+	NCHECK(IsValid(NovaGameState));
+	const UNovaOrbitalSimulationComponent* OrbitalSimulationComponent = NovaGameState->GetOrbitalSimulation();
+	NCHECK(IsValid(OrbitalSimulationComponent));
+	const UNovaAsteroidSimulationComponent* AsteroidSimulationComponent = NovaGameState->GetAsteroidSimulation();
+	NCHECK(IsValid(AsteroidSimulationComponent));
+
+	const FVector2D         AreaLocation = OrbitalSimulationComponent->GetAreaLocation(Area).GetCartesianLocation();
+	TArray<FSoftObjectPath> RequestedAssets;
+	TArray<int32>           NearbyIndices;
+
+	// Spacecraft parts, for spacecraft that will be spawned on arrival
+	const TNovaOrbitalLocationStore<FGuid>& SpacecraftLocations = OrbitalSimulationComponent->GetSpacecraftLocations();
+	SpacecraftLocations.FindInRadius(AreaLocation, UNovaAISimulationComponent::GetSpawnDistance(), NearbyIndices);
+	for (int32 Index : NearbyIndices)
+	{
+		const FNovaSpacecraft* Spacecraft = NovaGameState->GetSpacecraft(SpacecraftLocations.GetKey(Index));
+		if (Spacecraft)
+		{
+			for (const FSoftObjectPath& Asset : Spacecraft->GetAsyncAssets())
+			{
+				RequestedAssets.AddUnique(Asset);
+			}
+		}
+	}
+
+	// Asteroid meshes and effects, for asteroids that will be spawned on arrival
+	NearbyIndices.Reset();
+	const TNovaOrbitalLocationStore<FGuid>& AsteroidLocations = OrbitalSimulationComponent->GetAsteroidsLocations();
+	AsteroidLocations.FindInRadius(AreaLocation, UNovaAsteroidSimulationComponent::GetSpawnDistance(), NearbyIndices);
+	for (int32 Index : NearbyIndices)
+	{
+		const FNovaAsteroid* Asteroid = AsteroidSimulationComponent->GetAsteroid(AsteroidLocations.GetKey(Index));
+		if (Asteroid)
+		{
+			RequestedAssets.AddUnique(Asteroid->Mesh.ToSoftObjectPath());
+			RequestedAssets.AddUnique(Asteroid->DustEffect.ToSoftObjectPath());
+		}
+	}
+
+	NLOG("ANovaGameMode::PrefetchAreaAssets : loading %d assets for '%s'", RequestedAssets.Num(), *Area->LevelName.ToString());
+
+	if (RequestedAssets.Num())
+	{
+		UNeutronAssetManager::Get()->LoadAssets(RequestedAssets);
+	}
+}
+
 void ANovaGameMode::OnLevelLoaded()
 {
 	NLOG("ANovaGameMode::OnLevelLoaded");
@@ -428,4 +590,28 @@ void ANovaGameMode::OnLevelUnLoaded()
 	OnLevelUnloadedCallback.ExecuteIfBound();
 }
 
+void ANovaGameMode::OnLevelPrefetched()
+{
+	NLOG("ANovaGameMode::OnLevelPrefetched");
+
+	IsPrefetchingLevel = false;
+
+	FSimpleDelegate Callback = OnLevelPrefetchedCallback;
+	OnLevelPrefetchedCallback.Unbind();
+	Callback.ExecuteIfBound();
+}
+
+void ANovaGameMode::OnLevelShown()
+{
+	NLOG("ANovaGameMode::OnLevelShown");
+
+	if (IsValid(ShowingStreamingLevel))
+	{
+		ShowingStreamingLevel->OnLevelShown.RemoveDynamic(this, &ANovaGameMode::OnLevelShown);
+		ShowingStreamingLevel = nullptr;
+	}
+
+	OnLevelLoadedCallback.ExecuteIfBound();
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -103,6 +103,15 @@ protected:
 	/** Unload a streaming level */
 	void UnloadStreamingLevel(const class UNovaArea* Area, FSimpleDelegate Callback = FSimpleDelegate());
 
+	/** Make a streaming level that was already loaded visible */
+	void ShowStreamingLevel(const class UNovaArea* Area, FSimpleDelegate Callback = FSimpleDelegate());
+
+	/** Stream the level of the upcoming destination while it is still hidden, and release it if the destination changed */
+	void ProcessArrivalPrefetch();
+
+	/** Start loading the assets for spacecraft and asteroids that will be spawned at an area */
+	void PrefetchAreaAssets(const class UNovaArea* Area);
+
 	/** Callback for a loaded streaming level */
 	UFUNCTION()
 	void OnLevelLoaded();
@@ -111,6 +120,14 @@ protected:
 	UFUNCTION()
 	void OnLevelUnLoaded();
 
+	/** Callback for a prefetched streaming level */
+	UFUNCTION()
+	void OnLevelPrefetched();
+
+	/** Callback for a prefetched streaming level becoming visible */
+	UFUNCTION()
+	void OnLevelShown();
+
 	/*----------------------------------------------------
 	    Properties
 	----------------------------------------------------*/
@@ -121,6 +138,10 @@ public:
 	UPROPERTY(Category = Nova, EditDefaultsOnly)
 	const class UNovaArea* OrbitArea;
 
+	/** Time before arrival at which the destination level starts streaming, in seconds */
+	UPROPERTY(Category = Nova, EditDefaultsOnly)
+	float ArrivalPrefetchLeadTime;
+
 	/*----------------------------------------------------
 	    Data
 	----------------------------------------------------*/
@@ -136,4 +157,14 @@ private:
 	int32           CurrentStreamingLevelIndex;
 	FSimpleDelegate OnLevelLoadedCallback;
 	FSimpleDelegate OnLevelUnloadedCallback;
+
+	// Arrival prefetch state
+	UPROPERTY()
+	const class UNovaArea* PrefetchedArea;
+	bool                   IsPrefetchingLevel;
+	FSimpleDelegate        OnLevelPrefetchedCallback;
+
+	// Prefetched level being made visible
+	UPROPERTY()
+	class ULevelStreaming* ShowingStreamingLevel;
 };
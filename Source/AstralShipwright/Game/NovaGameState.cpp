@@ -9,6 +9,7 @@
 #include "NovaAISimulationComponent.h"
 #include "NovaAsteroidSimulationComponent.h"
 #include "NovaOrbitalSimulationComponent.h"
+#include "NovaSystemSimulationComponent.h"
 
 #include "Player/NovaPlayerState.h"
 #include "Player/NovaPlayerController.h"
@@ -27,7 +28,6 @@
 #include "Engine/LevelStreaming.h"
 #include "Net/UnrealNetwork.h"
 #include "Dom/JsonObject.h"
-#include "EngineUtils.h"
 
 #define LOCTEXT_NAMESPACE "ANovaGameState"
 
@@ -50,11 +50,18 @@ ANovaGameState::ANovaGameState()
 	, TimeSinceLastFastForward(0)
 
 	, TimeSinceEvent(0)
+
+	, CurrentMetricsUpdates(0)
+	, MetricsUpdatesPerSecond(0)
+	, TimeSinceMetricsReport(0)
+
+	, SunDirection(FVector::ZeroVector)
 {
 	// Setup simulation component
 	OrbitalSimulationComponent  = CreateDefaultSubobject<UNovaOrbitalSimulationComponent>(TEXT("OrbitalSimulationComponent"));
 	AsteroidSimulationComponent = CreateDefaultSubobject<UNovaAsteroidSimulationComponent>(TEXT("AsteroidSimulationComponent"));
 	AISimulationComponent       = CreateDefaultSubobject<UNovaAISimulationComponent>(TEXT("AISimulationComponent"));
+	SystemSimulationComponent   = CreateDefaultSubobject<UNovaSystemSimulationComponent>(TEXT("SystemSimulationComponent"));
 
 	// Settings
 	bReplicates = true;
@@ -67,9 +74,9 @@ ANovaGameState::ANovaGameState()
 	MaximumTimeCorrectionThreshold = 10.0f;
 	TimeCorrectionFactor           = 1.0f;
 
-	// Fast forward defaults : 2 days per frame in 2h steps
-	FastForwardUpdateTime      = 2 * 60;
-	FastForwardUpdatesPerFrame = 24;
+	// Fast forward defaults : up to 8 days per frame in steps of at most one day, shortened to reach events
+	FastForwardUpdateTime      = 24 * 60;
+	FastForwardUpdatesPerFrame = 8;
 	FastForwardDelay           = 0.5;
 
 	// Time defaults
@@ -154,11 +161,28 @@ void ANovaGameState::Tick(float DeltaTime)
 		FNovaTime InitialTime    = GetCurrentTime();
 		TimeSinceLastFastForward = 0;
 
-		// Run FastForwardUpdatesPerFrame loops of world updates
+		// Collect upcoming events once per frame
+		FastForwardEvents.Reset();
+		GetFastForwardEvents(FastForwardEvents);
+
+		// Run world updates that jump straight to the next event, up to FastForwardUpdatesPerFrame times
 		ENovaSimulationDecision Decision = ENovaSimulationDecision::Continue;
 		for (int32 Index = 0; Index < FastForwardUpdatesPerFrame; Index++)
 		{
-			Decision = ProcessGameSimulation(FNovaTime::FromMinutes(FastForwardUpdateTime), Decision);
+			// Refresh events once the earliest one is reached, since it can lead to new events
+			if (FastForwardEvents.Num() && FastForwardEvents.HeapTop().Time <= GetCurrentTime())
+			{
+				FastForwardEvents.Reset();
+				GetFastForwardEvents(FastForwardEvents);
+			}
+
+			FNovaTime StepTime = FNovaTime::FromMinutes(FastForwardUpdateTime);
+			if (FastForwardEvents.Num())
+			{
+				StepTime = FMath::Max(FMath::Min(StepTime, FastForwardEvents.HeapTop().Time - GetCurrentTime()), FNovaTime());
+			}
+
+			Decision = ProcessGameSimulation(StepTime, Decision);
 			if (Decision == ENovaSimulationDecision::AbortImmediately)
 			{
 				NLOG("ANovaGameState::ProcessTime : fast-forward stopping at %.2f", ServerTime);
@@ -190,6 +214,17 @@ void ANovaGameState::Tick(float DeltaTime)
 	// Update event notification
 	ProcessPlayerEvents(DeltaTime);
 
+	// Report spacecraft metrics updates
+	TimeSinceMetricsReport += DeltaTime;
+	if (TimeSinceMetricsReport >= 1.0f)
+	{
+		MetricsUpdatesPerSecond = FMath::RoundToInt(CurrentMetricsUpdates / TimeSinceMetricsReport);
+		CurrentMetricsUpdates   = 0;
+		TimeSinceMetricsReport  = 0;
+
+		SET_DWORD_STAT(STAT_NovaMetricsUpdatesPerSecond, MetricsUpdatesPerSecond);
+	}
+
 	// Update sessions
 	UNeutronSessionsManager* SessionsManager = UNeutronSessionsManager::Get();
 	SessionsManager->SetSessionAdvertised(IsJoinable());
@@ -465,13 +500,16 @@ void ANovaGameState::UpdateSpacecraft(const FNovaSpacecraft& Spacecraft, const F
 
 bool ANovaGameState::IsAnySpacecraftOperating() const
 {
-	for (const ANovaSpacecraftPawn* SpacecraftPawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+	for (const TWeakObjectPtr<ANovaSpacecraftPawn>& SpacecraftPawn : SpacecraftPawns)
 	{
-		const UNovaSpacecraftMovementComponent* MovementComponent = SpacecraftPawn->GetSpacecraftMovement();
-		if (SpacecraftPawn->GetPlayerState() && IsValid(MovementComponent) &&
-			(MovementComponent->IsAnchoring() || MovementComponent->IsAnchored() || MovementComponent->IsOrbiting()))
+		if (SpacecraftPawn.IsValid() && SpacecraftPawn->GetPlayerState())
 		{
-			return true;
+			const UNovaSpacecraftMovementComponent* MovementComponent = SpacecraftPawn->GetSpacecraftMovement();
+			if (IsValid(MovementComponent) &&
+				(MovementComponent->IsAnchoring() || MovementComponent->IsAnchored() || MovementComponent->IsOrbiting()))
+			{
+				return true;
+			}
 		}
 	}
 
@@ -480,9 +518,9 @@ bool ANovaGameState::IsAnySpacecraftOperating() const
 
 bool ANovaGameState::IsAnySpacecraftDocked() const
 {
-	for (const ANovaSpacecraftPawn* SpacecraftPawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+	for (const TWeakObjectPtr<ANovaSpacecraftPawn>& SpacecraftPawn : SpacecraftPawns)
 	{
-		if (SpacecraftPawn->GetPlayerState() && SpacecraftPawn->IsDocked())
+		if (SpacecraftPawn.IsValid() && SpacecraftPawn->GetPlayerState() && SpacecraftPawn->IsDocked())
 		{
 			return true;
 		}
@@ -493,9 +531,9 @@ bool ANovaGameState::IsAnySpacecraftDocked() const
 
 bool ANovaGameState::AreAllSpacecraftDocked() const
 {
-	for (const ANovaSpacecraftPawn* SpacecraftPawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+	for (const TWeakObjectPtr<ANovaSpacecraftPawn>& SpacecraftPawn : SpacecraftPawns)
 	{
-		if (SpacecraftPawn->GetPlayerState() && !SpacecraftPawn->IsDocked())
+		if (SpacecraftPawn.IsValid() && SpacecraftPawn->GetPlayerState() && !SpacecraftPawn->IsDocked())
 		{
 			return false;
 		}
@@ -509,17 +547,72 @@ UActorComponent* ANovaGameState::GetSpacecraftSystem(
 {
 	NCHECK(Spacecraft);
 
-	for (const ANovaSpacecraftPawn* SpacecraftPawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+	const FNovaSpacecraftPawnRegistryEntry* Entry = SpacecraftPawnRegistry.Find(Spacecraft->Identifier);
+	if (Entry && Entry->Pawn.IsValid())
 	{
-		if (::IsValid(SpacecraftPawn) && SpacecraftPawn->GetSpacecraftIdentifier() == Spacecraft->Identifier)
+		// Systems are cached by exact class on registration, other classes are looked up on the pawn
+		const TWeakObjectPtr<UActorComponent>* System = Entry->Systems.Find(ComponentClass.Get());
+		if (System && System->IsValid())
 		{
-			return SpacecraftPawn->FindComponentByClass(ComponentClass);
+			return System->Get();
 		}
+
+		return Entry->Pawn->FindComponentByClass(ComponentClass);
 	}
 
 	return nullptr;
 }
 
+ANovaSpacecraftPawn* ANovaGameState::GetSpacecraftPawn(const FGuid& Identifier) const
+{
+	const FNovaSpacecraftPawnRegistryEntry* Entry = SpacecraftPawnRegistry.Find(Identifier);
+
+	return Entry ? Entry->Pawn.Get() : nullptr;
+}
+
+void ANovaGameState::RegisterSpacecraftPawn(ANovaSpacecraftPawn* Pawn, const FGuid& PreviousIdentifier)
+{
+	NCHECK(IsValid(Pawn));
+
+	// Drop a previous registration made under another identifier
+	const FGuid Identifier = Pawn->GetSpacecraftIdentifier();
+	if (PreviousIdentifier.IsValid() && PreviousIdentifier != Identifier)
+	{
+		RemoveSpacecraftPawnEntry(Pawn, PreviousIdentifier);
+	}
+
+	SpacecraftPawns.Add(Pawn);
+	if (Identifier.IsValid())
+	{
+		FNovaSpacecraftPawnRegistryEntry& Entry = SpacecraftPawnRegistry.FindOrAdd(Identifier);
+		if (Entry.Pawn != Pawn)
+		{
+			Entry.Pawn = Pawn;
+			Entry.Systems.Reset();
+
+			for (UActorComponent* Component : Pawn->GetComponentsByInterface(UNovaSpacecraftSystemInterface::StaticClass()))
+			{
+				Entry.Systems.Add(Component->GetClass(), Component);
+			}
+		}
+	}
+}
+
+void ANovaGameState::UnregisterSpacecraftPawn(ANovaSpacecraftPawn* Pawn, const FGuid& Identifier)
+{
+	SpacecraftPawns.Remove(Pawn);
+	RemoveSpacecraftPawnEntry(Pawn, Identifier);
+}
+
+void ANovaGameState::RemoveSpacecraftPawnEntry(ANovaSpacecraftPawn* Pawn, const FGuid& Identifier)
+{
+	const FNovaSpacecraftPawnRegistryEntry* Entry = SpacecraftPawnRegistry.Find(Identifier);
+	if (Entry && (Entry->Pawn == Pawn || !Entry->Pawn.IsValid()))
+	{
+		SpacecraftPawnRegistry.Remove(Identifier);
+	}
+}
+
 /*----------------------------------------------------
     Time management
 ----------------------------------------------------*/
@@ -548,8 +641,8 @@ bool ANovaGameState::CanFastForward(FText* AbortReason) const
 	if (GetLocalRole() == ROLE_Authority && !IsFastForward)
 	{
 		// No event upcoming
-		if (GetAllowedFastFowardTime() > FNovaTime::FromDays(ENovaConstants::MaxTrajectoryDurationDays) ||
-			GetAllowedFastFowardTime() <= FNovaTime())
+		const FNovaTime AllowedTime = GetAllowedFastFowardTime();
+		if (AllowedTime > FNovaTime::FromDays(ENovaConstants::MaxTrajectoryDurationDays) || AllowedTime <= FNovaTime())
 		{
 			if (AbortReason)
 			{
@@ -581,32 +674,28 @@ bool ANovaGameState::CanFastForward(FText* AbortReason) const
 FNovaTime ANovaGameState::GetAllowedFastFowardTime() const
 {
 	NCHECK(GetLocalRole() == ROLE_Authority);
-	const ANovaGameMode* GameMode = GetWorld()->GetAuthGameMode<ANovaGameMode>();
-	NCHECK(IsValid(GameMode));
 
-	// Handle trajectories
-	FNovaTime MaxAllowedDeltaTime           = OrbitalSimulationComponent->GetTimeLeftUntilPlayerManeuver(GameMode->GetManeuverWarnTime());
-	const FNovaTrajectory* PlayerTrajectory = OrbitalSimulationComponent->GetPlayerTrajectory();
-	if (PlayerTrajectory)
-	{
-		const FNovaTime TimeBeforeArrival = PlayerTrajectory->GetArrivalTime() - GetCurrentTime() - GameMode->GetArrivalWarningTime();
+	TArray<FNovaFastForwardEvent> Events;
+	GetFastForwardEvents(Events);
 
-		MaxAllowedDeltaTime = FMath::Min(MaxAllowedDeltaTime, TimeBeforeArrival);
-	}
+	return GetAllowedFastFowardTime(MoveTemp(Events));
+}
 
-	// Handle production remaining time
-	for (const ANovaSpacecraftPawn* Pawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+FNovaTime ANovaGameState::GetAllowedFastFowardTime(TArray<FNovaFastForwardEvent> Events) const
+{
+	// Find the earliest event that fast-forward stops on
+	while (Events.Num())
 	{
-		if (Pawn->GetPlayerState())
+		FNovaFastForwardEvent Event = Events.HeapTop();
+		if (Event.StopsFastForward)
 		{
-			const UNovaSpacecraftProcessingSystem* ProcessingSystem = Pawn->FindComponentByClass<UNovaSpacecraftProcessingSystem>();
-
-			FNovaTime RemainingProductionTime = ProcessingSystem->GetRemainingProductionTime();
-			MaxAllowedDeltaTime               = FMath::Min(MaxAllowedDeltaTime, RemainingProductionTime);
+			return Event.Time - GetCurrentTime();
 		}
+
+		Events.HeapPopDiscard();
 	}
 
-	return MaxAllowedDeltaTime;
+	return FNovaTime::FromMinutes(DBL_MAX);
 }
 
 void ANovaGameState::SetTimeDilation(ENovaTimeDilation Dilation)
@@ -628,12 +717,20 @@ bool ANovaGameState::CanDilateTime(ENovaTimeDilation Dilation) const
 
 ENovaSimulationDecision ANovaGameState::ProcessGameSimulation(FNovaTime DeltaTime, ENovaSimulationDecision PreviousDecision)
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaGameSimulation);
+
 	// Update spacecraft
-	SpacecraftDatabase.UpdateCache();
-	for (FNovaSpacecraft& Spacecraft : SpacecraftDatabase.Get())
 	{
-		Spacecraft.UpdatePropulsionMetrics();
-		Spacecraft.UpdatePowerMetrics();
+		NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaSpacecraftMetrics);
+
+		SpacecraftDatabase.UpdateCache();
+		for (FNovaSpacecraft& Spacecraft : SpacecraftDatabase.Get())
+		{
+			if (Spacecraft.UpdateMetricsIfChanged())
+			{
+				CurrentMetricsUpdates++;
+			}
+		}
 	}
 
 	// Update the time with the base delta time that will be affected by time dilation
@@ -648,21 +745,35 @@ ENovaSimulationDecision ANovaGameState::ProcessGameSimulation(FNovaTime DeltaTim
 		// Abort trajectories when a player didn't commit in time
 		ProcessTrajectoryAbort();
 
-		// Update spacecraft systems
-		for (ANovaSpacecraftPawn* Pawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+		// Update player spacecraft systems
+		TSet<FGuid> PawnSpacecraft;
 		{
-			if (Pawn->GetPlayerState() != nullptr)
+			NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaPawnSystems);
+
+			for (const APlayerState* PlayerState : PlayerArray)
 			{
-				TArray<UActorComponent*> Components = Pawn->GetComponentsByInterface(UNovaSpacecraftSystemInterface::StaticClass());
-				for (UActorComponent* Component : Components)
+				const ANovaSpacecraftPawn* Pawn = PlayerState ? PlayerState->GetPawn<ANovaSpacecraftPawn>() : nullptr;
+				if (IsValid(Pawn))
 				{
-					INovaSpacecraftSystemInterface* System = Cast<INovaSpacecraftSystemInterface>(Component);
-					NCHECK(System);
-					System->Update(InitialTime, GetCurrentTime());
+					PawnSpacecraft.Add(Pawn->GetSpacecraftIdentifier());
+
+					TArray<UActorComponent*> Components = Pawn->GetComponentsByInterface(UNovaSpacecraftSystemInterface::StaticClass());
+					for (UActorComponent* Component : Components)
+					{
+						INovaSpacecraftSystemInterface* System = Cast<INovaSpacecraftSystemInterface>(Component);
+						NCHECK(System);
+						System->Update(InitialTime, GetCurrentTime());
+					}
 				}
 			}
 		}
 
+		// Update all other spacecraft systems directly on their records
+		{
+			NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaHeadlessSystems);
+			SystemSimulationComponent->UpdateSimulation(SpacecraftDatabase, PawnSpacecraft, InitialTime, GetCurrentTime());
+		}
+
 		// Update prices if necessary
 		if (GetTimeLeftUntilPriceRotation() <= 0)
 		{
@@ -688,8 +799,8 @@ ENovaSimulationDecision ANovaGameState::ProcessGameTime(FNovaTime DeltaTime, ENo
 	// Under fast forward, stop on events
 	if (IsFastForward && GetLocalRole() == ROLE_Authority)
 	{
-		// Check for upcoming events
-		FNovaTime MaxAllowedDeltaTime = GetAllowedFastFowardTime();
+		// Check for upcoming events, as collected for this frame
+		FNovaTime MaxAllowedDeltaTime = GetAllowedFastFowardTime(FastForwardEvents);
 		NCHECK(TimeDilation == 1.0);
 		if (MaxAllowedDeltaTime <= FNovaTime())
 		{
@@ -725,6 +836,46 @@ ENovaSimulationDecision ANovaGameState::ProcessGameTime(FNovaTime DeltaTime, ENo
 	return Decision;
 }
 
+void ANovaGameState::GetFastForwardEvents(TArray<FNovaFastForwardEvent>& Events) const
+{
+	const ANovaGameMode* GameMode = GetWorld()->GetAuthGameMode<ANovaGameMode>();
+	NCHECK(IsValid(GameMode));
+	const FNovaTime CurrentTime = GetCurrentTime();
+
+	// Handle trajectories
+	const FNovaTime TimeLeftUntilManeuver = OrbitalSimulationComponent->GetTimeLeftUntilPlayerManeuver(GameMode->GetManeuverWarnTime());
+	Events.HeapPush(FNovaFastForwardEvent(CurrentTime + TimeLeftUntilManeuver, true));
+	const FNovaTrajectory* PlayerTrajectory = OrbitalSimulationComponent->GetPlayerTrajectory();
+	if (PlayerTrajectory)
+	{
+		Events.HeapPush(FNovaFastForwardEvent(PlayerTrajectory->GetArrivalTime() - GameMode->GetArrivalWarningTime(), true));
+	}
+
+	// Handle production remaining time
+	for (const APlayerState* PlayerState : PlayerArray)
+	{
+		const ANovaSpacecraftPawn* Pawn = PlayerState ? PlayerState->GetPawn<ANovaSpacecraftPawn>() : nullptr;
+		if (IsValid(Pawn))
+		{
+			const UNovaSpacecraftProcessingSystem* ProcessingSystem = Pawn->FindComponentByClass<UNovaSpacecraftProcessingSystem>();
+			if (ProcessingSystem)
+			{
+				Events.HeapPush(FNovaFastForwardEvent(CurrentTime + ProcessingSystem->GetRemainingProductionTime(), true));
+			}
+		}
+	}
+
+	// Handle AI departures and arrivals, which don't stop fast-forward but need to happen on time
+	const FNovaTime NextAIEventTime = AISimulationComponent->GetNextEventTime();
+	if (NextAIEventTime < FNovaTime::FromMinutes(DBL_MAX))
+	{
+		Events.HeapPush(FNovaFastForwardEvent(NextAIEventTime, false));
+	}
+
+	// Handle price rotation, which doesn't stop fast-forward but needs to happen on time
+	Events.HeapPush(FNovaFastForwardEvent(CurrentTime + GetTimeLeftUntilPriceRotation(), false));
+}
+
 void ANovaGameState::ProcessPlayerEvents(float DeltaTime)
 {
 	FText PrimaryText, SecondaryText;
@@ -801,9 +952,9 @@ void ANovaGameState::ProcessTrajectoryAbort()
 
 ENovaTrajectoryAction ANovaGameState::CheckTrajectoryAbort(FText* AbortReason) const
 {
-	for (const ANovaSpacecraftPawn* Pawn : TActorRange<ANovaSpacecraftPawn>(GetWorld()))
+	for (const TWeakObjectPtr<ANovaSpacecraftPawn>& Pawn : SpacecraftPawns)
 	{
-		if (Pawn->GetPlayerState())
+		if (Pawn.IsValid() && Pawn->GetPlayerState())
 		{
 			// Docking or undocking
 			if (Pawn->GetSpacecraftMovement()->IsDockingUndocking() || Pawn->GetSpacecraftMovement()->IsDocked())
@@ -37,6 +37,28 @@ enum class ENovaSimulationDecision
 	Continue
 };
 
+/** Upcoming event that fast-forward needs to reach exactly, sorted by time */
+struct FNovaFastForwardEvent
+{
+	FNovaFastForwardEvent(FNovaTime T, bool S) : Time(T), StopsFastForward(S)
+	{}
+
+	bool operator<(const FNovaFastForwardEvent& Other) const
+	{
+		return Time < Other.Time;
+	}
+
+	FNovaTime Time;
+	bool      StopsFastForward;
+};
+
+/** Spacecraft pawn registered for a spacecraft identifier, with its systems cached by class */
+struct FNovaSpacecraftPawnRegistryEntry
+{
+	TWeakObjectPtr<class ANovaSpacecraftPawn>        Pawn;
+	TMap<UClass*, TWeakObjectPtr<UActorComponent>> Systems;
+};
+
 /** Game save */
 USTRUCT()
 struct FNovaGameStateSave
@@ -63,6 +85,8 @@ struct FNovaGameStateSave
 UCLASS(ClassGroup = (Nova))
 class ANovaGameState : public AGameStateBase
 {
+	friend class UNovaSimulationBenchmarkCommandlet;
+
 	GENERATED_BODY()
 
 public:
@@ -98,6 +122,18 @@ public:
 	/** Get the current sub-level name to use */
 	FName GetCurrentLevelName() const;
 
+	/** Publish the physical sun direction for this frame, done by the planetarium */
+	void SetSunDirection(const FVector& Direction)
+	{
+		SunDirection = Direction;
+	}
+
+	/** Get the physical sun direction published by the planetarium, or a null vector before it ticked */
+	FVector GetSunDirection() const
+	{
+		return SunDirection;
+	}
+
 	/** Rotate the prices in the world */
 	void RotatePrices();
 
@@ -187,6 +223,15 @@ public:
 	/** Get a component of the linked spacecraft pawn if any */
 	UActorComponent* GetSpacecraftSystem(const struct FNovaSpacecraft* Spacecraft, TSubclassOf<UActorComponent> ComponentClass) const;
 
+	/** Get the spacecraft pawn for a spacecraft identifier if any */
+	class ANovaSpacecraftPawn* GetSpacecraftPawn(const FGuid& Identifier) const;
+
+	/** Register a spacecraft pawn, or update its registration after a change from PreviousIdentifier */
+	void RegisterSpacecraftPawn(class ANovaSpacecraftPawn* Pawn, const FGuid& PreviousIdentifier);
+
+	/** Remove a spacecraft pawn registered under Identifier from the registry */
+	void UnregisterSpacecraftPawn(class ANovaSpacecraftPawn* Pawn, const FGuid& Identifier);
+
 	/*----------------------------------------------------
 	    Time management
 	----------------------------------------------------*/
@@ -258,6 +303,12 @@ protected:
 	/** Process time */
 	ENovaSimulationDecision ProcessGameTime(FNovaTime DeltaTime, ENovaSimulationDecision PreviousDecision);
 
+	/** Get the upcoming fast-forward events as a heap, with the earliest event on top */
+	void GetFastForwardEvents(TArray<FNovaFastForwardEvent>& Events) const;
+
+	/** Get the duration of a fast-forward from a heap of upcoming events */
+	FNovaTime GetAllowedFastFowardTime(TArray<FNovaFastForwardEvent> Events) const;
+
 	/** Notify events to the player*/
 	void ProcessPlayerEvents(float DeltaTime);
 
@@ -267,6 +318,9 @@ protected:
 	/** Check if all player spacecraft can currently maneuver */
 	ENovaTrajectoryAction CheckTrajectoryAbort(FText* AbortReason = nullptr) const;
 
+	/** Remove the registry entry for Identifier if it belongs to Pawn or to a destroyed pawn */
+	void RemoveSpacecraftPawnEntry(class ANovaSpacecraftPawn* Pawn, const FGuid& Identifier);
+
 	/** Server replication event for time reconciliation */
 	UFUNCTION()
 	void OnServerTimeReplicated();
@@ -293,11 +347,11 @@ protected:
 	UPROPERTY(Category = Nova, EditDefaultsOnly)
 	float TimeCorrectionFactor;
 
-	// Time between simulation updates during fast forward in minutes
+	// Maximum time between simulation updates during fast forward in minutes, shortened to reach events
 	UPROPERTY(Category = Nova, EditDefaultsOnly)
 	int32 FastForwardUpdateTime;
 
-	// Number of update steps to run per frame under fast forward
+	// Maximum number of update steps to run per frame under fast forward
 	UPROPERTY(Category = Nova, EditDefaultsOnly)
 	int32 FastForwardUpdatesPerFrame;
 
@@ -331,6 +385,10 @@ protected:
 	UPROPERTY(Category = Nova, VisibleDefaultsOnly, BlueprintReadOnly)
 	class UNovaAISimulationComponent* AISimulationComponent;
 
+	// Headless spacecraft system simulation component
+	UPROPERTY(Category = Nova, VisibleDefaultsOnly, BlueprintReadOnly)
+	class UNovaSystemSimulationComponent* SystemSimulationComponent;
+
 	/*----------------------------------------------------
 	    Data
 	----------------------------------------------------*/
@@ -369,11 +427,26 @@ private:
 	bool   IsFastForward;
 	float  TimeSinceLastFastForward;
 
+	// Upcoming events for the current fast-forward frame
+	TArray<FNovaFastForwardEvent> FastForwardEvents;
+
 	// Event observation system
 	float                          TimeSinceEvent;
 	TArray<FNovaTime>              TimeJumpEvents;
 	TArray<const class UNovaArea*> AreaChangeEvents;
 
+	// Spacecraft metrics statistics
+	int32 CurrentMetricsUpdates;
+	int32 MetricsUpdatesPerSecond;
+	float TimeSinceMetricsReport;
+
+	// Sun direction published by the planetarium
+	FVector SunDirection;
+
+	// Spacecraft pawn registry
+	TSet<TWeakObjectPtr<class ANovaSpacecraftPawn>> SpacecraftPawns;
+	TMap<FGuid, FNovaSpacecraftPawnRegistryEntry>   SpacecraftPawnRegistry;
+
 public:
 
 	/*----------------------------------------------------
@@ -397,4 +470,16 @@ public:
 	{
 		return AISimulationComponent;
 	}
+
+	/** Return the headless spacecraft system simulation component */
+	class UNovaSystemSimulationComponent* GetSystemSimulation() const
+	{
+		return SystemSimulationComponent;
+	}
+
+	/** Return how many spacecraft had their metrics recomputed over the last second */
+	int32 GetMetricsUpdatesPerSecond() const
+	{
+		return MetricsUpdatesPerSecond;
+	}
 };
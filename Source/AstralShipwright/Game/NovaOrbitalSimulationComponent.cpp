@@ -23,6 +23,9 @@
 /** Hohmann transfer orbit parameters */
 struct FNovaHohmannTransfer
 {
+	FNovaHohmannTransfer() : StartDeltaV(0), EndDeltaV(0), TotalDeltaV(0)
+	{}
+
 	/** Compute a Hohmann transfer from the elliptic orbit (ManeuverRadius, OriginalRadius) to the circular orbit DestinationRadius,
 	 * raising OriginalRadius to DestinationRadius, while maneuvering at ManeuverRadius (technically not a Hohmann transfer) */
 	FNovaHohmannTransfer(const double µ, const double ManeuverRadius, const double OriginalRadius, const double DestinationRadius)
@@ -46,6 +49,113 @@ struct FNovaHohmannTransfer
 	double    TotalDeltaV;
 	FNovaTime Duration;
 };
+
+/** Orbital mechanics of a trajectory going through a phasing orbit, shared by trajectory and cost computation */
+struct FNovaTrajectoryPlan
+{
+	FNovaTrajectoryPlan(const FNovaTrajectoryParameters& Parameters, double Altitude)
+		: PhasingAltitude(Altitude)
+		, SourceAltitudeA(Parameters.Source.Geometry.StartAltitude)
+		, SourceAltitudeB(Parameters.Source.Geometry.StartAltitude)
+		, SourcePhase(Parameters.Source.GetPhase<true>(Parameters.StartTime))
+		, DestinationAltitude(Parameters.DestinationAltitude)
+		, DestinationPhase(Parameters.DestinationPhase)
+	{
+		// if the source orbit isn't circular, circularize to PhasingAltitude at one of the apsides
+		if (!Parameters.Source.Geometry.IsCircular())
+		{
+			const FNovaOrbitGeometry& Geometry = Parameters.Source.Geometry;
+
+			const bool CircularizeAtStart =
+				FMath::Abs(Geometry.OppositeAltitude - PhasingAltitude) < FMath::Abs(Geometry.StartAltitude - PhasingAltitude);
+
+			// Get the basic circularization parameters
+			const double InitialSourcePhase = SourcePhase;
+			SourcePhase                     = CircularizeAtStart ? Geometry.StartPhase : Geometry.StartPhase + 180;
+			SourceAltitudeA                 = CircularizeAtStart ? Geometry.StartAltitude : Geometry.OppositeAltitude;
+			SourceAltitudeB                 = CircularizeAtStart ? Geometry.OppositeAltitude : Geometry.StartAltitude;
+			const double WaitingPhaseDelta  = FMath::Fmod(SourcePhase - InitialSourcePhase + 360.0, 360.0);
+			InitialWaitingDuration          = (WaitingPhaseDelta / 360.0) * Geometry.GetOrbitalPeriod();
+		}
+
+		// Get orbital parameters
+		const double R1A = Parameters.Body->GetRadius(SourceAltitudeA);
+		const double R1B = Parameters.Body->GetRadius(SourceAltitudeB);
+		const double R2  = Parameters.Body->GetRadius(PhasingAltitude);
+		const double R3  = Parameters.Body->GetRadius(DestinationAltitude);
+
+		// Compute both Hohmann transfers as well as the orbital periods
+		TransferA              = FNovaHohmannTransfer(Parameters.µ, R1A, R1B, R2);
+		TransferB              = FNovaHohmannTransfer(Parameters.µ, R2, R2, R3);
+		PhasingOrbitPeriod     = UNovaOrbitalSimulationComponent::GetOrbitalPeriod(Parameters.µ, R2);
+		DestinationOrbitPeriod = UNovaOrbitalSimulationComponent::GetOrbitalPeriod(Parameters.µ, R3);
+
+		// Compute the new destination parameters after both transfers, ignoring the phasing orbit
+		TotalTransferDuration                = InitialWaitingDuration + TransferA.Duration + TransferB.Duration;
+		DestinationPhaseChangeDuringTransfer = (TotalTransferDuration / DestinationOrbitPeriod) * 360.0;
+		NewDestinationPhaseAfterTransfers    = FMath::Fmod(DestinationPhase + DestinationPhaseChangeDuringTransfer, 360.0);
+		PhaseDelta                           = FMath::Fmod(NewDestinationPhaseAfterTransfers - SourcePhase + 360.0, 360.0);
+
+		// Ensure the phasing delta has the correct sign
+		if (PhasingOrbitPeriod > DestinationOrbitPeriod)
+		{
+			while (PhaseDelta > 0)
+			{
+				PhaseDelta -= 360.0;
+			}
+		}
+		else
+		{
+			while (PhaseDelta < 0)
+			{
+				PhaseDelta += 360.0;
+			}
+		}
+
+		// Compute the time spent waiting
+		PhasingDuration     = PhaseDelta / (360.0 * (1.0 / PhasingOrbitPeriod - 1.0 / DestinationOrbitPeriod));
+		PhasingAngle        = (PhasingDuration / PhasingOrbitPeriod) * 360.0;
+		TotalTravelDuration = TotalTransferDuration + PhasingDuration;
+		TotalDeltaV         = TransferA.TotalDeltaV + TransferB.TotalDeltaV;
+
+		// The trajectory is valid when it has at least one maneuver and one transfer, the phasing orbit requiring the first transfer
+		const UNovaCelestialBody* Body               = Parameters.Body;
+		const FNovaTime           FirstTransferTime  = Parameters.StartTime + InitialWaitingDuration;
+		const FNovaTime           FinalTransferTime  = FirstTransferTime + TransferA.Duration + PhasingDuration;
+		const double              FinalTransferPhase = SourcePhase + 180 + PhasingAngle;
+		const FNovaOrbitGeometry  FirstTransferGeometry(Body, SourceAltitudeA, PhasingAltitude, SourcePhase, SourcePhase + 180);
+		const FNovaOrbitGeometry  FinalTransferGeometry(
+			Body, PhasingAltitude, DestinationAltitude, FinalTransferPhase, FinalTransferPhase + 180);
+		const bool FirstTransferIsValid = TransferA.StartDeltaV != 0 && FNovaOrbit(FirstTransferGeometry, FirstTransferTime).IsValid();
+		const bool FinalTransferIsValid = FNovaOrbit(FinalTransferGeometry, FinalTransferTime).IsValid();
+		IsValid                         = TotalDeltaV != 0 && (FirstTransferIsValid || FinalTransferIsValid);
+	}
+
+	double    PhasingAltitude;
+	double    SourceAltitudeA;
+	double    SourceAltitudeB;
+	double    SourcePhase;
+	double    DestinationAltitude;
+	double    DestinationPhase;
+	FNovaTime InitialWaitingDuration;
+
+	FNovaHohmannTransfer TransferA;
+	FNovaHohmannTransfer TransferB;
+	FNovaTime            PhasingOrbitPeriod;
+	FNovaTime            DestinationOrbitPeriod;
+
+	FNovaTime TotalTransferDuration;
+	double    DestinationPhaseChangeDuringTransfer;
+	double    NewDestinationPhaseAfterTransfers;
+	double    PhaseDelta;
+
+	FNovaTime PhasingDuration;
+	double    PhasingAngle;
+	FNovaTime TotalTravelDuration;
+	double    TotalDeltaV;
+	bool      IsValid;
+};
+
 /** Results of a maneuver on a fleet of spacecraft */
 struct FNovaSpacecraftFleetManeuver
 {
@@ -59,36 +169,8 @@ struct FNovaSpacecraftFleetManeuver
 /** Structure representing a fleet of spacecraft */
 struct FNovaSpacecraftFleet
 {
-	struct FNovaSpacecraftFleetEntry
-	{
-		FNovaSpacecraftFleetEntry(const FNovaSpacecraft* Spacecraft, const ANovaGameState* GameState)
-		{
-			Metrics = Spacecraft->GetPropulsionMetrics();
-
-			UNovaSpacecraftPropellantSystem* PropellantSystem = GameState->GetSpacecraftSystem<UNovaSpacecraftPropellantSystem>(Spacecraft);
-
-			// The core assumption here is that only maneuvers can modify mass, and so the current mass won't change until the next
-			// maneuver. The practical consequence is that trajectories can only ever be plotted while undocked
-			// and any non-propulsion-related transfer of mass should abort the trajectory
-			CurrentCargoMass = Spacecraft->GetCurrentCargoMass();
-			CurrentPropellantMass =
-				PropellantSystem ? PropellantSystem->GetCurrentPropellantMass() : Spacecraft->GetPropulsionMetrics().PropellantMassCapacity;
-		}
-
-		FNovaSpacecraftPropulsionMetrics Metrics;
-		float                            CurrentCargoMass;
-		float                            CurrentPropellantMass;
-	};
-
-	FNovaSpacecraftFleet(const TArray<FGuid>& SpacecraftIdentifiers, const ANovaGameState* GameState)
-	{
-		for (const FGuid& Identifier : SpacecraftIdentifiers)
-		{
-			const FNovaSpacecraft* NewSpacecraft = GameState->GetSpacecraft(Identifier);
-			NCHECK(NewSpacecraft != nullptr);
-			Fleet.Add(FNovaSpacecraftFleetEntry(NewSpacecraft, GameState));
-		}
-	}
+	FNovaSpacecraftFleet(const TArray<FNovaTrajectorySpacecraftState>& SpacecraftStates) : Fleet(SpacecraftStates)
+	{}
 
 	FNovaSpacecraftFleetManeuver AddManeuver(double DeltaV)
 	{
@@ -97,7 +179,7 @@ struct FNovaSpacecraftFleet
 		// Update the propellant use and compute individual maneuver durations for each ship
 		FNovaTime         MaxDuration;
 		TArray<FNovaTime> Durations;
-		for (FNovaSpacecraftFleetEntry& Entry : Fleet)
+		for (FNovaTrajectorySpacecraftState& Entry : Fleet)
 		{
 			FNovaTime Duration =
 				Entry.Metrics.GetManeuverDurationAndPropellantUsed(DeltaV, Entry.CurrentCargoMass, Entry.CurrentPropellantMass);
@@ -119,14 +201,14 @@ struct FNovaSpacecraftFleet
 		return FNovaSpacecraftFleetManeuver(MaxDuration, ThrustFactors);
 	}
 
-	TArray<FNovaSpacecraftFleetEntry> Fleet;
+	TArray<FNovaTrajectorySpacecraftState> Fleet;
 };
 
 /*----------------------------------------------------
     Constructor
 ----------------------------------------------------*/
 
-UNovaOrbitalSimulationComponent::UNovaOrbitalSimulationComponent() : Super(), IsSimulatingPreview(false)
+UNovaOrbitalSimulationComponent::UNovaOrbitalSimulationComponent() : Super(), AreasRevision(0), IsSimulatingPreview(false)
 {
 	// Settings
 	SetIsReplicatedByDefault(true);
@@ -144,10 +226,13 @@ void UNovaOrbitalSimulationComponent::BeginPlay()
 	Super::BeginPlay();
 
 	Areas = UNeutronAssetManager::Get()->GetAssets<UNovaArea>();
+	AreasRevision++;
 }
 
 void UNovaOrbitalSimulationComponent::UpdateSimulation()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaOrbitalSimulation);
+
 	// Clean up our local state
 	TimeOfNextPlayerManeuver = FNovaTime::FromMinutes(DBL_MAX);
 	SpacecraftOrbitDatabase.UpdateCache();
@@ -159,6 +244,13 @@ void UNovaOrbitalSimulationComponent::UpdateSimulation()
 	ProcessAsteroids();
 	ProcessSpacecraftOrbits();
 	ProcessSpacecraftTrajectories();
+
+	// Report counts
+	SET_DWORD_STAT(STAT_NovaOrbitCount, SpacecraftOrbitDatabase.Get().Num());
+	SET_DWORD_STAT(STAT_NovaTrajectoryCount, SpacecraftTrajectoryDatabase.Get().Num());
+	const SIZE_T LocationMemory = AreaOrbitalLocations.GetAllocatedSize() + AsteroidOrbitalLocations.GetAllocatedSize() +
+	                              SpacecraftOrbitalLocations.GetAllocatedSize();
+	SET_MEMORY_STAT(STAT_NovaOrbitalLocationMemory, LocationMemory);
 }
 
 FNovaTime UNovaOrbitalSimulationComponent::GetCurrentTime() const
@@ -192,78 +284,53 @@ FNovaTrajectoryParameters UNovaOrbitalSimulationComponent::PrepareTrajectory(
 	Parameters.Body = Source.Geometry.Body;
 	Parameters.µ    = Source.Geometry.Body->GetGravitationalParameter();
 
-	return Parameters;
-}
-
-FNovaTrajectory UNovaOrbitalSimulationComponent::ComputeTrajectory(const FNovaTrajectoryParameters& Parameters, double PhasingAltitude)
-{
-	// Get phase and altitude
-	const FNovaTime& StartTime           = Parameters.StartTime;
-	double           SourceAltitudeA     = Parameters.Source.Geometry.StartAltitude;
-	double           SourceAltitudeB     = Parameters.Source.Geometry.StartAltitude;
-	double           SourcePhase         = Parameters.Source.GetPhase<true>(StartTime);
-	const double     DestinationAltitude = Parameters.DestinationAltitude;
-	const double     DestinationPhase    = Parameters.DestinationPhase;
-
-	// if the source orbit isn't circular, circularize to PhasingAltitude at one of the apsides
-	FNovaTime InitialWaitingDuration;
-	if (!Parameters.Source.Geometry.IsCircular())
+	// Snapshot the fleet state
+	const ANovaGameState* GameState = GetOwner<ANovaGameState>();
+	for (const FGuid& Identifier : SpacecraftIdentifiers)
 	{
-		const FNovaOrbitGeometry& Geometry = Parameters.Source.Geometry;
-
-		const bool CircularizeAtStart =
-			FMath::Abs(Geometry.OppositeAltitude - PhasingAltitude) < FMath::Abs(Geometry.StartAltitude - PhasingAltitude);
-
-		// Get the basic circularization parameters
-		const double InitialSourcePhase = SourcePhase;
-		SourcePhase                     = CircularizeAtStart ? Geometry.StartPhase : Geometry.StartPhase + 180;
-		SourceAltitudeA                 = CircularizeAtStart ? Geometry.StartAltitude : Geometry.OppositeAltitude;
-		SourceAltitudeB                 = CircularizeAtStart ? Geometry.OppositeAltitude : Geometry.StartAltitude;
-		const double WaitingPhaseDelta  = FMath::Fmod(SourcePhase - InitialSourcePhase + 360.0, 360.0);
-		InitialWaitingDuration          = (WaitingPhaseDelta / 360.0) * Geometry.GetOrbitalPeriod();
+		const FNovaSpacecraft* Spacecraft = GameState->GetSpacecraft(Identifier);
+		NCHECK(Spacecraft != nullptr);
+
+		FNovaTrajectorySpacecraftState State;
+		State.Metrics = Spacecraft->GetPropulsionMetrics();
+
+		// The core assumption here is that only maneuvers can modify mass, and so the current mass won't change until the next
+		// maneuver. The practical consequence is that trajectories can only ever be plotted while undocked
+		// and any non-propulsion-related transfer of mass should abort the trajectory
+		const UNovaSpacecraftPropellantSystem* PropellantSystem =
+			GameState->GetSpacecraftSystem<UNovaSpacecraftPropellantSystem>(Spacecraft);
+		State.CurrentCargoMass = Spacecraft->GetCurrentCargoMass();
+		State.CurrentPropellantMass =
+			PropellantSystem ? PropellantSystem->GetCurrentPropellantMass() : State.Metrics.PropellantMassCapacity;
+
+		Parameters.SpacecraftStates.Add(State);
 	}
 
-	// Get orbital parameters
-	const double R1A = Parameters.Body->GetRadius(SourceAltitudeA);
-	const double R1B = Parameters.Body->GetRadius(SourceAltitudeB);
-	const double R2  = Parameters.Body->GetRadius(PhasingAltitude);
-	const double R3  = Parameters.Body->GetRadius(DestinationAltitude);
-
-	// Compute both Hohmann transfers as well as the orbital periods
-	const FNovaHohmannTransfer TransferA(Parameters.µ, R1A, R1B, R2);
-	const FNovaHohmannTransfer TransferB(Parameters.µ, R2, R2, R3);
-	const FNovaTime            PhasingOrbitPeriod     = GetOrbitalPeriod(Parameters.µ, R2);
-	const FNovaTime            DestinationOrbitPeriod = GetOrbitalPeriod(Parameters.µ, R3);
-
-	// Compute the new destination parameters after both transfers, ignoring the phasing orbit
-	const FNovaTime TotalTransferDuration                = InitialWaitingDuration + TransferA.Duration + TransferB.Duration;
-	const double    DestinationPhaseChangeDuringTransfer = (TotalTransferDuration / DestinationOrbitPeriod) * 360.0;
-	const double    NewDestinationPhaseAfterTransfers    = FMath::Fmod(DestinationPhase + DestinationPhaseChangeDuringTransfer, 360.0);
-	double          PhaseDelta                           = FMath::Fmod(NewDestinationPhaseAfterTransfers - SourcePhase + 360.0, 360.0);
-
-	// Ensure the phasing delta has the correct sign
-	if (PhasingOrbitPeriod > DestinationOrbitPeriod)
-	{
-		while (PhaseDelta > 0)
-		{
-			PhaseDelta -= 360.0;
-		}
-	}
-	else
-	{
-		while (PhaseDelta < 0)
-		{
-			PhaseDelta += 360.0;
-		}
-	}
+	return Parameters;
+}
 
-	// Compute the time spent waiting
-	const FNovaTime PhasingDuration     = PhaseDelta / (360.0 * (1.0 / PhasingOrbitPeriod - 1.0 / DestinationOrbitPeriod));
-	const double    PhasingAngle        = (PhasingDuration / PhasingOrbitPeriod) * 360.0;
-	const FNovaTime TotalTravelDuration = TotalTransferDuration + PhasingDuration;
+FNovaTrajectory UNovaOrbitalSimulationComponent::ComputeTrajectory(
+	const FNovaTrajectoryParameters& Parameters, double PhasingAltitude) const
+{
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaComputeTrajectory);
+	INC_DWORD_STAT(STAT_NovaTrajectoriesComputed);
+
+	// Compute the orbital mechanics
+	const FNovaTrajectoryPlan   Plan(Parameters, PhasingAltitude);
+	const FNovaTime&            StartTime              = Parameters.StartTime;
+	const double                SourceAltitudeA        = Plan.SourceAltitudeA;
+	const double                SourcePhase            = Plan.SourcePhase;
+	const double                DestinationAltitude    = Plan.DestinationAltitude;
+	const FNovaTime             InitialWaitingDuration = Plan.InitialWaitingDuration;
+	const FNovaHohmannTransfer& TransferA              = Plan.TransferA;
+	const FNovaHohmannTransfer& TransferB              = Plan.TransferB;
+	const FNovaTime             PhasingOrbitPeriod     = Plan.PhasingOrbitPeriod;
+	const FNovaTime             PhasingDuration        = Plan.PhasingDuration;
+	const double                PhasingAngle           = Plan.PhasingAngle;
+	const FNovaTime             TotalTravelDuration    = Plan.TotalTravelDuration;
 
 	// Start building trajectory
-	FNovaSpacecraftFleet Fleet(Parameters.SpacecraftIdentifiers, Cast<ANovaGameState>(GetOwner()));
+	FNovaSpacecraftFleet Fleet(Parameters.SpacecraftStates);
 	FNovaTrajectory      Trajectory;
 	Trajectory.InitialOrbit = Parameters.Source;
 	FNovaTime CurrentTime   = StartTime + InitialWaitingDuration;
@@ -369,25 +436,25 @@ FNovaTrajectory UNovaOrbitalSimulationComponent::ComputeTrajectory(const FNovaTr
 
 	// Metadata
 	Trajectory.TotalTravelDuration = TotalTravelDuration;
-	Trajectory.TotalDeltaV         = TransferA.TotalDeltaV + TransferB.TotalDeltaV;
+	Trajectory.TotalDeltaV         = Plan.TotalDeltaV;
 
 #if WITH_EDITOR
 
 	// Confirm the final spacecraft phase matches the destination's
-	const double DestinationPhasingAngle = (PhasingDuration / PhasingOrbitPeriod) * 360.0;
-	const double FinalDestinationPhase   = FMath::Fmod(DestinationPhase + (TotalTravelDuration / DestinationOrbitPeriod) * 360, 360.0);
-	const double FinalSpacecraftPhase    = FMath::Fmod(SourcePhase + PhasingAngle, 360.0);
+	const double FinalDestinationPhase =
+		FMath::Fmod(Plan.DestinationPhase + (TotalTravelDuration / Plan.DestinationOrbitPeriod) * 360, 360.0);
+	const double FinalSpacecraftPhase = FMath::Fmod(SourcePhase + PhasingAngle, 360.0);
 
 #if 0
 	NLOG("--------------------------------------------------------------------------------");
 	NLOG("UNovaOrbitalSimulationComponent::ComputeTrajectory : (%f, %f) --> (%f, %f)", SourceAltitudeA, SourcePhase, DestinationAltitude,
-		DestinationPhase);
+		Plan.DestinationPhase);
 	NLOG("Transfer A : DVS %f, DVE %f, DV %f, T %f", TransferA.StartDeltaV, TransferA.EndDeltaV, TransferA.TotalDeltaV);
 	NLOG("Transfer B : DVS %f, DVE %f, DV %f, T %f", TransferB.StartDeltaV, TransferB.EndDeltaV, TransferB.TotalDeltaV);
-	NLOG("InitialWaitingDuration %f, TotalTransferDuration %f", InitialWaitingDuration.AsMinutes(), TotalTransferDuration.AsMinutes());
+	NLOG("InitialWaitingDuration %f, TotalTransferDuration %f", InitialWaitingDuration.AsMinutes(), Plan.TotalTransferDuration.AsMinutes());
 	NLOG("DestinationPhaseChangeDuringTransfer %f, NewDestinationPhaseAfterTransfers %f, PhaseDelta %f",
-		DestinationPhaseChangeDuringTransfer, NewDestinationPhaseAfterTransfers, PhaseDelta);
-	NLOG("PhasingOrbitPeriod = %f, DestinationOrbitPeriod = %f", PhasingOrbitPeriod.AsMinutes(), DestinationOrbitPeriod.AsMinutes());
+		Plan.DestinationPhaseChangeDuringTransfer, Plan.NewDestinationPhaseAfterTransfers, Plan.PhaseDelta);
+	NLOG("PhasingOrbitPeriod = %f, DestinationOrbitPeriod = %f", PhasingOrbitPeriod.AsMinutes(), Plan.DestinationOrbitPeriod.AsMinutes());
 	NLOG("PhasingDuration = %f, PhasingAngle = %f", PhasingDuration.AsMinutes(), PhasingAngle);
 	NLOG("FinalDestinationPhase = %f, FinalSpacecraftPhase = %f",
 		FMath::IsFinite(FinalDestinationPhase) ? FMath::UnwindDegrees(FinalDestinationPhase) : 0,
@@ -410,6 +477,38 @@ FNovaTrajectory UNovaOrbitalSimulationComponent::ComputeTrajectory(const FNovaTr
 	return Trajectory;
 }
 
+FNovaTrajectoryCost UNovaOrbitalSimulationComponent::ComputeTrajectoryCost(
+	const FNovaTrajectoryParameters& Parameters, double PhasingAltitude) const
+{
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaComputeTrajectoryCost);
+	INC_DWORD_STAT(STAT_NovaTrajectoriesComputed);
+
+	const FNovaTrajectoryPlan Plan(Parameters, PhasingAltitude);
+
+	FNovaTrajectoryCost Cost;
+	Cost.Valid               = Plan.IsValid;
+	Cost.TotalDeltaV         = Plan.TotalDeltaV;
+	Cost.TotalTravelDuration = Plan.TotalTravelDuration;
+
+	// Each spacecraft uses propellant independently of the others, the fleet only synchronizes durations
+	const double Maneuvers[] = {Plan.TransferA.StartDeltaV, Plan.TransferA.EndDeltaV, Plan.TransferB.StartDeltaV, Plan.TransferB.EndDeltaV};
+	for (const FNovaTrajectorySpacecraftState& State : Parameters.SpacecraftStates)
+	{
+		float CurrentPropellantMass = State.CurrentPropellantMass;
+		for (double DeltaV : Maneuvers)
+		{
+			if (DeltaV != 0)
+			{
+				State.Metrics.GetManeuverDurationAndPropellantUsed(DeltaV, State.CurrentCargoMass, CurrentPropellantMass);
+			}
+		}
+
+		Cost.PropellantUsed.Add(State.CurrentPropellantMass - CurrentPropellantMass);
+	}
+
+	return Cost;
+}
+
 bool UNovaOrbitalSimulationComponent::IsOnTrajectory(const FGuid& SpacecraftIdentifier) const
 {
 	return SpacecraftTrajectoryDatabase.Get(SpacecraftIdentifier) != nullptr;
@@ -709,20 +808,17 @@ const FNovaOrbitalLocation* UNovaOrbitalSimulationComponent::GetPlayerLocation()
 
 TPair<const UNovaArea*, double> UNovaOrbitalSimulationComponent::GetNearestAreaAndDistance(const FNovaOrbitalLocation& Location) const
 {
-	const UNovaArea* ClosestArea     = nullptr;
-	double           ClosestDistance = MAX_FLT;
+	double      ClosestDistance = MAX_FLT;
+	const int32 ClosestIndex    = AreaOrbitalLocations.FindNearest(Location.GetCartesianLocation(), &ClosestDistance);
 
-	for (const TPair<const UNovaArea*, FNovaOrbitalLocation>& Entry : AreaOrbitalLocations)
+	if (ClosestIndex != INDEX_NONE)
 	{
-		double Distance = Entry.Value.GetDistanceTo(Location);
-		if (Distance < ClosestDistance)
-		{
-			ClosestArea     = Entry.Key;
-			ClosestDistance = Distance;
-		}
+		return TPair<const UNovaArea*, double>(AreaOrbitalLocations.GetKey(ClosestIndex), ClosestDistance);
+	}
+	else
+	{
+		return TPair<const UNovaArea*, double>(nullptr, MAX_FLT);
 	}
-
-	return TPair<const UNovaArea*, double>(ClosestArea, ClosestDistance);
 }
 
 TPair<const UNovaArea*, double> UNovaOrbitalSimulationComponent::GetPlayerNearestAreaAndDistanceAtArrival() const
@@ -779,6 +875,8 @@ float UNovaOrbitalSimulationComponent::GetCurrentSpacecraftThrustFactor(const FG
 
 void UNovaOrbitalSimulationComponent::ProcessOrbitCleanup()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaOrbitCleanup);
+
 	if (GetOwner()->GetLocalRole() == ROLE_Authority)
 	{
 		// We need orbit data right until the time a trajectory actually start, so we remove it there
@@ -794,63 +892,84 @@ void UNovaOrbitalSimulationComponent::ProcessOrbitCleanup()
 
 void UNovaOrbitalSimulationComponent::ProcessAreas()
 {
-	auto& UpdatedLocationMap = IsSimulatingPreview ? PreviewAreaOrbitalLocations : AreaOrbitalLocations;
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAreas);
 
-	for (const UNovaArea* Area : Areas)
+	auto& UpdatedLocations = IsSimulatingPreview ? PreviewAreaOrbitalLocations : AreaOrbitalLocations;
+
+	// Register areas once, since the list is only set at startup
+	if (UpdatedLocations.GetSourceRevision() != AreasRevision)
 	{
-		// Update the position
-		double CurrentPhase = GetAreaOrbit(Area).Geometry.GetPhase<true>(GetCurrentTime());
+		UpdatedLocations.Reset();
+		for (const UNovaArea* Area : Areas)
+		{
+			UpdatedLocations.FindOrAdd(Area, FNovaOrbitalLocation(GetAreaOrbit(Area).Geometry, 0));
+		}
+		UpdatedLocations.SetSourceRevision(AreasRevision);
+	}
+
+	// Update the phase
+	for (int32 Index = 0; Index < UpdatedLocations.Num(); Index++)
+	{
+		const double Phase = UpdatedLocations.GetConstants(Index).GetPhase<true>(GetCurrentTime());
+		UpdatedLocations.SetPhase(Index, Phase);
 
 #if 0
-		NLOG("UNovaOrbitalSimulationComponent::ProcessSpacecraftOrbits : %s has phase %f", *Area->Name.ToString(), CurrentPhase);
+		NLOG("UNovaOrbitalSimulationComponent::ProcessAreas : %s has phase %f", *UpdatedLocations.GetKey(Index)->Name.ToString(), Phase);
 #endif
-
-		// Add or update the current orbit and position
-		FNovaOrbitalLocation* Entry = UpdatedLocationMap.Find(Area);
-		if (Entry)
-		{
-			Entry->Phase = CurrentPhase;
-		}
-		else
-		{
-			UpdatedLocationMap.Add(Area, FNovaOrbitalLocation(GetAreaOrbit(Area).Geometry, CurrentPhase));
-		}
 	}
+
+	// Update the position
+	UpdatedLocations.Propagate(false);
 }
 
 void UNovaOrbitalSimulationComponent::ProcessAsteroids()
 {
-	auto& UpdatedLocationMap = IsSimulatingPreview ? PreviewAsteroidOrbitalLocations : AsteroidOrbitalLocations;
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaAsteroids);
 
-	const ANovaGameState* GameState = GetOwner<ANovaGameState>();
+	auto& UpdatedLocations = IsSimulatingPreview ? PreviewAsteroidOrbitalLocations : AsteroidOrbitalLocations;
 
-	for (const TPair<FGuid, FNovaAsteroid>& IdentifierAndAsteroid : GameState->GetAsteroidSimulation()->GetAsteroids())
+	const ANovaGameState*                   GameState          = GetOwner<ANovaGameState>();
+	const UNovaAsteroidSimulationComponent* AsteroidSimulation = GameState->GetAsteroidSimulation();
+	const TArray<FGuid>&                    Identifiers        = AsteroidSimulation->GetAsteroidIdentifiers();
+
+	// Start over when the catalog was replaced
+	if (UpdatedLocations.GetSourceRevision() != AsteroidSimulation->GetCatalogRevision())
 	{
-		// Update the position
-		double CurrentPhase = GetAsteroidOrbit(IdentifierAndAsteroid.Value).Geometry.GetPhase<true>(GetCurrentTime());
+		UpdatedLocations.Reset();
+		UpdatedLocations.SetSourceRevision(AsteroidSimulation->GetCatalogRevision());
+	}
 
-		// Add or update the current orbit and position
-		FNovaOrbitalLocation* Entry = UpdatedLocationMap.Find(IdentifierAndAsteroid.Key);
-		if (Entry)
-		{
-			Entry->Phase = CurrentPhase;
-		}
-		else
-		{
-			UpdatedLocationMap.Add(
-				IdentifierAndAsteroid.Key, FNovaOrbitalLocation(GetAsteroidOrbit(IdentifierAndAsteroid.Value).Geometry, CurrentPhase));
-		}
+	// Register asteroids published since the last update only, since a given catalog revision only ever grows in order
+	for (int32 Index = UpdatedLocations.Num(); Index < Identifiers.Num(); Index++)
+	{
+		const FNovaAsteroid* Asteroid = AsteroidSimulation->GetAsteroid(Identifiers[Index]);
+		NCHECK(Asteroid);
+		UpdatedLocations.FindOrAdd(Identifiers[Index], FNovaOrbitalLocation(GetAsteroidOrbit(*Asteroid).Geometry, 0));
+	}
+
+	// Update the phase
+	for (int32 Index = 0; Index < UpdatedLocations.Num(); Index++)
+	{
+		UpdatedLocations.SetPhase(Index, UpdatedLocations.GetConstants(Index).GetPhase<true>(GetCurrentTime()));
 	}
+
+	// Update the position
+	UpdatedLocations.Propagate(false);
 }
 
 void UNovaOrbitalSimulationComponent::ProcessSpacecraftOrbits()
 {
-	auto& UpdatedLocationMap = IsSimulatingPreview ? PreviewSpacecraftOrbitalLocations : SpacecraftOrbitalLocations;
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaSpacecraftOrbits);
+
+	auto& UpdatedLocations = IsSimulatingPreview ? PreviewSpacecraftOrbitalLocations : SpacecraftOrbitalLocations;
+	auto& Binding          = IsSimulatingPreview ? PreviewSpacecraftOrbitBinding : SpacecraftOrbitBinding;
+	Binding.Update(SpacecraftOrbitDatabase.Get(), SpacecraftOrbitDatabase.GetRevision(), UpdatedLocations);
 
+	int32 BindingIndex = 0;
 	for (const FNovaOrbitDatabaseEntry& DatabaseEntry : SpacecraftOrbitDatabase.Get())
 	{
 		// Update the position
-		const FNovaOrbitalLocation NewLocation = DatabaseEntry.Orbit.GetLocation(GetCurrentTime());
+		const FNovaOrbitalLocation NewLocation = DatabaseEntry.Orbit.GetLocation(GetCurrentTime(), DatabaseEntry.Constants);
 		FNovaCartesianLocation     NewCartesianLocation;
 		NewCartesianLocation.Location = NewLocation.GetCartesianLocation();
 		NewCartesianLocation.Velocity = NewLocation.GetOrbitalVelocity();
@@ -864,36 +983,31 @@ void UNovaOrbitalSimulationComponent::ProcessSpacecraftOrbits()
 		// Add or update the current orbit and position
 		for (const FGuid& Identifier : DatabaseEntry.Identifiers)
 		{
-			FNovaOrbitalLocation* Entry = UpdatedLocationMap.Find(Identifier);
-			if (Entry)
-			{
-				*Entry = NewLocation;
-			}
-			else
+			int32& Index = Binding.Indices[BindingIndex++];
+			if (Index == INDEX_NONE)
 			{
-				UpdatedLocationMap.Add(Identifier, NewLocation);
+				Index = UpdatedLocations.FindOrAdd(Identifier, NewLocation);
 			}
 
-			if (!IsSimulatingPreview)
-			{
-				FNovaCartesianLocation* CartesianEntry = SpacecraftCartesianLocations.Find(Identifier);
-				if (CartesianEntry)
-				{
-					*CartesianEntry = NewCartesianLocation;
-				}
-				else
-				{
-					SpacecraftCartesianLocations.Add(Identifier, NewCartesianLocation);
-				}
-			}
+			UpdatedLocations.SetLocation(Index, NewLocation);
+			UpdatedLocations.SetCartesianLocation(Index, NewCartesianLocation);
 		}
 	}
+
+	Binding.Commit(UpdatedLocations);
 }
 
 void UNovaOrbitalSimulationComponent::ProcessSpacecraftTrajectoriesForPreview()
 {
+	PreviewSpacecraftTrajectoryBinding.Update(
+		SpacecraftTrajectoryDatabase.Get(), SpacecraftTrajectoryDatabase.GetRevision(), PreviewSpacecraftOrbitalLocations);
+
+	int32 BindingIndex = 0;
 	for (const FNovaTrajectoryDatabaseEntry& DatabaseEntry : SpacecraftTrajectoryDatabase.Get())
 	{
+		const int32 FirstBindingIndex = BindingIndex;
+		BindingIndex += DatabaseEntry.Identifiers.Num();
+
 		if (GetCurrentTime() >= DatabaseEntry.Trajectory.GetFirstManeuverStartTime())
 		{
 			// Compute the new location
@@ -910,28 +1024,37 @@ void UNovaOrbitalSimulationComponent::ProcessSpacecraftTrajectoriesForPreview()
 #endif
 
 			// Add or update the current orbit and location
-			for (const FGuid& Identifier : DatabaseEntry.Identifiers)
+			for (int32 IdentifierIndex = 0; IdentifierIndex < DatabaseEntry.Identifiers.Num(); IdentifierIndex++)
 			{
-				FNovaOrbitalLocation* Entry = PreviewSpacecraftOrbitalLocations.Find(Identifier);
-				if (Entry)
+				int32& Index = PreviewSpacecraftTrajectoryBinding.Indices[FirstBindingIndex + IdentifierIndex];
+				if (Index == INDEX_NONE)
 				{
-					*Entry = NewLocation;
-				}
-				else
-				{
-					PreviewSpacecraftOrbitalLocations.Add(Identifier, NewLocation);
+					Index = PreviewSpacecraftOrbitalLocations.FindOrAdd(DatabaseEntry.Identifiers[IdentifierIndex], NewLocation);
 				}
+
+				PreviewSpacecraftOrbitalLocations.SetLocation(Index, NewLocation);
 			}
 		}
 	}
+
+	PreviewSpacecraftTrajectoryBinding.Commit(PreviewSpacecraftOrbitalLocations);
 }
 
 void UNovaOrbitalSimulationComponent::ProcessSpacecraftTrajectories()
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaSpacecraftTrajectories);
+
 	TArray<TArray<FGuid>> CompletedTrajectories;
 
+	SpacecraftTrajectoryBinding.Update(
+		SpacecraftTrajectoryDatabase.Get(), SpacecraftTrajectoryDatabase.GetRevision(), SpacecraftOrbitalLocations);
+
+	int32 BindingIndex = 0;
 	for (const FNovaTrajectoryDatabaseEntry& DatabaseEntry : SpacecraftTrajectoryDatabase.Get())
 	{
+		const int32 FirstBindingIndex = BindingIndex;
+		BindingIndex += DatabaseEntry.Identifiers.Num();
+
 		if (GetCurrentTime() >= DatabaseEntry.Trajectory.GetFirstManeuverStartTime())
 		{
 			// Compute the new location
@@ -954,27 +1077,16 @@ void UNovaOrbitalSimulationComponent::ProcessSpacecraftTrajectories()
 #endif
 
 			// Add or update the current orbit and location
-			for (const FGuid& Identifier : DatabaseEntry.Identifiers)
+			for (int32 IdentifierIndex = 0; IdentifierIndex < DatabaseEntry.Identifiers.Num(); IdentifierIndex++)
 			{
-				FNovaOrbitalLocation* Entry = SpacecraftOrbitalLocations.Find(Identifier);
-				if (Entry)
-				{
-					*Entry = NewLocation;
-				}
-				else
+				int32& Index = SpacecraftTrajectoryBinding.Indices[FirstBindingIndex + IdentifierIndex];
+				if (Index == INDEX_NONE)
 				{
-					SpacecraftOrbitalLocations.Add(Identifier, NewLocation);
+					Index = SpacecraftOrbitalLocations.FindOrAdd(DatabaseEntry.Identifiers[IdentifierIndex], NewLocation);
 				}
 
-				FNovaCartesianLocation* CartesianEntry = SpacecraftCartesianLocations.Find(Identifier);
-				if (CartesianEntry)
-				{
-					*CartesianEntry = NewCartesianLocation;
-				}
-				else
-				{
-					SpacecraftCartesianLocations.Add(Identifier, NewCartesianLocation);
-				}
+				SpacecraftOrbitalLocations.SetLocation(Index, NewLocation);
+				SpacecraftOrbitalLocations.SetCartesianLocation(Index, NewCartesianLocation);
 			}
 
 			// Complete the trajectory on arrival
@@ -14,14 +14,385 @@
 
 #include "NovaOrbitalSimulationComponent.generated.h"
 
-/** Precomputed Cartesian location data */
-struct FNovaCartesianLocation
+/** Contiguous store of orbital locations with stable indices, holding keys, orbital locations, geometry constants and Cartesian
+ * locations in parallel arrays. Entries are only ever appended, so indices remain valid until the store is reset.
+ * Cartesian locations are bucketed into a uniform grid, updated as entries move, for proximity queries. */
+template <typename KeyType>
+struct TNovaOrbitalLocationStore
 {
-	FVector2D Location;
-	FVector2D Velocity;
+	/** Size of a grid cell in km, in the order of magnitude of spawning distances */
+	static constexpr double GridCellSize = 250;
+
+	/** Get the index for Key, creating a new entry with Location if it doesn't exist */
+	int32 FindOrAdd(const KeyType& Key, const FNovaOrbitalLocation& Location)
+	{
+		const int32* IndexPtr = Indices.Find(Key);
+		if (IndexPtr)
+		{
+			return *IndexPtr;
+		}
+
+		const int32 NewIndex = Keys.Add(Key);
+		MembershipRevision++;
+		Locations.Add(Location);
+		Phases.Add(Location.Phase);
+		Constants.Add(FNovaOrbitGeometryConstants(Location.Geometry));
+		CartesianLocations.Add(FNovaCartesianLocation{FVector2D::ZeroVector, FVector2D::ZeroVector});
+		Propagator.Add(Location.Geometry);
+		Indices.Add(Key, NewIndex);
+
+		const FIntPoint Cell = GetGridCell(FVector2D::ZeroVector);
+		if (NewIndex == 0)
+		{
+			GridBounds = FIntRect(Cell, Cell);
+		}
+		GridCells.Add(Cell);
+		AddToGrid(NewIndex, Cell);
+
+		return NewIndex;
+	}
+
+	/** Get the index for Key, or INDEX_NONE */
+	int32 Find(const KeyType& Key) const
+	{
+		const int32* IndexPtr = Indices.Find(Key);
+		return IndexPtr ? *IndexPtr : INDEX_NONE;
+	}
+
+	/** Get the location for Key, or nullptr */
+	const FNovaOrbitalLocation* FindLocation(const KeyType& Key) const
+	{
+		const int32 Index = Find(Key);
+		return Index != INDEX_NONE ? &Locations[Index] : nullptr;
+	}
+
+	/** Get the Cartesian location for Key, or nullptr */
+	const FNovaCartesianLocation* FindCartesianLocation(const KeyType& Key) const
+	{
+		const int32 Index = Find(Key);
+		return Index != INDEX_NONE ? &CartesianLocations[Index] : nullptr;
+	}
+
+	/** Remove all entries while keeping the allocations */
+	void Reset()
+	{
+		Keys.Reset();
+		Locations.Reset();
+		Phases.Reset();
+		Constants.Reset();
+		CartesianLocations.Reset();
+		Propagator.Reset();
+		Indices.Reset();
+		GridCells.Reset();
+		Grid.Reset();
+		GridBounds     = FIntRect();
+		SourceRevision = 0;
+		MembershipRevision++;
+	}
+
+	/** Get the revision of the source data this store was registered from */
+	uint32 GetSourceRevision() const
+	{
+		return SourceRevision;
+	}
+
+	/** Record the revision of the source data this store was registered from */
+	void SetSourceRevision(uint32 Revision)
+	{
+		SourceRevision = Revision;
+	}
+
+	/** Get the revision of the store membership, which changes whenever entries are added or the store is reset */
+	uint32 GetMembershipRevision() const
+	{
+		return MembershipRevision;
+	}
+
+	/** Get the entry count */
+	int32 Num() const
+	{
+		return Keys.Num();
+	}
+
+	/** Get the memory used by the store */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = Keys.GetAllocatedSize() + Locations.GetAllocatedSize() + Phases.GetAllocatedSize() + Constants.GetAllocatedSize() +
+		              CartesianLocations.GetAllocatedSize() + Propagator.GetAllocatedSize() + Indices.GetAllocatedSize() +
+		              GridCells.GetAllocatedSize() + Grid.GetAllocatedSize();
+		for (const auto& Cell : Grid)
+		{
+			Size += Cell.Value.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+	/** Get the key at Index */
+	const KeyType& GetKey(int32 Index) const
+	{
+		return Keys[Index];
+	}
+
+	/** Get the orbital location at Index */
+	const FNovaOrbitalLocation& GetLocation(int32 Index) const
+	{
+		return Locations[Index];
+	}
+
+	/** Get the precomputed orbital constants at Index */
+	const FNovaOrbitGeometryConstants& GetConstants(int32 Index) const
+	{
+		return Constants[Index];
+	}
+
+	/** Get the Cartesian location at Index, in km */
+	const FNovaCartesianLocation& GetCartesianLocation(int32 Index) const
+	{
+		return CartesianLocations[Index];
+	}
+
+	/** Replace the orbital location at Index, refreshing the constants if the geometry changed */
+	void SetLocation(int32 Index, const FNovaOrbitalLocation& Location)
+	{
+		const FNovaOrbitGeometry& PreviousGeometry = Locations[Index].Geometry;
+		if (Location.Geometry != PreviousGeometry || Location.Geometry.Body != PreviousGeometry.Body)
+		{
+			Constants[Index] = FNovaOrbitGeometryConstants(Location.Geometry);
+			Propagator.Set(Index, Location.Geometry);
+		}
+
+		Locations[Index] = Location;
+		Phases[Index]    = Location.Phase;
+	}
+
+	/** Set the phase at Index, in degrees */
+	void SetPhase(int32 Index, double Phase)
+	{
+		Locations[Index].Phase = Phase;
+		Phases[Index]          = Phase;
+	}
+
+	/** Set the Cartesian location at Index for locations that aren't propagated */
+	void SetCartesianLocation(int32 Index, const FNovaCartesianLocation& CartesianLocation)
+	{
+		CartesianLocations[Index] = CartesianLocation;
+		UpdateGrid(Index);
+	}
+
+	/** Compute all Cartesian locations from the current phases in a single batch */
+	void Propagate(bool ComputeVelocities)
+	{
+		Propagator.Propagate(Phases, CartesianLocations, ComputeVelocities);
+
+		for (int32 Index = 0; Index < Num(); Index++)
+		{
+			UpdateGrid(Index);
+		}
+	}
+
+	/** Get the indices of all entries within Radius km of Center */
+	void FindInRadius(const FVector2D& Center, double Radius, TArray<int32>& Result) const
+	{
+		const double    RadiusSquared = Radius * Radius;
+		const FIntPoint MinCell       = GetGridCell(Center - FVector2D(Radius, Radius)).ComponentMax(GridBounds.Min);
+		const FIntPoint MaxCell       = GetGridCell(Center + FVector2D(Radius, Radius)).ComponentMin(GridBounds.Max);
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				const TArray<int32>* CellIndices = Grid.Find(FIntPoint(X, Y));
+				if (CellIndices)
+				{
+					for (int32 Index : *CellIndices)
+					{
+						if (FVector2D::DistSquared(CartesianLocations[Index].Location, Center) <= RadiusSquared)
+						{
+							Result.Add(Index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/** Get the index of the entry nearest to Center, or INDEX_NONE, searching grid rings outwards */
+	int32 FindNearest(const FVector2D& Center, double* Distance = nullptr) const
+	{
+		const FIntPoint CenterCell = GetGridCell(Center);
+		const FIntPoint MinOffset  = GridBounds.Min - CenterCell;
+		const FIntPoint MaxOffset  = GridBounds.Max - CenterCell;
+		const int32     MaxRing    = FMath::Max(FMath::Max(FMath::Abs(MinOffset.X), FMath::Abs(MaxOffset.X)),
+			FMath::Max(FMath::Abs(MinOffset.Y), FMath::Abs(MaxOffset.Y)));
+
+		int32  NearestIndex       = INDEX_NONE;
+		double NearestDistSquared = DBL_MAX;
+
+		auto ProcessCell = [&](int32 X, int32 Y)
+		{
+			const TArray<int32>* CellIndices = Grid.Find(FIntPoint(X, Y));
+			if (CellIndices)
+			{
+				for (int32 Index : *CellIndices)
+				{
+					const double DistSquared = FVector2D::DistSquared(CartesianLocations[Index].Location, Center);
+					if (DistSquared < NearestDistSquared)
+					{
+						NearestIndex       = Index;
+						NearestDistSquared = DistSquared;
+					}
+				}
+			}
+		};
+
+		// Entries in ring N+1 are at least N cells away, so stop once the nearest entry is closer than that
+		for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+		{
+			if (Ring == 0)
+			{
+				ProcessCell(CenterCell.X, CenterCell.Y);
+			}
+			else
+			{
+				for (int32 Offset = -Ring; Offset <= Ring; Offset++)
+				{
+					ProcessCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+					ProcessCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+				}
+				for (int32 Offset = -Ring + 1; Offset < Ring; Offset++)
+				{
+					ProcessCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+					ProcessCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+				}
+			}
+
+			if (NearestIndex != INDEX_NONE && NearestDistSquared <= FMath::Square(Ring * GridCellSize))
+			{
+				break;
+			}
+		}
+
+		if (Distance)
+		{
+			*Distance = NearestIndex != INDEX_NONE ? FMath::Sqrt(NearestDistSquared) : DBL_MAX;
+		}
+
+		return NearestIndex;
+	}
+
+private:
+
+	/** Get the grid cell for a Cartesian location */
+	static FIntPoint GetGridCell(const FVector2D& Location)
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / GridCellSize), FMath::FloorToInt(Location.Y / GridCellSize));
+	}
+
+	/** Insert Index into a grid cell */
+	void AddToGrid(int32 Index, const FIntPoint& Cell)
+	{
+		Grid.FindOrAdd(Cell).Add(Index);
+		GridBounds.Include(Cell);
+	}
+
+	/** Move Index to the grid cell matching its Cartesian location, if it changed */
+	void UpdateGrid(int32 Index)
+	{
+		const FIntPoint NewCell = GetGridCell(CartesianLocations[Index].Location);
+		if (NewCell != GridCells[Index])
+		{
+			TArray<int32>& PreviousCellIndices = Grid.FindChecked(GridCells[Index]);
+			PreviousCellIndices.RemoveSingleSwap(Index);
+			if (PreviousCellIndices.Num() == 0)
+			{
+				Grid.Remove(GridCells[Index]);
+			}
+
+			GridCells[Index] = NewCell;
+			AddToGrid(Index, NewCell);
+		}
+	}
+
+	TArray<KeyType>                     Keys;
+	TArray<FNovaOrbitalLocation>        Locations;
+	TArray<double>                      Phases;
+	TArray<FNovaOrbitGeometryConstants> Constants;
+	TArray<FNovaCartesianLocation>      CartesianLocations;
+	FNovaOrbitalPropagator              Propagator;
+	TMap<KeyType, int32>                Indices;
+
+	// Spatial index, with grid bounds only ever growing until the store is reset
+	TArray<FIntPoint>              GridCells;
+	TMap<FIntPoint, TArray<int32>> Grid;
+	FIntRect                       GridBounds;
+
+	// Revision of the source data, so that replaced entries are detected even when the count doesn't change
+	uint32 SourceRevision = 0;
+
+	// Revision of the keys held by the store
+	uint32 MembershipRevision = 0;
+};
+
+/** Store indices for all identifiers of a replicated database, in database order, so that updates write by index.
+ * Indices are only looked up again when the membership of the database or of the store changed. */
+struct FNovaOrbitalLocationBinding
+{
+	FNovaOrbitalLocationBinding() : IsValid(false), DatabaseRevision(0), StoreRevision(0)
+	{}
+
+	/** Look up the store indices again if the database or store membership changed, with INDEX_NONE for missing identifiers */
+	template <typename EntryType, typename KeyType>
+	void Update(const TArray<EntryType>& Entries, uint32 Revision, const TNovaOrbitalLocationStore<KeyType>& Store)
+	{
+		if (!IsValid || DatabaseRevision != Revision || StoreRevision != Store.GetMembershipRevision())
+		{
+			Indices.Reset();
+			for (const EntryType& Entry : Entries)
+			{
+				for (const FGuid& Identifier : Entry.Identifiers)
+				{
+					Indices.Add(Store.Find(Identifier));
+				}
+			}
+
+			IsValid          = true;
+			DatabaseRevision = Revision;
+			StoreRevision    = Store.GetMembershipRevision();
+		}
+	}
+
+	/** Mark the indices as matching the store after entries were added to it through this binding */
+	template <typename KeyType>
+	void Commit(const TNovaOrbitalLocationStore<KeyType>& Store)
+	{
+		StoreRevision = Store.GetMembershipRevision();
+	}
+
+	/** Force the indices to be looked up again, when the store was replaced */
+	void Invalidate()
+	{
+		IsValid = false;
+	}
+
+	// Store index for each identifier of each entry, in order
+	TArray<int32> Indices;
+
+private:
+
+	bool   IsValid;
+	uint32 DatabaseRevision;
+	uint32 StoreRevision;
 };
 
-/** Trajectory computation parameters */
+/** Propulsion state of a spacecraft at the start of a trajectory */
+struct FNovaTrajectorySpacecraftState
+{
+	FNovaSpacecraftPropulsionMetrics Metrics;
+	float                            CurrentCargoMass;
+	float                            CurrentPropellantMass;
+};
+
+/** Trajectory computation parameters, self-contained so that trajectories can be computed off the game thread */
 struct FNovaTrajectoryParameters
 {
 	FNovaTime     StartTime;
@@ -30,6 +401,8 @@ struct FNovaTrajectoryParameters
 	double        DestinationPhase;
 	TArray<FGuid> SpacecraftIdentifiers;
 
+	TArray<FNovaTrajectorySpacecraftState> SpacecraftStates;
+
 	const UNovaCelestialBody* Body;
 	double                    µ;
 };
@@ -73,8 +446,18 @@ public:
 	FNovaTrajectoryParameters PrepareTrajectory(
 		const FNovaOrbit& Source, const FNovaOrbit& Destination, FNovaTime DeltaTime, const TArray<FGuid>& SpacecraftIdentifiers) const;
 
-	/** Compute a trajectory */
-	FNovaTrajectory ComputeTrajectory(const FNovaTrajectoryParameters& Parameters, double PhasingAltitude);
+	/** Compute a trajectory, safe to call from any thread */
+	FNovaTrajectory ComputeTrajectory(const FNovaTrajectoryParameters& Parameters, double PhasingAltitude) const;
+
+	/** Compute the cost of a trajectory without building it, safe to call from any thread */
+	FNovaTrajectoryCost ComputeTrajectoryCost(const FNovaTrajectoryParameters& Parameters, double PhasingAltitude) const;
+
+	/** Compute the period of a stable circular orbit */
+	static FNovaTime GetOrbitalPeriod(const double GravitationalParameter, const double SemiMajorAxis)
+	{
+		const double CubedSemiMajorAxis = SemiMajorAxis * SemiMajorAxis * SemiMajorAxis;
+		return FNovaTime::FromMinutes(2.0 * DOUBLE_PI * sqrt(CubedSemiMajorAxis / GravitationalParameter) / 60.0);
+	}
 
 	/** Check if this spacecraft is on a trajectory */
 	bool IsOnTrajectory(const FGuid& SpacecraftIdentifier) const;
@@ -122,11 +505,13 @@ public:
 	/** Get an area's location */
 	const FNovaOrbitalLocation& GetAreaLocation(const UNovaArea* Area) const
 	{
-		return AreaOrbitalLocations[Area];
+		const FNovaOrbitalLocation* Location = AreaOrbitalLocations.FindLocation(Area);
+		NCHECK(Location);
+		return *Location;
 	}
 
 	/** Get all area's locations */
-	const TMap<const UNovaArea*, FNovaOrbitalLocation>& GetAreasLocations() const
+	const TNovaOrbitalLocationStore<const UNovaArea*>& GetAreasLocations() const
 	{
 		return AreaOrbitalLocations;
 	}
@@ -134,11 +519,21 @@ public:
 	/** Get an asteroid's location */
 	const FNovaOrbitalLocation& GetAsteroidLocation(const FGuid Identifier) const
 	{
-		return AsteroidOrbitalLocations[Identifier];
+		const FNovaOrbitalLocation* Location = AsteroidOrbitalLocations.FindLocation(Identifier);
+		NCHECK(Location);
+		return *Location;
+	}
+
+	/** Get an asteroid's Cartesian location in km */
+	FVector2D GetAsteroidCartesianLocation(const FGuid Identifier) const
+	{
+		const FNovaCartesianLocation* CartesianLocation = AsteroidOrbitalLocations.FindCartesianLocation(Identifier);
+		NCHECK(CartesianLocation);
+		return CartesianLocation->Location;
 	}
 
 	/** Get all asteroid's locations */
-	const TMap<FGuid, FNovaOrbitalLocation>& GetAsteroidsLocations() const
+	const TNovaOrbitalLocationStore<FGuid>& GetAsteroidsLocations() const
 	{
 		return AsteroidOrbitalLocations;
 	}
@@ -167,11 +562,11 @@ public:
 	/** Get a spacecraft's location */
 	const FNovaOrbitalLocation* GetSpacecraftLocation(const FGuid& Identifier) const
 	{
-		return SpacecraftOrbitalLocations.Find(Identifier);
+		return SpacecraftOrbitalLocations.FindLocation(Identifier);
 	}
 
 	/** Get all spacecraft's locations */
-	const TMap<FGuid, FNovaOrbitalLocation>& GetSpacecraftLocations() const
+	const TNovaOrbitalLocationStore<FGuid>& GetSpacecraftLocations() const
 	{
 		return SpacecraftOrbitalLocations;
 	}
@@ -200,22 +595,25 @@ public:
 		PreviewAreaOrbitalLocations       = AreaOrbitalLocations;
 		PreviewAsteroidOrbitalLocations   = AsteroidOrbitalLocations;
 		PreviewSpacecraftOrbitalLocations = SpacecraftOrbitalLocations;
+
+		PreviewSpacecraftOrbitBinding.Invalidate();
+		PreviewSpacecraftTrajectoryBinding.Invalidate();
 	}
 
 	/** Get all area's locations under preview */
-	const TMap<const UNovaArea*, FNovaOrbitalLocation>& GetPreviewAreasLocations() const
+	const TNovaOrbitalLocationStore<const UNovaArea*>& GetPreviewAreasLocations() const
 	{
 		return PreviewAreaOrbitalLocations;
 	}
 
 	/** Get all asteroid's locations under preview */
-	const TMap<FGuid, FNovaOrbitalLocation>& GetPreviewAsteroidsLocations() const
+	const TNovaOrbitalLocationStore<FGuid>& GetPreviewAsteroidsLocations() const
 	{
 		return PreviewAsteroidOrbitalLocations;
 	}
 
 	/** Get all spacecraft's locations under preview */
-	const TMap<FGuid, FNovaOrbitalLocation>& GetPreviewSpacecraftLocations() const
+	const TNovaOrbitalLocationStore<FGuid>& GetPreviewSpacecraftLocations() const
 	{
 		return PreviewSpacecraftOrbitalLocations;
 	}
@@ -223,7 +621,7 @@ public:
 	/** Get a spacecraft's location under preview */
 	const FNovaOrbitalLocation* GetPreviewSpacecraftLocation(const FGuid& Identifier) const
 	{
-		return PreviewSpacecraftOrbitalLocations.Find(Identifier);
+		return PreviewSpacecraftOrbitalLocations.FindLocation(Identifier);
 	}
 
 	/*----------------------------------------------------
@@ -236,7 +634,7 @@ public:
 	/** Get a spacecraft's Cartesian location in km  */
 	FVector2D GetSpacecraftCartesianLocation(const FGuid& Identifier) const
 	{
-		const FNovaCartesianLocation* CartesianLocation = SpacecraftCartesianLocations.Find(Identifier);
+		const FNovaCartesianLocation* CartesianLocation = SpacecraftOrbitalLocations.FindCartesianLocation(Identifier);
 		if (CartesianLocation != nullptr)
 		{
 			return CartesianLocation->Location;
@@ -250,7 +648,7 @@ public:
 	/** Get a spacecraft's orbital velocity in m/s */
 	FVector2D GetSpacecraftOrbitalVelocity(const FGuid& Identifier) const
 	{
-		const FNovaCartesianLocation* CartesianLocation = SpacecraftCartesianLocations.Find(Identifier);
+		const FNovaCartesianLocation* CartesianLocation = SpacecraftOrbitalLocations.FindCartesianLocation(Identifier);
 		if (CartesianLocation != nullptr)
 		{
 			return CartesianLocation->Velocity;
@@ -335,12 +733,6 @@ protected:
 	void ProcessSpacecraftTrajectoriesForPreview();
 	void ProcessSpacecraftTrajectories();
 
-	/** Compute the period of a stable circular orbit */
-	static FNovaTime GetOrbitalPeriod(const double GravitationalParameter, const double SemiMajorAxis)
-	{
-		return FNovaTime::FromMinutes(2.0 * DOUBLE_PI * sqrt(pow(SemiMajorAxis, 3.0) / GravitationalParameter) / 60.0);
-	}
-
 	/*----------------------------------------------------
 	    Properties
 	----------------------------------------------------*/
@@ -365,19 +757,23 @@ private:
 	FNovaTrajectoryDatabase SpacecraftTrajectoryDatabase;
 
 	// Simulation state
-	TMap<const class UNovaArea*, FNovaOrbitalLocation> AreaOrbitalLocations;
-	TMap<FGuid, FNovaOrbitalLocation>                  AsteroidOrbitalLocations;
-	TMap<FGuid, FNovaOrbitalLocation>                  SpacecraftOrbitalLocations;
-	TMap<FGuid, FNovaCartesianLocation>                SpacecraftCartesianLocations;
+	TNovaOrbitalLocationStore<const class UNovaArea*> AreaOrbitalLocations;
+	TNovaOrbitalLocationStore<FGuid>                  AsteroidOrbitalLocations;
+	TNovaOrbitalLocationStore<FGuid>                  SpacecraftOrbitalLocations;
+	FNovaOrbitalLocationBinding                       SpacecraftOrbitBinding;
+	FNovaOrbitalLocationBinding                       SpacecraftTrajectoryBinding;
 
 	// Preview simulation state
-	bool                                               IsSimulatingPreview;
-	FNovaTime                                          PreviewTime;
-	TMap<const class UNovaArea*, FNovaOrbitalLocation> PreviewAreaOrbitalLocations;
-	TMap<FGuid, FNovaOrbitalLocation>                  PreviewAsteroidOrbitalLocations;
-	TMap<FGuid, FNovaOrbitalLocation>                  PreviewSpacecraftOrbitalLocations;
+	bool                                              IsSimulatingPreview;
+	FNovaTime                                         PreviewTime;
+	TNovaOrbitalLocationStore<const class UNovaArea*> PreviewAreaOrbitalLocations;
+	TNovaOrbitalLocationStore<FGuid>                  PreviewAsteroidOrbitalLocations;
+	TNovaOrbitalLocationStore<FGuid>                  PreviewSpacecraftOrbitalLocations;
+	FNovaOrbitalLocationBinding                       PreviewSpacecraftOrbitBinding;
+	FNovaOrbitalLocationBinding                       PreviewSpacecraftTrajectoryBinding;
 
 	// General state
 	FNovaTime                      TimeOfNextPlayerManeuver;
 	TArray<const class UNovaArea*> Areas;
+	uint32                         AreasRevision;
 };
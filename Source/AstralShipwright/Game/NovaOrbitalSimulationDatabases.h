@@ -6,6 +6,7 @@
 #include "NovaGameTypes.h"
 #include "NovaOrbitalSimulationTypes.h"
 #include "Spacecraft/NovaSpacecraft.h"
+#include "NovaStats.h"
 
 #include "NovaOrbitalSimulationDatabases.generated.h"
 
@@ -13,22 +14,30 @@
     Cache maps for fast lookup net serialized arrays
 ----------------------------------------------------*/
 
-/** Map of FGuid -> T* that mirrors a TArray<T>, with FGuid == T.Identifier */
+/** Map of FGuid -> index that mirrors a TArray<T>, with FGuid == T.Identifier
+ * The map is maintained incrementally by Add & Remove, and only rebuilt by Update when replication changed the array behind its back.
+ * Lookups never modify the map, so that they can run from worker threads while the game thread doesn't update it.
+ */
 template <typename T>
 struct TGuidCacheMap
 {
+	TGuidCacheMap() : IsDirty(false), CachedNum(0)
+	{}
+
 	/** Add or update ArrayItem to the array Array held by structure Serializer */
 	bool Add(FFastArraySerializer& Serializer, TArray<T>& Array, const T& ArrayItem)
 	{
-		bool NewEntry = false;
+		Update(Array);
 
-		TPair<int32, const T*>* Entry = Map.Find(ArrayItem.Identifier);
+		const int32* ExistingIndex = Map.Find(ArrayItem.Identifier);
 
 		// Simple update
-		if (Entry)
+		if (ExistingIndex)
 		{
-			Array[Entry->Key] = ArrayItem;
-			Serializer.MarkItemDirty(Array[Entry->Key]);
+			Array[*ExistingIndex] = ArrayItem;
+			Serializer.MarkItemDirty(Array[*ExistingIndex]);
+
+			return false;
 		}
 
 		// Full addition
@@ -37,118 +46,142 @@ struct TGuidCacheMap
 			const int32 NewIndex = Array.Add(ArrayItem);
 			Serializer.MarkItemDirty(Array[NewIndex]);
 
-			NewEntry = true;
-		}
-
-		Update(Array);
+			Map.Add(ArrayItem.Identifier, NewIndex);
+			CachedNum = Array.Num();
 
-		return NewEntry;
+			return true;
+		}
 	}
 
 	/** Remove the item associated with Identifier from the array Array held by structure Serializer */
 	void Remove(FFastArraySerializer& Serializer, TArray<T>& Array, const FGuid& Identifier)
 	{
-		TPair<int32, const T*>* Entry = Map.Find(Identifier);
+		Update(Array);
 
-		if (Entry)
+		int32 Index = INDEX_NONE;
+		if (Map.RemoveAndCopyValue(Identifier, Index))
 		{
-			Array.RemoveAt(Entry->Key);
+			// Swap the last item into the free slot and fix its index
+			Array.RemoveAtSwap(Index);
+			if (Index < Array.Num())
+			{
+				Map.FindChecked(Array[Index].Identifier) = Index;
+			}
+
 			Serializer.MarkArrayDirty();
+			CachedNum = Array.Num();
 		}
-
-		Update(Array);
 	}
 
 	/** Get an item by identifier */
 	const T* Get(const FGuid& Identifier, const TArray<T>& Array) const
 	{
-		const TPair<int32, const T*>* Entry = Map.Find(Identifier);
+		NCHECK(!IsDirty && CachedNum == Array.Num());
 
-		if (Entry)
+		const int32* Index = Map.Find(Identifier);
+
+		if (Index)
 		{
-			NCHECK(Entry->Key >= 0 && Entry->Key < Array.Num());
-			NCHECK(Entry->Value == &Array[Entry->Key]);
+			// Check that the entry has a key (array index) between 0 and Num, pointing to the correct item
+			NCHECK(*Index >= 0 && *Index < Array.Num());
+			NCHECK(Array[*Index].Identifier == Identifier);
 		}
 
-		return Entry ? Entry->Value : nullptr;
+		return Index ? &Array[*Index] : nullptr;
 	}
 
-	/** Update the map from the array Array */
+	/** Update the map from the array Array on the game thread, only rebuilding it if the array was changed externally */
 	void Update(const TArray<T>& Array)
 	{
-		TArray<FGuid> KnownIdentifiers;
+		NCHECK(IsInGameThread());
 
-		// Database insertion and update
-		int32 Index = 0;
-		for (const T& ArrayItem : Array)
+		if (IsDirty || CachedNum != Array.Num())
 		{
-			TPair<int32, const T*>* Entry = Map.Find(ArrayItem.Identifier);
-
-			// Entry was found, update
-			if (Entry)
-			{
-				Entry->Key   = Index;
-				Entry->Value = &ArrayItem;
-			}
+			INC_DWORD_STAT(STAT_NovaCacheRebuilds);
 
-			// Entry was not found, add it
-			else
+			Map.Reset();
+			for (int32 Index = 0; Index < Array.Num(); Index++)
 			{
-				Map.Add(ArrayItem.Identifier, TPair<int32, const T*>(Index, &ArrayItem));
+				Map.Add(Array[Index].Identifier, Index);
 			}
 
-			KnownIdentifiers.Add(ArrayItem.Identifier);
-			Index++;
+			IsDirty   = false;
+			CachedNum = Array.Num();
 		}
+	}
 
-		// Prune unused entries
-		for (auto Iterator = Map.CreateIterator(); Iterator; ++Iterator)
+	/** Flag the map for a rebuild on the next access */
+	void MarkDirty()
+	{
+		IsDirty = true;
+	}
+
+	/** Replication callback for items that were added at AddedIndices */
+	void OnReplicatedAdd(const TArray<T>& Array, const TArrayView<int32>& AddedIndices)
+	{
+		if (!IsDirty)
 		{
-			if (!KnownIdentifiers.Contains(Iterator.Key()))
+			for (int32 Index : AddedIndices)
 			{
-				Iterator.RemoveCurrent();
+				Map.Add(Array[Index].Identifier, Index);
 			}
+			CachedNum = Array.Num();
 		}
+	}
 
-		for (auto& IdentifierAndEntry : Map)
+	/** Replication callback for items that were changed at ChangedIndices */
+	void OnReplicatedChange(const TArray<T>& Array, const TArrayView<int32>& ChangedIndices)
+	{
+		for (int32 Index : ChangedIndices)
 		{
-			// Check that the entry has a key (array index) between 0 and Num
-			NCHECK(IdentifierAndEntry.Value.Key >= 0 && IdentifierAndEntry.Value.Key < Array.Num());
-
-			// Check that the entry has a value (address) matching the actual address of the array entry at key (index)
-			NCHECK(IdentifierAndEntry.Value.Value == &Array[IdentifierAndEntry.Value.Key]);
+			const int32* ExistingIndex = Map.Find(Array[Index].Identifier);
+			if (ExistingIndex == nullptr || *ExistingIndex != Index)
+			{
+				IsDirty = true;
+			}
 		}
 	}
 
-	TMap<FGuid, TPair<int32, const T*>> Map;
+	/** Replication callback for items that are about to be removed from the array, reordering it */
+	void OnReplicatedRemove()
+	{
+		IsDirty = true;
+	}
+
+protected:
+
+	TMap<FGuid, int32> Map;
+	bool               IsDirty;
+	int32              CachedNum;
 };
 
-/** Map of multiple FGuid -> T* that mirrors a TArray<T>, with TArray<FGuid> == T.Identifiers */
+/** Map of multiple FGuid -> index that mirrors a TArray<T>, with TArray<FGuid> == T.Identifiers
+ * The map is maintained incrementally by Add & Remove, and only rebuilt by Update when replication changed the array behind its back.
+ * Lookups never modify the map, so that they can run from worker threads while the game thread doesn't update it.
+ */
 template <typename T>
 struct TMultiGuidCacheMap
 {
+	TMultiGuidCacheMap() : IsDirty(false), CachedNum(0), Revision(0)
+	{}
+
 	/** Add or update ArrayItem to the array Array held by structure Serializer */
 	bool Add(FFastArraySerializer& Serializer, TArray<T>& Array, const T& ArrayItem)
 	{
-		bool NewEntry = false;
+		Update(Array);
 
-		// Find the existing entry
-		int32 ExistingItemIndex = INDEX_NONE;
-		for (const FGuid& Identifier : ArrayItem.Identifiers)
-		{
-			TPair<int32, const T*>* Entry = Map.Find(Identifier);
-			if (Entry)
-			{
-				NCHECK(ExistingItemIndex == INDEX_NONE || Entry->Key == ExistingItemIndex);
-				ExistingItemIndex = Entry->Key;
-			}
-		}
+		const int32 ExistingItemIndex = FindIndex(ArrayItem.Identifiers);
 
-		// Simple update
+		// Simple update, with identifiers possibly changing
 		if (ExistingItemIndex != INDEX_NONE)
 		{
+			RemoveIdentifiers(Array[ExistingItemIndex]);
 			Array[ExistingItemIndex] = ArrayItem;
 			Serializer.MarkItemDirty(Array[ExistingItemIndex]);
+			AddIdentifiers(Array[ExistingItemIndex], ExistingItemIndex);
+			Revision++;
+
+			return false;
 		}
 
 		// Full addition
@@ -157,12 +190,12 @@ struct TMultiGuidCacheMap
 			const int32 NewIndex = Array.Add(ArrayItem);
 			Serializer.MarkItemDirty(Array[NewIndex]);
 
-			NewEntry = true;
-		}
+			AddIdentifiers(Array[NewIndex], NewIndex);
+			CachedNum = Array.Num();
+			Revision++;
 
-		Update(Array);
-
-		return NewEntry;
+			return true;
+		}
 	}
 
 	/** Remove the item associated with Identifiers from the array Array held by structure Serializer
@@ -170,96 +203,149 @@ struct TMultiGuidCacheMap
 	 */
 	void Remove(FFastArraySerializer& Serializer, TArray<T>& Array, const TArray<FGuid>& Identifiers)
 	{
-		bool IsDirty = false;
+		Update(Array);
 
-		// Find the existing entry
-		int32 ExistingItemIndex = INDEX_NONE;
-		for (const FGuid& Identifier : Identifiers)
+		const int32 ExistingItemIndex = FindIndex(Identifiers);
+
+		// Delete the entry, swapping the last item into the free slot and fixing its indices
+		if (ExistingItemIndex != INDEX_NONE)
 		{
-			TPair<int32, const T*>* Entry = Map.Find(Identifier);
-			if (Entry)
+			RemoveIdentifiers(Array[ExistingItemIndex]);
+			Array.RemoveAtSwap(ExistingItemIndex);
+			if (ExistingItemIndex < Array.Num())
 			{
-				NCHECK(ExistingItemIndex == INDEX_NONE || Entry->Key == ExistingItemIndex);
-				ExistingItemIndex = Entry->Key;
+				AddIdentifiers(Array[ExistingItemIndex], ExistingItemIndex);
 			}
-		}
 
-		// Delete the entry
-		if (ExistingItemIndex != INDEX_NONE)
-		{
-			Array.RemoveAt(ExistingItemIndex);
 			Serializer.MarkArrayDirty();
+			CachedNum = Array.Num();
+			Revision++;
 		}
-
-		Update(Array);
 	}
 
 	/** Get an item by identifier */
 	const T* Get(const FGuid& Identifier, const TArray<T>& Array) const
 	{
-		const TPair<int32, const T*>* Entry = Map.Find(Identifier);
+		NCHECK(!IsDirty && CachedNum == Array.Num());
 
-		if (Entry)
+		const int32* Index = Map.Find(Identifier);
+
+		if (Index)
 		{
 			// Check that the entry has a key (array index) between 0 and Num
-			NCHECK(Entry->Key >= 0 && Entry->Key < Array.Num());
+			NCHECK(*Index >= 0 && *Index < Array.Num());
 
-			// Check that the entry has a value (address) matching the actual address of the array entry at key (index)
-			NCHECK(Entry->Value == &Array[Entry->Key]);
+			// Check that the entry has a value (item) matching the actual identifiers of the array entry at key (index)
+			NCHECK(Array[*Index].Identifiers.Contains(Identifier));
 		}
 
-		return Entry ? Entry->Value : nullptr;
+		return Index ? &Array[*Index] : nullptr;
 	}
 
-	/** Update the map from the array Array */
+	/** Update the map from the array Array on the game thread, only rebuilding it if the array was changed externally */
 	void Update(const TArray<T>& Array)
 	{
-		TArray<FGuid> KnownIdentifiers;
+		NCHECK(IsInGameThread());
 
-		// Database insertion and update
-		int32 Index = 0;
-		for (const T& ArrayItem : Array)
+		if (IsDirty || CachedNum != Array.Num())
 		{
-			for (const FGuid& Identifier : ArrayItem.Identifiers)
+			INC_DWORD_STAT(STAT_NovaCacheRebuilds);
+
+			Map.Reset();
+			for (int32 Index = 0; Index < Array.Num(); Index++)
 			{
-				TPair<int32, const T*>* Entry = Map.Find(Identifier);
+				AddIdentifiers(Array[Index], Index);
+			}
 
-				// Entry was found, update
-				if (Entry)
-				{
-					Entry->Key   = Index;
-					Entry->Value = &ArrayItem;
-				}
+			IsDirty   = false;
+			CachedNum = Array.Num();
+			Revision++;
+		}
+	}
 
-				// Entry was not found, add it
-				else
-				{
-					Map.Add(Identifier, TPair<int32, const T*>(Index, &ArrayItem));
-				}
+	/** Get the revision of the array membership, which changes whenever items or their identifiers are added, removed or moved */
+	uint32 GetRevision() const
+	{
+		return Revision;
+	}
 
-				KnownIdentifiers.Add(Identifier);
-			}
+	/** Flag the map for a rebuild on the next access */
+	void MarkDirty()
+	{
+		IsDirty = true;
+		Revision++;
+	}
 
-			Index++;
+	/** Replication callback for items that were added at AddedIndices */
+	void OnReplicatedAdd(const TArray<T>& Array, const TArrayView<int32>& AddedIndices)
+	{
+		if (!IsDirty)
+		{
+			for (int32 Index : AddedIndices)
+			{
+				AddIdentifiers(Array[Index], Index);
+			}
+			CachedNum = Array.Num();
+			Revision++;
 		}
+	}
+
+	/** Replication callback for items that were changed at ChangedIndices, which may have changed identifiers */
+	void OnReplicatedChange(const TArray<T>& Array, const TArrayView<int32>& ChangedIndices)
+	{
+		IsDirty = true;
+		Revision++;
+	}
+
+	/** Replication callback for items that are about to be removed from the array, reordering it */
+	void OnReplicatedRemove()
+	{
+		IsDirty = true;
+		Revision++;
+	}
+
+protected:
+
+	/** Find the index of the item matching Identifiers */
+	int32 FindIndex(const TArray<FGuid>& Identifiers) const
+	{
+		int32 ExistingItemIndex = INDEX_NONE;
 
-		// Prune unused entries
-		for (auto Iterator = Map.CreateIterator(); Iterator; ++Iterator)
+		for (const FGuid& Identifier : Identifiers)
 		{
-			if (!KnownIdentifiers.Contains(Iterator.Key()))
+			const int32* Index = Map.Find(Identifier);
+			if (Index)
 			{
-				Iterator.RemoveCurrent();
+				NCHECK(ExistingItemIndex == INDEX_NONE || *Index == ExistingItemIndex);
+				ExistingItemIndex = *Index;
 			}
 		}
 
-		for (auto& IdentifierAndEntry : Map)
+		return ExistingItemIndex;
+	}
+
+	/** Map all identifiers of ArrayItem to Index */
+	void AddIdentifiers(const T& ArrayItem, int32 Index)
+	{
+		for (const FGuid& Identifier : ArrayItem.Identifiers)
 		{
-			NCHECK(IdentifierAndEntry.Value.Key >= 0 && IdentifierAndEntry.Value.Key < Array.Num());
-			NCHECK(IdentifierAndEntry.Value.Value == &Array[IdentifierAndEntry.Value.Key]);
+			Map.Add(Identifier, Index);
 		}
 	}
 
-	TMap<FGuid, TPair<int32, const T*>> Map;
+	/** Unmap all identifiers of ArrayItem */
+	void RemoveIdentifiers(const T& ArrayItem)
+	{
+		for (const FGuid& Identifier : ArrayItem.Identifiers)
+		{
+			Map.Remove(Identifier);
+		}
+	}
+
+	TMap<FGuid, int32> Map;
+	bool               IsDirty;
+	int32              CachedNum;
+	uint32             Revision;
 };
 
 /*----------------------------------------------------
@@ -274,7 +360,13 @@ struct FNovaSpacecraftDatabase : public FFastArraySerializer
 
 	bool Add(const FNovaSpacecraft& Spacecraft)
 	{
-		return Cache.Add(*this, Array, Spacecraft);
+		Cache.Update(Array);
+		const FNovaSpacecraft* ExistingSpacecraft = Get(Spacecraft.Identifier);
+
+		FNovaSpacecraft NewSpacecraft = Spacecraft;
+		NewSpacecraft.Revision        = FMath::Max(Spacecraft.Revision, ExistingSpacecraft ? ExistingSpacecraft->Revision : 0) + 1;
+
+		return Cache.Add(*this, Array, NewSpacecraft);
 	}
 
 	void Remove(const FGuid& Identifier)
@@ -297,6 +389,26 @@ struct FNovaSpacecraftDatabase : public FFastArraySerializer
 		Cache.Update(Array);
 	}
 
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedRemove();
+	}
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedAdd(Array, AddedIndices);
+	}
+
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedChange(Array, ChangedIndices);
+	}
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+	{
+		Cache.Update(Array);
+	}
+
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
 	{
 		return FFastArraySerializer::FastArrayDeltaSerialize<FNovaSpacecraft, FNovaSpacecraftDatabase>(Array, DeltaParms, *this);
@@ -335,11 +447,24 @@ struct FNovaOrbitDatabaseEntry : public FFastArraySerializerItem
 		return Orbit == Other.Orbit && Identifiers == Other.Identifiers;
 	}
 
+	void PostReplicatedAdd(const struct FNovaOrbitDatabase& InArraySerializer)
+	{
+		Constants = FNovaOrbitGeometryConstants(Orbit.Geometry);
+	}
+
+	void PostReplicatedChange(const struct FNovaOrbitDatabase& InArraySerializer)
+	{
+		Constants = FNovaOrbitGeometryConstants(Orbit.Geometry);
+	}
+
 	UPROPERTY()
 	FNovaOrbit Orbit;
 
 	UPROPERTY()
 	TArray<FGuid> Identifiers;
+
+	// Constants for the orbit geometry, computed locally when the entry is added
+	FNovaOrbitGeometryConstants Constants;
 };
 
 /** Orbit database with fast array replication and fast lookup */
@@ -355,6 +480,7 @@ struct FNovaOrbitDatabase : public FFastArraySerializer
 		FNovaOrbitDatabaseEntry TrajectoryData;
 		TrajectoryData.Orbit       = Orbit;
 		TrajectoryData.Identifiers = SpacecraftIdentifiers;
+		TrajectoryData.Constants   = FNovaOrbitGeometryConstants(Orbit.Geometry);
 
 		return Cache.Add(*this, Array, TrajectoryData);
 	}
@@ -375,11 +501,36 @@ struct FNovaOrbitDatabase : public FFastArraySerializer
 		Cache.Update(Array);
 	}
 
+	uint32 GetRevision() const
+	{
+		return Cache.GetRevision();
+	}
+
 	const TArray<FNovaOrbitDatabaseEntry>& Get() const
 	{
 		return Array;
 	}
 
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedRemove();
+	}
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedAdd(Array, AddedIndices);
+	}
+
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedChange(Array, ChangedIndices);
+	}
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+	{
+		Cache.Update(Array);
+	}
+
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
 	{
 		return FFastArraySerializer::FastArrayDeltaSerialize<FNovaOrbitDatabaseEntry, FNovaOrbitDatabase>(Array, DeltaParms, *this);
@@ -474,11 +625,36 @@ struct FNovaTrajectoryDatabase : public FFastArraySerializer
 		Cache.Update(Array);
 	}
 
+	uint32 GetRevision() const
+	{
+		return Cache.GetRevision();
+	}
+
 	const TArray<FNovaTrajectoryDatabaseEntry>& Get() const
 	{
 		return Array;
 	}
 
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedRemove();
+	}
+
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedAdd(Array, AddedIndices);
+	}
+
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+	{
+		Cache.OnReplicatedChange(Array, ChangedIndices);
+	}
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+	{
+		Cache.Update(Array);
+	}
+
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
 	{
 		return FFastArraySerializer::FastArrayDeltaSerialize<FNovaTrajectoryDatabaseEntry, FNovaTrajectoryDatabase>(
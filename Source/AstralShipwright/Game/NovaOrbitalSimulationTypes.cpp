@@ -2,8 +2,11 @@
 
 #include "NovaOrbitalSimulationTypes.h"
 #include "Spacecraft/NovaSpacecraft.h"
+#include "Neutron/System/NeutronAssetManager.h"
 #include "Neutron/UI/NeutronUI.h"
 
+#include "Misc/AutomationTest.h"
+
 /*----------------------------------------------------
     Simulation structures
 ----------------------------------------------------*/
@@ -157,3 +160,315 @@ TArray<FNovaOrbit> FNovaTrajectory::GetRelevantOrbitsForManeuver(const FNovaMane
 
 	return Result;
 }
+
+/*----------------------------------------------------
+    Batch propagation
+----------------------------------------------------*/
+
+void FNovaOrbitalPropagator::Reset()
+{
+	StartPhases.Reset();
+	SemiLatusRectums.Reset();
+	SignedEccentricities.Reset();
+	SignedHalfFocalDistances.Reset();
+	RotationCosines.Reset();
+	RotationSines.Reset();
+	OriginsX.Reset();
+	OriginsY.Reset();
+	GravitationalParameters.Reset();
+	InverseSemiMajorAxes.Reset();
+}
+
+int32 FNovaOrbitalPropagator::Add(const FNovaOrbitGeometry& Geometry)
+{
+	const int32 Index = StartPhases.AddUninitialized();
+	SemiLatusRectums.AddUninitialized();
+	SignedEccentricities.AddUninitialized();
+	SignedHalfFocalDistances.AddUninitialized();
+	RotationCosines.AddUninitialized();
+	RotationSines.AddUninitialized();
+	OriginsX.AddUninitialized();
+	OriginsY.AddUninitialized();
+	GravitationalParameters.AddUninitialized();
+	InverseSemiMajorAxes.AddUninitialized();
+
+	Set(Index, Geometry);
+
+	return Index;
+}
+
+void FNovaOrbitalPropagator::Set(int32 Index, const FNovaOrbitGeometry& Geometry)
+{
+	NCHECK(::IsValid(Geometry.Body));
+	NCHECK(Index >= 0 && Index < Num());
+
+	// Extract orbital parameters as FNovaOrbitalLocation::GetCartesianLocation does
+	const double BaseAltitude  = Geometry.Body->Radius;
+	const double SemiMajorAxis = 0.5 * (2.0 * BaseAltitude + Geometry.StartAltitude + Geometry.OppositeAltitude);
+	const double SemiMinorAxis = FMath::Sqrt((BaseAltitude + Geometry.StartAltitude) * (BaseAltitude + Geometry.OppositeAltitude));
+	const double SquaredEccentricity = 1.0 - FMath::Square(SemiMinorAxis) / FMath::Square(SemiMajorAxis);
+	const double Eccentricity =
+		(FMath::IsNearlyZero(SquaredEccentricity) || !FMath::IsFinite(SquaredEccentricity) || FMath::IsNaN(SquaredEccentricity))
+			? 0.0
+			: FMath::Sqrt(SquaredEccentricity);
+
+	// Orbits starting at periapsis are mirrored, which folds into the sign of the eccentricity and focal offset
+	const double Mirror           = Geometry.StartAltitude < Geometry.OppositeAltitude ? -1.0 : 1.0;
+	const double RotationAngle    = FMath::DegreesToRadians(-Geometry.StartPhase);
+	const double RotationCosine   = FMath::Cos(RotationAngle);
+	const double RotationSine     = FMath::Sin(RotationAngle);
+	const double OriginOffsetSize = SemiMajorAxis - Geometry.OppositeAltitude - BaseAltitude;
+	const double RadiusA          = Geometry.Body->GetRadius(Geometry.StartAltitude);
+	const double RadiusB          = Geometry.Body->GetRadius(Geometry.OppositeAltitude);
+
+	StartPhases[Index]              = Geometry.StartPhase;
+	SemiLatusRectums[Index]         = SemiMajorAxis * (1.0 - FMath::Square(Eccentricity));
+	SignedEccentricities[Index]     = Mirror * Eccentricity;
+	SignedHalfFocalDistances[Index] = Mirror * SemiMajorAxis * Eccentricity;
+	RotationCosines[Index]          = RotationCosine;
+	RotationSines[Index]            = RotationSine;
+	OriginsX[Index]                 = OriginOffsetSize * RotationCosine;
+	OriginsY[Index]                 = OriginOffsetSize * RotationSine;
+	GravitationalParameters[Index]  = Geometry.Body->GetGravitationalParameter();
+	InverseSemiMajorAxes[Index]     = 2.0 / (RadiusA + RadiusB);
+}
+
+/** Sine and cosine of four angles in radians within [-2π, 2π] in double precision, using a quadrant reduction to [-π/4, π/4]
+ * followed by Taylor polynomials that are accurate to about 1e-14 on that range */
+static FORCEINLINE void VectorSinCosDouble(
+	VectorRegister4Double& Sines, VectorRegister4Double& Cosines, const VectorRegister4Double& Angles)
+{
+	// Quarter turn split in a high part that multiplies small integers exactly, and a low part for the remainder
+	const VectorRegister4Double QuarterTurnHigh = VectorSetFloat1(1.57079632673412561417e+00);
+	const VectorRegister4Double QuarterTurnLow  = VectorSetFloat1(6.07710050650619224932e-11);
+	const VectorRegister4Double Half            = VectorSetFloat1(0.5);
+	const VectorRegister4Double One             = VectorSetFloat1(1.0);
+	const VectorRegister4Double Two             = VectorSetFloat1(2.0);
+
+	// Reduce to the nearest quarter turn
+	const VectorRegister4Double Quadrant = VectorFloor(VectorMultiplyAdd(Angles, VectorSetFloat1(2.0 / DOUBLE_PI), Half));
+	const VectorRegister4Double Reduced =
+		VectorSubtract(VectorSubtract(Angles, VectorMultiply(Quadrant, QuarterTurnHigh)), VectorMultiply(Quadrant, QuarterTurnLow));
+	const VectorRegister4Double Squared = VectorMultiply(Reduced, Reduced);
+
+	// Sine polynomial up to the 13th power
+	VectorRegister4Double Sine = VectorSetFloat1(1.0 / 6227020800.0);
+	Sine                       = VectorMultiplyAdd(Sine, Squared, VectorSetFloat1(-1.0 / 39916800.0));
+	Sine                       = VectorMultiplyAdd(Sine, Squared, VectorSetFloat1(1.0 / 362880.0));
+	Sine                       = VectorMultiplyAdd(Sine, Squared, VectorSetFloat1(-1.0 / 5040.0));
+	Sine                       = VectorMultiplyAdd(Sine, Squared, VectorSetFloat1(1.0 / 120.0));
+	Sine                       = VectorMultiplyAdd(Sine, Squared, VectorSetFloat1(-1.0 / 6.0));
+	Sine                       = VectorMultiplyAdd(VectorMultiply(Sine, Squared), Reduced, Reduced);
+
+	// Cosine polynomial up to the 14th power
+	VectorRegister4Double Cosine = VectorSetFloat1(-1.0 / 87178291200.0);
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(1.0 / 479001600.0));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(-1.0 / 3628800.0));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(1.0 / 40320.0));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(-1.0 / 720.0));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(1.0 / 24.0));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, VectorSetFloat1(-0.5));
+	Cosine                       = VectorMultiplyAdd(Cosine, Squared, One);
+
+	// Extract the two low bits of the quadrant as 0 or 1, floor-based so that negative quadrants wrap correctly
+	const VectorRegister4Double HalfQuadrant    = VectorFloor(VectorMultiply(Quadrant, Half));
+	const VectorRegister4Double QuarterQuadrant = VectorFloor(VectorMultiply(Quadrant, VectorSetFloat1(0.25)));
+	const VectorRegister4Double LowBit          = VectorSubtract(Quadrant, VectorMultiply(HalfQuadrant, Two));
+	const VectorRegister4Double HighBit         = VectorSubtract(HalfQuadrant, VectorMultiply(QuarterQuadrant, Two));
+	const VectorRegister4Double EitherBit =
+		VectorSubtract(VectorAdd(LowBit, HighBit), VectorMultiply(Two, VectorMultiply(LowBit, HighBit)));
+
+	// Odd quadrants swap sine and cosine, the sine is negated in quadrants 2 and 3, the cosine in quadrants 1 and 2
+	const VectorRegister4Double SwapMask = VectorCompareGT(LowBit, Half);
+	Sines   = VectorMultiply(VectorSelect(SwapMask, Cosine, Sine), VectorSubtract(One, VectorMultiply(Two, HighBit)));
+	Cosines = VectorMultiply(VectorSelect(SwapMask, Sine, Cosine), VectorSubtract(One, VectorMultiply(Two, EitherBit)));
+}
+
+/** Propagation kernel working on raw arrays, compiled once with and once without velocity computation
+ * Geometries are processed four at a time in SIMD registers, with a scalar loop for the remainder */
+template <bool ComputeVelocities>
+static void PropagateOrbitalLocations(int32 Count, const double* RESTRICT Phases, const double* RESTRICT StartPhases,
+	const double* RESTRICT SemiLatusRectums, const double* RESTRICT SignedEccentricities, const double* RESTRICT SignedHalfFocalDistances,
+	const double* RESTRICT RotationCosines, const double* RESTRICT RotationSines, const double* RESTRICT OriginsX,
+	const double* RESTRICT OriginsY, const double* RESTRICT GravitationalParameters, const double* RESTRICT InverseSemiMajorAxes,
+	FNovaCartesianLocation* RESTRICT Results)
+{
+	const VectorRegister4Double Turn        = VectorSetFloat1(360.0);
+	const VectorRegister4Double InverseTurn = VectorSetFloat1(1.0 / 360.0);
+	const VectorRegister4Double Half        = VectorSetFloat1(0.5);
+	const VectorRegister4Double One         = VectorSetFloat1(1.0);
+	const VectorRegister4Double Two         = VectorSetFloat1(2.0);
+	const VectorRegister4Double DegToRad    = VectorSetFloat1(DOUBLE_PI / 180.0);
+	const VectorRegister4Double KmToMeters  = VectorSetFloat1(1000.0);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Count; Index += 4)
+	{
+		// Reduce the relative phase to [-180, 180] without branching
+		VectorRegister4Double RelativePhase = VectorSubtract(VectorLoad(Phases + Index), VectorLoad(StartPhases + Index));
+		RelativePhase =
+			VectorSubtract(RelativePhase, VectorMultiply(Turn, VectorFloor(VectorMultiplyAdd(RelativePhase, InverseTurn, Half))));
+		VectorRegister4Double Sine, Cosine;
+		VectorSinCosDouble(Sine, Cosine, VectorMultiply(RelativePhase, DegToRad));
+
+		// Build the coordinates on the ellipse
+		const VectorRegister4Double R =
+			VectorDivide(VectorLoad(SemiLatusRectums + Index), VectorMultiplyAdd(VectorLoad(SignedEccentricities + Index), Cosine, One));
+		const VectorRegister4Double X = VectorMultiplyAdd(R, Cosine, VectorLoad(SignedHalfFocalDistances + Index));
+		const VectorRegister4Double Y = VectorNegate(VectorMultiply(R, Sine));
+
+		// Rotate and offset to the absolute location
+		const VectorRegister4Double RotationCosine = VectorLoad(RotationCosines + Index);
+		const VectorRegister4Double RotationSine   = VectorLoad(RotationSines + Index);
+		const VectorRegister4Double LocationX =
+			VectorSubtract(VectorMultiplyAdd(RotationCosine, X, VectorLoad(OriginsX + Index)), VectorMultiply(RotationSine, Y));
+		const VectorRegister4Double LocationY =
+			VectorMultiplyAdd(RotationCosine, Y, VectorMultiplyAdd(RotationSine, X, VectorLoad(OriginsY + Index)));
+
+		double LocationsX[4];
+		double LocationsY[4];
+		VectorStore(LocationX, LocationsX);
+		VectorStore(LocationY, LocationsY);
+
+		// Orbital velocity from the vis-viva equation, normal to the radius as in FNovaOrbitalLocation::GetOrbitalVelocity
+		if (ComputeVelocities)
+		{
+			const VectorRegister4Double Distance =
+				VectorSqrt(VectorMultiplyAdd(LocationX, LocationX, VectorMultiply(LocationY, LocationY)));
+			const VectorRegister4Double SquaredSpeed = VectorMultiply(VectorLoad(GravitationalParameters + Index),
+				VectorSubtract(VectorDivide(Two, VectorMultiply(Distance, KmToMeters)), VectorLoad(InverseSemiMajorAxes + Index)));
+
+			double SpeedFactors[4];
+			VectorStore(VectorDivide(VectorSqrt(SquaredSpeed), Distance), SpeedFactors);
+
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				Results[Index + Lane].Location = FVector2D(LocationsX[Lane], LocationsY[Lane]);
+				Results[Index + Lane].Velocity = FVector2D(-LocationsY[Lane], LocationsX[Lane]) * SpeedFactors[Lane];
+			}
+		}
+		else
+		{
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				Results[Index + Lane].Location = FVector2D(LocationsX[Lane], LocationsY[Lane]);
+			}
+		}
+	}
+
+	for (; Index < Count; Index++)
+	{
+		double RelativePhase = Phases[Index] - StartPhases[Index];
+		RelativePhase -= 360.0 * FMath::FloorToDouble(RelativePhase / 360.0 + 0.5);
+		const double Angle  = FMath::DegreesToRadians(RelativePhase);
+		const double Cosine = FMath::Cos(Angle);
+		const double Sine   = FMath::Sin(Angle);
+
+		const double R = SemiLatusRectums[Index] / (1.0 + SignedEccentricities[Index] * Cosine);
+		const double X = SignedHalfFocalDistances[Index] + R * Cosine;
+		const double Y = -R * Sine;
+
+		const double LocationX  = RotationCosines[Index] * X - RotationSines[Index] * Y + OriginsX[Index];
+		const double LocationY  = RotationSines[Index] * X + RotationCosines[Index] * Y + OriginsY[Index];
+		Results[Index].Location = FVector2D(LocationX, LocationY);
+
+		if (ComputeVelocities)
+		{
+			const double Distance     = FMath::Sqrt(LocationX * LocationX + LocationY * LocationY);
+			const double SquaredSpeed = GravitationalParameters[Index] * (2.0 / (Distance * 1000.0) - InverseSemiMajorAxes[Index]);
+			Results[Index].Velocity   = FVector2D(-LocationY, LocationX) * (FMath::Sqrt(SquaredSpeed) / Distance);
+		}
+	}
+}
+
+void FNovaOrbitalPropagator::Propagate(
+	TArrayView<const double> Phases, TArrayView<FNovaCartesianLocation> Results, bool ComputeVelocities) const
+{
+	NCHECK(Phases.Num() == Num());
+	NCHECK(Results.Num() == Num());
+
+	if (ComputeVelocities)
+	{
+		PropagateOrbitalLocations<true>(Num(), Phases.GetData(), StartPhases.GetData(), SemiLatusRectums.GetData(),
+			SignedEccentricities.GetData(), SignedHalfFocalDistances.GetData(), RotationCosines.GetData(), RotationSines.GetData(),
+			OriginsX.GetData(), OriginsY.GetData(), GravitationalParameters.GetData(), InverseSemiMajorAxes.GetData(), Results.GetData());
+	}
+	else
+	{
+		PropagateOrbitalLocations<false>(Num(), Phases.GetData(), StartPhases.GetData(), SemiLatusRectums.GetData(),
+			SignedEccentricities.GetData(), SignedHalfFocalDistances.GetData(), RotationCosines.GetData(), RotationSines.GetData(),
+			OriginsX.GetData(), OriginsY.GetData(), GravitationalParameters.GetData(), InverseSemiMajorAxes.GetData(), Results.GetData());
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*----------------------------------------------------
+    Tests
+----------------------------------------------------*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNovaOrbitalPropagatorTest, "Nova.OrbitalSimulation.Propagator",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/** Compare the batch propagator against FNovaOrbit::GetLocation on circular, elliptic and transfer orbits around every body */
+bool FNovaOrbitalPropagatorTest::RunTest(const FString& Parameters)
+{
+	// Not a multiple of four, so that both the SIMD and scalar paths are covered
+	constexpr int32 SampleCount = 130;
+
+	const TArray<const UNovaCelestialBody*> Bodies = UNeutronAssetManager::Get()->GetAssets<UNovaCelestialBody>();
+	TestTrue(TEXT("Celestial bodies are loaded"), Bodies.Num() > 0);
+
+	for (const UNovaCelestialBody* Body : Bodies)
+	{
+		const FNovaOrbitGeometry Geometries[] = {FNovaOrbitGeometry(Body, 300, 45), FNovaOrbitGeometry(Body, 300, 2000, 45, 405),
+			FNovaOrbitGeometry(Body, 2000, 300, 45, 405), FNovaOrbitGeometry(Body, 300, 2000, 45, 225),
+			FNovaOrbitGeometry(Body, 2000, 300, 45, 225)};
+		const TCHAR* GeometryNames[] = {TEXT("circular"), TEXT("elliptic from periapsis"), TEXT("elliptic from apoapsis"),
+			TEXT("raising transfer"), TEXT("lowering transfer")};
+
+		for (int32 GeometryIndex = 0; GeometryIndex < UE_ARRAY_COUNT(Geometries); GeometryIndex++)
+		{
+			const FNovaOrbitGeometry& Geometry = Geometries[GeometryIndex];
+			const FNovaOrbit          Orbit(Geometry, FNovaTime());
+			const FNovaTime           Duration = Geometry.GetOrbitalPeriod() * ((Geometry.EndPhase - Geometry.StartPhase) / 360.0);
+
+			// Sample the orbit from insertion to its end phase
+			FNovaOrbitalPropagator       Propagator;
+			TArray<double>               Phases;
+			TArray<FNovaOrbitalLocation> References;
+			for (int32 SampleIndex = 0; SampleIndex < SampleCount; SampleIndex++)
+			{
+				const FNovaOrbitalLocation Location = Orbit.GetLocation(Duration * (static_cast<double>(SampleIndex) / (SampleCount - 1)));
+				Propagator.Add(Geometry);
+				Phases.Add(Location.Phase);
+				References.Add(Location);
+			}
+
+			TArray<FNovaCartesianLocation> Results;
+			Results.SetNumUninitialized(SampleCount);
+			Propagator.Propagate(Phases, Results, true);
+
+			// Compare
+			double MaxLocationError = 0;
+			double MaxVelocityError = 0;
+			for (int32 SampleIndex = 0; SampleIndex < SampleCount; SampleIndex++)
+			{
+				const FNovaOrbitalLocation&   Reference = References[SampleIndex];
+				const FNovaCartesianLocation& Result    = Results[SampleIndex];
+				MaxLocationError = FMath::Max(MaxLocationError, FVector2D::Distance(Result.Location, Reference.GetCartesianLocation()));
+				MaxVelocityError = FMath::Max(MaxVelocityError, FVector2D::Distance(Result.Velocity, Reference.GetOrbitalVelocity()));
+			}
+
+			const FString Context = FString::Printf(TEXT("%s, %s"), *Body->Name.ToString(), GeometryNames[GeometryIndex]);
+			TestTrue(FString::Printf(TEXT("%s : max location error %.6fkm"), *Context, MaxLocationError),
+				MaxLocationError < FNovaOrbitalPropagator::Tolerance);
+			TestTrue(FString::Printf(TEXT("%s : max velocity error %.6fm/s"), *Context, MaxVelocityError),
+				MaxVelocityError < FNovaOrbitalPropagator::Tolerance);
+		}
+	}
+
+	return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
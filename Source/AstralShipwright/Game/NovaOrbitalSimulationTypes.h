@@ -37,6 +37,23 @@ class UNovaCelestialBody : public UNeutronAssetDescription
 
 public:
 
+	UNovaCelestialBody() : GravitationalParameter(0), GravitationalParameterRoot(0)
+	{}
+
+	virtual void PostLoad() override
+	{
+		Super::PostLoad();
+		UpdateGravitationalParameter();
+	}
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override
+	{
+		Super::PostEditChangeProperty(PropertyChangedEvent);
+		UpdateGravitationalParameter();
+	}
+#endif
+
 	/** Get the mass of the planet in kg */
 	double GetMass() const
 	{
@@ -45,9 +62,24 @@ public:
 
 	/** Get the gravitational parameter in m3/s² */
 	double GetGravitationalParameter() const
+	{
+		NCHECK(GravitationalParameter > 0);
+		return GravitationalParameter;
+	}
+
+	/** Get the square root of the gravitational parameter */
+	double GetGravitationalParameterRoot() const
+	{
+		NCHECK(GravitationalParameterRoot > 0);
+		return GravitationalParameterRoot;
+	}
+
+	/** Compute the gravitational parameter from the mass, to be called on the game thread when the mass is changed at runtime */
+	void UpdateGravitationalParameter()
 	{
 		constexpr double GravitationalConstant = 6.674e-11;
-		return GravitationalConstant * GetMass();
+		GravitationalParameter                 = GravitationalConstant * GetMass();
+		GravitationalParameterRoot             = FMath::Sqrt(GravitationalParameter);
 	}
 
 	/** Get a radius value in meters from altitude above ground in km */
@@ -89,6 +121,12 @@ public:
 	// Name to look for in the planetarium
 	UPROPERTY(Category = Properties, EditDefaultsOnly)
 	FName PlanetariumName;
+
+protected:
+
+	// Gravitational parameter in m3/s² and its square root, computed at load time so that readers on any thread never write
+	double GravitationalParameter;
+	double GravitationalParameterRoot;
 };
 
 /** Data for a stable orbit that might be a circular, elliptical or Hohmann transfer orbit */
@@ -141,24 +179,68 @@ struct FNovaOrbitGeometry
 		return FMath::Max(StartAltitude, OppositeAltitude);
 	}
 
-	/** Compute the period of this orbit geometry */
-	FNovaTime GetOrbitalPeriod() const
+	/** Get the semi-major axis of this orbit geometry in m */
+	double GetSemiMajorAxis() const
 	{
 		NCHECK(::IsValid(Body));
-		const double RadiusA = Body->GetRadius(StartAltitude);
-		const double RadiusB = Body->GetRadius(OppositeAltitude);
-		const double µ       = Body->GetGravitationalParameter();
+		return 0.5 * (Body->GetRadius(StartAltitude) + Body->GetRadius(OppositeAltitude));
+	}
 
-		const double SemiMajorAxis = 0.5 * (RadiusA + RadiusB);
-		return FNovaTime::FromMinutes(2.0 * DOUBLE_PI * FMath::Sqrt(FMath::Pow(SemiMajorAxis, 3.0) / µ) / 60.0);
+	/** Compute the period of this orbit geometry, with the same results as FNovaOrbitGeometryConstants */
+	FNovaTime GetOrbitalPeriod() const;
+
+	/** Get the current phase on this orbit, with the same results as FNovaOrbitGeometryConstants */
+	template <bool Unwind>
+	double GetPhase(FNovaTime DeltaTime) const;
+
+	UPROPERTY()
+	const UNovaCelestialBody* Body;
+
+	UPROPERTY()
+	double StartAltitude;
+
+	UPROPERTY()
+	double OppositeAltitude;
+
+	UPROPERTY()
+	double StartPhase;
+
+	UPROPERTY()
+	double EndPhase;
+};
+
+/** Immutable constants derived from an orbit geometry, computed once instead of on every query */
+struct FNovaOrbitGeometryConstants
+{
+	FNovaOrbitGeometryConstants()
+		: StartPhase(0), GravitationalParameter(0), SemiMajorAxis(0), SemiMinorAxis(0), Eccentricity(0), OrbitalPeriod(), MeanMotion(0)
+	{}
+
+	FNovaOrbitGeometryConstants(const FNovaOrbitGeometry& Geometry)
+		: StartPhase(Geometry.StartPhase), GravitationalParameter(Geometry.Body->GetGravitationalParameter())
+	{
+		const double RadiusA = Geometry.Body->GetRadius(Geometry.StartAltitude);
+		const double RadiusB = Geometry.Body->GetRadius(Geometry.OppositeAltitude);
+
+		SemiMajorAxis = Geometry.GetSemiMajorAxis();
+		SemiMinorAxis = FMath::Sqrt(RadiusA * RadiusB);
+		Eccentricity  = FMath::Abs(RadiusA - RadiusB) / (RadiusA + RadiusB);
+		OrbitalPeriod = GetOrbitalPeriod(Geometry.Body, SemiMajorAxis);
+		MeanMotion    = 360.0 / OrbitalPeriod.AsMinutes();
 	}
 
-	/** Get the current phase on this orbit */
+	/** Compute the period of an orbit with this semi-major axis in m around Body, using the body's cached gravitational parameter */
+	static FNovaTime GetOrbitalPeriod(const UNovaCelestialBody* Body, double SemiMajorAxis)
+	{
+		return FNovaTime::FromMinutes(
+			2.0 * DOUBLE_PI * SemiMajorAxis * FMath::Sqrt(SemiMajorAxis) / Body->GetGravitationalParameterRoot() / 60.0);
+	}
+
+	/** Get the phase on an orbit with this period and start phase after DeltaTime */
 	template <bool Unwind>
-	double GetPhase(FNovaTime DeltaTime) const
+	static double GetPhase(double StartPhase, FNovaTime OrbitalPeriod, FNovaTime DeltaTime)
 	{
-		NCHECK(Body);
-		const double PhaseDelta = (DeltaTime / GetOrbitalPeriod()) * 360;
+		const double PhaseDelta = (DeltaTime / OrbitalPeriod) * 360;
 		double       Result     = (Unwind ? FMath::Fmod(StartPhase + PhaseDelta, 360.0) : StartPhase + PhaseDelta);
 
 		if (Unwind)
@@ -169,22 +251,51 @@ struct FNovaOrbitGeometry
 		return Result;
 	}
 
-	UPROPERTY()
-	const UNovaCelestialBody* Body;
-
-	UPROPERTY()
-	double StartAltitude;
+	/** Check for validity */
+	bool IsValid() const
+	{
+		return MeanMotion > 0;
+	}
 
-	UPROPERTY()
-	double OppositeAltitude;
+	/** Get the current phase on this orbit */
+	template <bool Unwind>
+	double GetPhase(FNovaTime DeltaTime) const
+	{
+		NCHECK(IsValid());
+		return GetPhase<Unwind>(StartPhase, OrbitalPeriod, DeltaTime);
+	}
 
-	UPROPERTY()
+	// Phase at insertion in degrees
 	double StartPhase;
 
-	UPROPERTY()
-	double EndPhase;
+	// Gravitational parameter of the body in m3/s²
+	double GravitationalParameter;
+
+	// Semi-axes in m
+	double SemiMajorAxis;
+	double SemiMinorAxis;
+
+	// Orbital eccentricity
+	double Eccentricity;
+
+	// Orbital period
+	FNovaTime OrbitalPeriod;
+
+	// Mean motion in degrees per minute
+	double MeanMotion;
 };
 
+inline FNovaTime FNovaOrbitGeometry::GetOrbitalPeriod() const
+{
+	return FNovaOrbitGeometryConstants::GetOrbitalPeriod(Body, GetSemiMajorAxis());
+}
+
+template <bool Unwind>
+double FNovaOrbitGeometry::GetPhase(FNovaTime DeltaTime) const
+{
+	return FNovaOrbitGeometryConstants::GetPhase<Unwind>(StartPhase, GetOrbitalPeriod(), DeltaTime);
+}
+
 /** Current location of a spacecraft or sector, including orbit + phase */
 USTRUCT(Atomic)
 struct FNovaOrbitalLocation
@@ -277,6 +388,64 @@ struct FNovaOrbitalLocation
 	double Phase;
 };
 
+/** Precomputed Cartesian location data */
+struct FNovaCartesianLocation
+{
+	FVector2D Location;
+	FVector2D Velocity;
+};
+
+/** Batch propagator computing Cartesian locations for many orbital locations at once
+ * Per-geometry constants are computed once when a geometry is added and stored in parallel arrays,
+ * so that the propagation loop is branch-free and processes four geometries per iteration in SIMD registers */
+struct FNovaOrbitalPropagator
+{
+	/** Maximum distance between batch results and FNovaOrbitalLocation, in km for locations and m/s for velocities, checked by the
+	 * Nova.OrbitalSimulation.Propagator automation test */
+	static constexpr double Tolerance = 0.01;
+
+	/** Remove all geometries while keeping the allocations */
+	void Reset();
+
+	/** Add a geometry and return its index */
+	int32 Add(const FNovaOrbitGeometry& Geometry);
+
+	/** Replace the geometry at Index */
+	void Set(int32 Index, const FNovaOrbitGeometry& Geometry);
+
+	/** Get the geometry count */
+	int32 Num() const
+	{
+		return StartPhases.Num();
+	}
+
+	/** Get the memory used by the geometries */
+	SIZE_T GetAllocatedSize() const
+	{
+		return StartPhases.GetAllocatedSize() + SemiLatusRectums.GetAllocatedSize() + SignedEccentricities.GetAllocatedSize() +
+		       SignedHalfFocalDistances.GetAllocatedSize() + RotationCosines.GetAllocatedSize() + RotationSines.GetAllocatedSize() +
+		       OriginsX.GetAllocatedSize() + OriginsY.GetAllocatedSize() + GravitationalParameters.GetAllocatedSize() +
+		       InverseSemiMajorAxes.GetAllocatedSize();
+	}
+
+	/** Compute the absolute Cartesian location in km, and optionally the orbital velocity in m/s, for each geometry at the matching
+	 * phase in degrees */
+	void Propagate(TArrayView<const double> Phases, TArrayView<FNovaCartesianLocation> Results, bool ComputeVelocities) const;
+
+private:
+
+	TArray<double> StartPhases;
+	TArray<double> SemiLatusRectums;
+	TArray<double> SignedEccentricities;
+	TArray<double> SignedHalfFocalDistances;
+	TArray<double> RotationCosines;
+	TArray<double> RotationSines;
+	TArray<double> OriginsX;
+	TArray<double> OriginsY;
+	TArray<double> GravitationalParameters;
+	TArray<double> InverseSemiMajorAxes;
+};
+
 /** Orbit + time of insertion, allowing prediction of where a spacecraft will be at any time */
 USTRUCT(Atomic)
 struct FNovaOrbit
@@ -321,6 +490,13 @@ struct FNovaOrbit
 		return FNovaOrbitalLocation(Geometry, CurrentPhase);
 	}
 
+	/** Get the full location on this orbit using precomputed constants for its geometry */
+	FNovaOrbitalLocation GetLocation(FNovaTime CurrentTime, const FNovaOrbitGeometryConstants& Constants) const
+	{
+		double CurrentPhase = Constants.GetPhase<false>(CurrentTime - InsertionTime);
+		return FNovaOrbitalLocation(Geometry, CurrentPhase);
+	}
+
 	UPROPERTY()
 	FNovaOrbitGeometry Geometry;
 
@@ -580,3 +756,30 @@ struct FNovaTrajectory
 	UPROPERTY()
 	double TotalDeltaV;
 };
+
+/** Cost of a trajectory, computed without building the transfers and maneuvers */
+struct FNovaTrajectoryCost
+{
+	FNovaTrajectoryCost() : Valid(false), TotalDeltaV(0)
+	{}
+
+	/** Check whether the matching trajectory would be valid */
+	bool IsValid() const
+	{
+		return Valid;
+	}
+
+	/** Check for validity and a moderate travel time */
+	bool IsValidExtended() const
+	{
+		return IsValid() && FMath::IsFinite(TotalDeltaV) &&
+		       TotalTravelDuration < FNovaTime::FromDays(ENovaConstants::MaxTrajectoryDurationDays);
+	}
+
+	bool      Valid;
+	double    TotalDeltaV;
+	FNovaTime TotalTravelDuration;
+
+	// Propellant used in T for each spacecraft, stored inline for typical fleet sizes
+	TArray<float, TInlineAllocator<4>> PropellantUsed;
+};
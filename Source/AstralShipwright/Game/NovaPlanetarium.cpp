@@ -122,7 +122,7 @@ void ANovaPlanetarium::Tick(float DeltaTime)
 	NCHECK(Atmosphere);
 
 	// Get game state
-	const ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
+	ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
 	NCHECK(GameState);
 	const UNeutronAssetManager* AssetManager = UNeutronAssetManager::Get();
 	NCHECK(AssetManager);
@@ -226,6 +226,9 @@ void ANovaPlanetarium::Tick(float DeltaTime)
 			}
 		}
 	}
+
+	// Publish the sun direction for this frame
+	GameState->SetSunDirection(GetSunDirection());
 };
 
 FVector ANovaPlanetarium::GetSunDirection() const
@@ -0,0 +1,364 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#include "NovaSaveData.h"
+
+#include "Nova.h"
+
+#include "Neutron/System/NeutronSaveManager.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/GarbageCollection.h"
+
+/*----------------------------------------------------
+    Static data
+----------------------------------------------------*/
+
+FString         FNovaSaveArchive::CurrentSaveName;
+FDateTime       FNovaSaveArchive::LastSaveTime = FDateTime::MinValue();
+FGraphEventRef  FNovaSaveArchive::WriteEvent;
+TAtomic<uint32> FNovaSaveArchive::LatestWriteIndex(0);
+
+/*----------------------------------------------------
+    Slots
+----------------------------------------------------*/
+
+void FNovaSaveArchive::LoadGame(const FString& SaveName)
+{
+	NCHECK(IsInGameThread());
+	NLOG("FNovaSaveArchive::LoadGame : loading '%s'", *SaveName);
+
+	UNeutronSaveManager* SaveManager = UNeutronSaveManager::Get();
+	NCHECK(SaveManager);
+
+	// Let the save manager open the slot, which provides default data for new slots and reads older saves
+	Flush();
+	SaveManager->LoadGame<FNovaGameSave>(SaveName);
+	NCHECK(SaveManager->HasLoadedSaveData());
+	CurrentSaveName = SaveName;
+	LastSaveTime    = FDateTime::UtcNow();
+
+	// Replace the sections with the binary save when there is one
+	TArray<uint8> Data;
+	if (FFileHelper::LoadFileToArray(Data, *GetSavePath(SaveName), FILEREAD_Silent))
+	{
+		TSharedPtr<FNovaGameSave> SaveData = MakeShared<FNovaGameSave>(*SaveManager->GetCurrentSaveData<FNovaGameSave>());
+		if (Unserialize(Data, *SaveData))
+		{
+			SaveManager->SetCurrentSaveData<FNovaGameSave>(SaveData);
+		}
+		else
+		{
+			NERR("FNovaSaveArchive::LoadGame : '%s' could not be read, using the save manager data instead", *GetSavePath(SaveName));
+		}
+	}
+}
+
+void FNovaSaveArchive::WriteGame(TSharedPtr<FNovaGameSave> SaveData)
+{
+	NCHECK(IsInGameThread());
+	NCHECK(SaveData.IsValid());
+
+	UNeutronSaveManager* SaveManager = UNeutronSaveManager::Get();
+	NCHECK(SaveManager);
+
+	SaveManager->SetCurrentSaveData<FNovaGameSave>(SaveData);
+	LastSaveTime = FDateTime::UtcNow();
+
+	if (CurrentSaveName.IsEmpty())
+	{
+		NERR("FNovaSaveArchive::WriteGame : no save slot was opened");
+		return;
+	}
+
+	// Snapshot the data so that the game thread never shares it with the worker, which does all serialization and file work
+	TSharedRef<const FNovaGameSave> Snapshot   = MakeShared<const FNovaGameSave>(*SaveData);
+	const FString                   Path       = GetSavePath(CurrentSaveName);
+	const uint32                    WriteIndex = ++LatestWriteIndex;
+
+	// Chain writes so that they complete in order
+	FGraphEventArray Prerequisites;
+	if (WriteEvent.IsValid())
+	{
+		Prerequisites.Add(WriteEvent);
+	}
+
+	WriteEvent = FFunctionGraphTask::CreateAndDispatchWhenReady(
+		[Snapshot, Path, WriteIndex]()
+		{
+			// Skip this write if a newer one was requested meanwhile
+			if (WriteIndex == LatestWriteIndex)
+			{
+				TArray<uint8> Data;
+				Serialize(*Snapshot, Data, true);
+
+				// Write to a temporary file first so that an interrupted write never corrupts the slot
+				const FString TemporaryPath = Path + TEXT(".tmp");
+				if (FFileHelper::SaveArrayToFile(Data, *TemporaryPath) && IFileManager::Get().Move(*Path, *TemporaryPath, true))
+				{
+					NLOG("FNovaSaveArchive::WriteGame : wrote %d bytes to '%s'", Data.Num(), *Path);
+				}
+				else
+				{
+					NERR("FNovaSaveArchive::WriteGame : failed to write '%s'", *Path);
+				}
+			}
+		},
+		TStatId(), &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+}
+
+void FNovaSaveArchive::DeleteGame(const FString& SaveName)
+{
+	NCHECK(IsInGameThread());
+
+	Flush();
+	UNeutronSaveManager::Get()->DeleteGame(SaveName);
+	IFileManager::Get().Delete(*GetSavePath(SaveName), false, false, true);
+}
+
+void FNovaSaveArchive::Flush()
+{
+	NCHECK(IsInGameThread());
+
+	if (WriteEvent.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(WriteEvent);
+		WriteEvent = nullptr;
+	}
+}
+
+double FNovaSaveArchive::GetMinutesSinceLastSave()
+{
+	return (FDateTime::UtcNow() - LastSaveTime).GetTotalMinutes();
+}
+
+/*----------------------------------------------------
+    Serialization
+----------------------------------------------------*/
+
+void FNovaSaveArchive::Serialize(const FNovaGameSave& SaveData, TArray<uint8>& Data, bool Compress)
+{
+	TArray<FNovaSaveChunk> Chunks;
+	SerializeChunks(SaveData, Chunks);
+	WriteChunks(Chunks, Data, Compress);
+}
+
+bool FNovaSaveArchive::Unserialize(const TArray<uint8>& Data, FNovaGameSave& SaveData)
+{
+	NCHECK(IsInGameThread());
+	FMemoryReader Reader(Data, true);
+
+	// Header
+	uint32 Magic        = 0;
+	uint32 Version      = 0;
+	uint32 SectionCount = 0;
+	Reader << Magic << Version << SectionCount;
+	if (Reader.IsError() || Magic != ENovaSaveFormat::Magic || Version == 0 || Version > ENovaSaveFormat::Version)
+	{
+		NERR("FNovaSaveArchive::Unserialize : unsupported save format (version %d)", Version);
+		return false;
+	}
+
+	// Sections, which reset the matching data while sections missing from the file keep it
+	for (uint32 SectionIndex = 0; SectionIndex < SectionCount; SectionIndex++)
+	{
+		uint32        SectionId        = 0;
+		uint32        Compressed       = 0;
+		int32         UncompressedSize = 0;
+		TArray<uint8> Payload;
+		Reader << SectionId << Compressed << UncompressedSize << Payload;
+		if (Reader.IsError())
+		{
+			NERR("FNovaSaveArchive::Unserialize : truncated section %d", SectionIndex);
+			return false;
+		}
+		else if (UncompressedSize < 0 || UncompressedSize > ENovaSaveFormat::MaxSectionSize)
+		{
+			NERR("FNovaSaveArchive::Unserialize : invalid size %d for section %d", UncompressedSize, SectionId);
+			return false;
+		}
+
+		// Decompress
+		if (Compressed)
+		{
+			TArray<uint8> UncompressedPayload;
+			UncompressedPayload.SetNumUninitialized(UncompressedSize);
+			if (!FCompression::UncompressMemory(
+					NAME_Zlib, UncompressedPayload.GetData(), UncompressedSize, Payload.GetData(), Payload.Num()))
+			{
+				NERR("FNovaSaveArchive::Unserialize : failed to decompress section %d", SectionId);
+				return false;
+			}
+			Payload = MoveTemp(UncompressedPayload);
+		}
+
+		// Find the section structure, ignoring sections from newer versions
+		UScriptStruct* Struct      = nullptr;
+		void*          SectionData = nullptr;
+		switch (static_cast<ENovaSaveSection>(SectionId))
+		{
+			case ENovaSaveSection::Player:
+				Struct      = FNovaPlayerSave::StaticStruct();
+				SectionData = &SaveData.PlayerData;
+				break;
+
+			case ENovaSaveSection::GameState:
+				Struct      = FNovaGameStateSave::StaticStruct();
+				SectionData = &SaveData.GameStateData;
+				break;
+
+			case ENovaSaveSection::Contracts:
+				Struct      = FNeutronContractManagerSave::StaticStruct();
+				SectionData = &SaveData.ContractManagerData;
+				break;
+
+			default:
+				NLOG("FNovaSaveArchive::Unserialize : skipping unknown section %d", SectionId);
+				continue;
+		}
+
+		// Read the tagged properties, resolving asset references by path
+		Struct->ClearScriptStruct(SectionData);
+		FMemoryReader                      PayloadReader(Payload, true);
+		FObjectAndNameAsStringProxyArchive PayloadArchive(PayloadReader, true);
+		Struct->SerializeItem(PayloadArchive, SectionData, nullptr);
+		if (PayloadArchive.IsError())
+		{
+			NERR("FNovaSaveArchive::Unserialize : failed to read section %d", SectionId);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FNovaSaveArchive::CheckParity(const FNovaGameSave& SaveDataA, const FNovaGameSave& SaveDataB)
+{
+	return FNovaPlayerSave::StaticStruct()->CompareScriptStruct(&SaveDataA.PlayerData, &SaveDataB.PlayerData, PPF_None) &&
+	       FNovaGameStateSave::StaticStruct()->CompareScriptStruct(&SaveDataA.GameStateData, &SaveDataB.GameStateData, PPF_None) &&
+	       FNeutronContractManagerSave::StaticStruct()->CompareScriptStruct(
+			   &SaveDataA.ContractManagerData, &SaveDataB.ContractManagerData, PPF_None);
+}
+
+/*----------------------------------------------------
+    Internals
+----------------------------------------------------*/
+
+FString FNovaSaveArchive::GetSavePath(const FString& SaveName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SaveName + ENovaSaveFormat::Extension;
+}
+
+void FNovaSaveArchive::SerializeChunks(const FNovaGameSave& SaveData, TArray<FNovaSaveChunk>& Chunks)
+{
+	// Asset references are resolved to paths, so garbage collection must not run meanwhile
+	FGCScopeGuard GCGuard;
+	Chunks.Reset();
+
+	// Sections are independent so that an unchanged section always produces the same chunk
+	SerializeChunk(Chunks, ENovaSaveSection::Player, FNovaPlayerSave::StaticStruct(), &SaveData.PlayerData);
+	SerializeChunk(Chunks, ENovaSaveSection::GameState, FNovaGameStateSave::StaticStruct(), &SaveData.GameStateData);
+	SerializeChunk(Chunks, ENovaSaveSection::Contracts, FNeutronContractManagerSave::StaticStruct(), &SaveData.ContractManagerData);
+}
+
+void FNovaSaveArchive::SerializeChunk(
+	TArray<FNovaSaveChunk>& Chunks, ENovaSaveSection Section, UScriptStruct* Struct, const void* SectionData)
+{
+	FNovaSaveChunk& Chunk = Chunks.AddDefaulted_GetRef();
+	Chunk.Section         = Section;
+
+	// Write tagged properties so that fields can be added or removed without a format change, with asset references as paths
+	FMemoryWriter                      PayloadWriter(Chunk.Payload, true);
+	FObjectAndNameAsStringProxyArchive PayloadArchive(PayloadWriter, false);
+	Struct->SerializeItem(PayloadArchive, const_cast<void*>(SectionData), nullptr);
+}
+
+void FNovaSaveArchive::WriteChunks(TArray<FNovaSaveChunk>& Chunks, TArray<uint8>& Data, bool Compress)
+{
+	Data.Reset();
+	FMemoryWriter Writer(Data, true);
+
+	// Header
+	uint32 Magic        = ENovaSaveFormat::Magic;
+	uint32 Version      = ENovaSaveFormat::Version;
+	uint32 SectionCount = Chunks.Num();
+	Writer << Magic << Version << SectionCount;
+
+	for (FNovaSaveChunk& Chunk : Chunks)
+	{
+		uint32 SectionId        = static_cast<uint32>(Chunk.Section);
+		uint32 Compressed       = 0;
+		int32  UncompressedSize = Chunk.Payload.Num();
+
+		// Compress large sections
+		if (Compress && UncompressedSize >= ENovaSaveFormat::CompressionMin)
+		{
+			int32         CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+			TArray<uint8> CompressedPayload;
+			CompressedPayload.SetNumUninitialized(CompressedSize);
+			if (FCompression::CompressMemory(
+					NAME_Zlib, CompressedPayload.GetData(), CompressedSize, Chunk.Payload.GetData(), UncompressedSize))
+			{
+				CompressedPayload.SetNum(CompressedSize);
+				Chunk.Payload = MoveTemp(CompressedPayload);
+				Compressed    = 1;
+			}
+		}
+
+		Writer << SectionId << Compressed << UncompressedSize << Chunk.Payload;
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*----------------------------------------------------
+    Tests
+----------------------------------------------------*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FNovaSaveArchiveTest, "Nova.Save.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/** Write a save to a binary buffer and read it back, with and without compression, then check that truncated data is rejected */
+bool FNovaSaveArchiveTest::RunTest(const FString& Parameters)
+{
+	// Build a save with enough unlocked components for the player section to be compressed
+	FNovaGameSave SaveData;
+	SaveData.PlayerData.Spacecraft.Create(TEXT("Test spacecraft"));
+	SaveData.PlayerData.Credits          = FNovaCredits(123456);
+	SaveData.PlayerData.CurrentCrewCount = 7;
+	for (int32 Index = 0; Index < 512; Index++)
+	{
+		SaveData.PlayerData.UnlockedComponents.Add(FGuid::NewGuid());
+	}
+	SaveData.GameStateData.Time                 = FNovaTime::FromMinutes(12345.5);
+	SaveData.GameStateData.CurrentPriceRotation = 3;
+
+	for (bool Compress : {false, true})
+	{
+		TArray<uint8> Data;
+		FNovaSaveArchive::Serialize(SaveData, Data, Compress);
+
+		FNovaGameSave LoadedSaveData;
+		TestTrue(FString::Printf(TEXT("Unserialize (compressed : %d)"), Compress), FNovaSaveArchive::Unserialize(Data, LoadedSaveData));
+		TestTrue(FString::Printf(TEXT("Round-trip parity (compressed : %d)"), Compress),
+			FNovaSaveArchive::CheckParity(SaveData, LoadedSaveData));
+	}
+
+	// Truncated files must fail cleanly
+	TArray<uint8> Data;
+	FNovaSaveArchive::Serialize(SaveData, Data, true);
+	Data.SetNum(Data.Num() / 2);
+	AddExpectedError(TEXT("FNovaSaveArchive::Unserialize"), EAutomationExpectedErrorFlags::Contains, 0);
+	FNovaGameSave TruncatedSaveData;
+	TestFalse(TEXT("Truncated data is rejected"), FNovaSaveArchive::Unserialize(Data, TruncatedSaveData));
+
+	return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
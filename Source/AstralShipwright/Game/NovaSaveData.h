@@ -11,6 +11,8 @@
 #include "Neutron/System/NeutronContractManager.h"
 #include "Neutron/System/NeutronSaveManager.h"
 
+#include "Async/TaskGraphInterfaces.h"
+
 #include "NovaSaveData.generated.h"
 
 /*----------------------------------------------------
@@ -32,3 +34,100 @@ struct FNovaGameSave : public FNeutronSaveDataBase
 	UPROPERTY()
 	FNeutronContractManagerSave ContractManagerData;
 };
+
+/*----------------------------------------------------
+    Binary save format
+----------------------------------------------------*/
+
+/** Binary save file constants */
+namespace ENovaSaveFormat {
+
+constexpr uint32 Magic          = 0x5641534E;    // "NSAV"
+constexpr uint32 Version        = 1;
+constexpr int32  CompressionMin = 4096;
+constexpr int32  MaxSectionSize = 256 * 1024 * 1024;
+
+constexpr const TCHAR* Extension = TEXT(".nsav");
+
+};    // namespace ENovaSaveFormat
+
+/** Independent sections of a binary save, each stored as its own chunk */
+enum class ENovaSaveSection : uint32
+{
+	Player    = 1,
+	GameState = 2,
+	Contracts = 3
+};
+
+/** Tagged properties for one section of a binary save, only compressed when written to a buffer */
+struct FNovaSaveChunk
+{
+	ENovaSaveSection Section;
+	TArray<uint8>    Payload;
+};
+
+/** Binary save files with a versioned header and one tagged, optionally compressed chunk per section.
+ * Saves are snapshotted on the game thread, then serialized, compressed and written on a worker thread, loads happen on the game
+ * thread. Slots without a binary file still load from the save manager. */
+class FNovaSaveArchive
+{
+public:
+
+	/*----------------------------------------------------
+	    Slots
+	----------------------------------------------------*/
+
+	/** Load a save slot into the save manager, preferring the binary file when it exists */
+	static void LoadGame(const FString& SaveName);
+
+	/** Set the save data as current, and write a snapshot of it to the binary file in the background */
+	static void WriteGame(TSharedPtr<FNovaGameSave> SaveData);
+
+	/** Delete a save slot */
+	static void DeleteGame(const FString& SaveName);
+
+	/** Wait for pending writes to complete, called before loading, deleting, and on exit */
+	static void Flush();
+
+	/** Get the time since the last save was requested */
+	static double GetMinutesSinceLastSave();
+
+	/*----------------------------------------------------
+	    Serialization
+	----------------------------------------------------*/
+
+	/** Serialize save data to a binary buffer */
+	static void Serialize(const FNovaGameSave& SaveData, TArray<uint8>& Data, bool Compress = true);
+
+	/** Unserialize save data from a binary buffer, returns false on a format or version mismatch */
+	static bool Unserialize(const TArray<uint8>& Data, FNovaGameSave& SaveData);
+
+	/** Check that two versions of a save hold identical data */
+	static bool CheckParity(const FNovaGameSave& SaveDataA, const FNovaGameSave& SaveDataB);
+
+protected:
+
+	/** Get the binary file path for a slot */
+	static FString GetSavePath(const FString& SaveName);
+
+	/** Serialize each section into an uncompressed chunk, with asset references resolved to paths under a garbage collection guard */
+	static void SerializeChunks(const FNovaGameSave& SaveData, TArray<FNovaSaveChunk>& Chunks);
+
+	/** Serialize a section structure into an uncompressed chunk */
+	static void SerializeChunk(TArray<FNovaSaveChunk>& Chunks, ENovaSaveSection Section, UScriptStruct* Struct, const void* SectionData);
+
+	/** Write the header and chunks to a binary buffer, compressing large chunks in place, thread-safe */
+	static void WriteChunks(TArray<FNovaSaveChunk>& Chunks, TArray<uint8>& Data, bool Compress);
+
+	/*----------------------------------------------------
+	    Data
+	----------------------------------------------------*/
+
+	// Slot state, game thread only
+	static FString   CurrentSaveName;
+	static FDateTime LastSaveTime;
+
+	// Background writes, chained in order, where a newer request supersedes older ones still waiting
+	static FGraphEventRef  WriteEvent;
+	static TAtomic<uint32> LatestWriteIndex;
+};
@@ -0,0 +1,268 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#include "NovaSimulationBenchmarkCommandlet.h"
+
+#include "NovaArea.h"
+#include "NovaAISimulationComponent.h"
+#include "NovaAsteroidSimulationComponent.h"
+#include "NovaGameState.h"
+
+#include "Neutron/System/NeutronAssetManager.h"
+
+#include "Nova.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "JsonObjectConverter.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/*----------------------------------------------------
+    Allocation counting
+----------------------------------------------------*/
+
+/** Allocator proxy that counts allocations made on all threads */
+class FNovaCountingMalloc : public FMalloc
+{
+public:
+
+	FNovaCountingMalloc(FMalloc* Malloc) : InnerMalloc(Malloc), AllocationCount(0)
+	{}
+
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+	{
+		AllocationCount++;
+		return InnerMalloc->Malloc(Size, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+	{
+		if (Size > 0)
+		{
+			AllocationCount++;
+		}
+		return InnerMalloc->Realloc(Original, Size, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		InnerMalloc->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return InnerMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return InnerMalloc->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		InnerMalloc->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return InnerMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return InnerMalloc->ValidateHeap();
+	}
+
+	virtual void UpdateStats() override
+	{
+		InnerMalloc->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+	{
+		InnerMalloc->GetAllocatorStats(OutStats);
+	}
+
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+	{
+		InnerMalloc->DumpAllocatorStats(Ar);
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("NovaCountingMalloc");
+	}
+
+	FMalloc*       InnerMalloc;
+	TAtomic<int64> AllocationCount;
+};
+
+/*----------------------------------------------------
+    Constructor
+----------------------------------------------------*/
+
+UNovaSimulationBenchmarkCommandlet::UNovaSimulationBenchmarkCommandlet() : Super()
+{
+	IsClient     = false;
+	IsServer     = true;
+	IsEditor     = false;
+	LogToConsole = true;
+}
+
+/*----------------------------------------------------
+    Inherited
+----------------------------------------------------*/
+
+int32 UNovaSimulationBenchmarkCommandlet::Main(const FString& Params)
+{
+	// Read settings
+	FNovaSimulationBenchmarkReport Report;
+	FString                        OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("NovaSimulationBenchmark.json");
+	Report.Spacecraft                         = 100;
+	Report.Asteroids                          = 10000;
+	Report.Days                               = 30;
+	Report.StepMinutes                        = 60;
+	FParse::Value(*Params, TEXT("Spacecraft="), Report.Spacecraft);
+	FParse::Value(*Params, TEXT("Asteroids="), Report.Asteroids);
+	FParse::Value(*Params, TEXT("Days="), Report.Days);
+	FParse::Value(*Params, TEXT("Step="), Report.StepMinutes);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	Report.StepMinutes        = FMath::Max(Report.StepMinutes, 1);
+	Report.Steps              = FMath::Max(Report.Days * 24 * 60 / Report.StepMinutes, 1);
+	Report.BuildVersion       = FApp::GetBuildVersion();
+	Report.BuildConfiguration = LexToString(FApp::GetBuildConfiguration());
+
+	NLOG("UNovaSimulationBenchmarkCommandlet::Main : %d spacecraft, %d asteroids, %d days in %d steps", Report.Spacecraft,
+		Report.Asteroids, Report.Days, Report.Steps);
+
+	// Create a game world without players or rendering
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("NovaSimulationBenchmark"));
+	NCHECK(World);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	// Start the game state
+	ANovaGameState* GameState = World->SpawnActor<ANovaGameState>();
+	NCHECK(GameState);
+	GameState->DispatchBeginPlay();
+	GameState->SetCurrentArea(UNeutronAssetManager::Get()->GetDefaultAsset<UNovaArea>());
+	UNovaAISimulationComponent* AISimulation = GameState->GetAISimulation();
+	NCHECK(AISimulation);
+	UNovaAsteroidSimulationComponent* AsteroidSimulation = GameState->GetAsteroidSimulation();
+	NCHECK(AsteroidSimulation);
+
+	// Populate AI spacecraft
+	AISimulation->CreateGame(Report.Spacecraft);
+
+	// Regenerate the asteroid catalog at the requested size, and wait for it
+	UNovaAsteroidConfiguration* AsteroidConfiguration =
+		DuplicateObject(UNeutronAssetManager::Get()->GetDefaultAsset<UNovaAsteroidConfiguration>(), GetTransientPackage());
+	NCHECK(AsteroidConfiguration);
+	AsteroidConfiguration->AddToRoot();
+	AsteroidConfiguration->TotalAsteroidCount = Report.Asteroids;
+	uint64 Cycles                             = FPlatformTime::Cycles64();
+	AsteroidSimulation->Initialize(AsteroidConfiguration);
+	while (!AsteroidSimulation->IsCatalogComplete())
+	{
+		AsteroidSimulation->TickComponent(0, LEVELTICK_All, nullptr);
+		FPlatformProcess::Sleep(0.001f);
+	}
+	Report.CatalogGenerationMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Cycles);
+
+	// Count allocations for the duration of the run
+	FNovaCountingMalloc* CountingMalloc = new FNovaCountingMalloc(GMalloc);
+	GMalloc                             = CountingMalloc;
+
+	// Run the simulation, with each stage timed by its stat scope
+#if !UE_BUILD_SHIPPING
+	FNovaStageHistogram::ResetAll();
+	FNovaStageHistogram::SetAllocationCounter(&CountingMalloc->AllocationCount);
+	FNovaStageHistogram::SetRecording(true);
+#endif    // !UE_BUILD_SHIPPING
+	const int64                InitialAllocations = CountingMalloc->AllocationCount;
+	const FNovaTime            StepTime           = FNovaTime::FromMinutes(Report.StepMinutes);
+	const float                StepSeconds        = StepTime.AsSeconds();
+	const FPlatformMemoryStats InitialMemoryStats = FPlatformMemory::GetStats();
+	const uint64               StartCycles        = FPlatformTime::Cycles64();
+	for (int32 Step = 0; Step < Report.Steps; Step++)
+	{
+		GameState->ProcessGameSimulation(StepTime, ENovaSimulationDecision::Continue);
+		AISimulation->TickComponent(StepSeconds, LEVELTICK_All, nullptr);
+		AsteroidSimulation->TickComponent(StepSeconds, LEVELTICK_All, nullptr);
+	}
+
+	// Finalize the report, with memory growth measured over the whole process
+#if !UE_BUILD_SHIPPING
+	FNovaStageHistogram::SetRecording(false);
+	FNovaStageHistogram::SetAllocationCounter(nullptr);
+#endif    // !UE_BUILD_SHIPPING
+	Report.Allocations = CountingMalloc->AllocationCount - InitialAllocations;
+
+	// Stop counting, keeping the proxy alive since other threads may still be inside it
+	GMalloc = CountingMalloc->InnerMalloc;
+
+	const FPlatformMemoryStats FinalMemoryStats = FPlatformMemory::GetStats();
+	Report.TotalMs                              = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	Report.PeakUsedPhysicalMB                   = FinalMemoryStats.PeakUsedPhysical / (1024 * 1024);
+	Report.UsedPhysicalGrowthMB =
+		(static_cast<double>(FinalMemoryStats.UsedPhysical) - static_cast<double>(InitialMemoryStats.UsedPhysical)) / (1024 * 1024);
+
+#if !UE_BUILD_SHIPPING
+
+	TArray<FNovaStageSummary> Summaries;
+	FNovaStageHistogram::GetAllSummaries(Summaries);
+	for (const FNovaStageSummary& Summary : Summaries)
+	{
+		FNovaSimulationBenchmarkStage& Stage = Report.Stages.AddDefaulted_GetRef();
+		Stage.Name                           = Summary.Name;
+		Stage.Runs                           = Summary.RunCount;
+		Stage.TotalMs                        = Summary.TotalTime;
+		Stage.MeanMs                         = Summary.TotalTime / Summary.RunCount;
+		Stage.MaxMs                          = Summary.MaxTime;
+		Stage.Allocations                    = Summary.AllocationCount;
+
+		NLOG("UNovaSimulationBenchmarkCommandlet::Main : '%s' took %.2fms over %lld runs (%.3fms mean, %.3fms max), %lld allocations",
+			*Stage.Name, Stage.TotalMs, Stage.Runs, Stage.MeanMs, Stage.MaxMs, Stage.Allocations);
+	}
+
+#else
+
+	NERR("UNovaSimulationBenchmarkCommandlet::Main : stage timings are not recorded in shipping builds");
+
+#endif    // !UE_BUILD_SHIPPING
+
+	NLOG("UNovaSimulationBenchmarkCommandlet::Main : %.2fms total, %lld allocations, %.1fMB memory growth", Report.TotalMs,
+		Report.Allocations, Report.UsedPhysicalGrowthMB);
+
+	// Tear down the world
+	AsteroidConfiguration->RemoveFromRoot();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	// Write the report
+	FString ReportText;
+	if (FJsonObjectConverter::UStructToJsonObjectString(Report, ReportText) && FFileHelper::SaveStringToFile(ReportText, *OutputPath))
+	{
+		NLOG("UNovaSimulationBenchmarkCommandlet::Main : wrote '%s'", *OutputPath);
+		return 0;
+	}
+	else
+	{
+		NERR("UNovaSimulationBenchmarkCommandlet::Main : failed to write '%s'", *OutputPath);
+		return 1;
+	}
+}
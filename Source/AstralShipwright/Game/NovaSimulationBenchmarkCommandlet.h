@@ -0,0 +1,101 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "NovaSimulationBenchmarkCommandlet.generated.h"
+
+/** Measured cost of one profiled simulation stage over a benchmark run */
+USTRUCT()
+struct FNovaSimulationBenchmarkStage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	int64 Runs = 0;
+
+	UPROPERTY()
+	double TotalMs = 0;
+
+	UPROPERTY()
+	double MeanMs = 0;
+
+	UPROPERTY()
+	double MaxMs = 0;
+
+	UPROPERTY()
+	int64 Allocations = 0;
+};
+
+/** Benchmark report, written as JSON */
+USTRUCT()
+struct FNovaSimulationBenchmarkReport
+{
+	GENERATED_BODY()
+
+	// Build
+	UPROPERTY()
+	FString BuildVersion;
+
+	UPROPERTY()
+	FString BuildConfiguration;
+
+	// Settings
+	UPROPERTY()
+	int32 Spacecraft = 0;
+
+	UPROPERTY()
+	int32 Asteroids = 0;
+
+	UPROPERTY()
+	int32 Days = 0;
+
+	UPROPERTY()
+	int32 StepMinutes = 0;
+
+	UPROPERTY()
+	int32 Steps = 0;
+
+	// Results
+	UPROPERTY()
+	double CatalogGenerationMs = 0;
+
+	UPROPERTY()
+	double TotalMs = 0;
+
+	UPROPERTY()
+	int64 Allocations = 0;
+
+	UPROPERTY()
+	int64 PeakUsedPhysicalMB = 0;
+
+	UPROPERTY()
+	double UsedPhysicalGrowthMB = 0;
+
+	UPROPERTY()
+	TArray<FNovaSimulationBenchmarkStage> Stages;
+};
+
+/**
+ * Headless benchmark of the orbital, system, AI and asteroid simulations, without players or rendering.
+ * Usage : -run=NovaSimulationBenchmark -Spacecraft=100 -Asteroids=10000 -Days=30 -Step=60 -Output=Report.json -nullrhi
+ */
+UCLASS()
+class UNovaSimulationBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UNovaSimulationBenchmarkCommandlet();
+
+	/*----------------------------------------------------
+	    Inherited
+	----------------------------------------------------*/
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,175 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#include "NovaSystemSimulationComponent.h"
+
+#include "NovaGameState.h"
+#include "NovaOrbitalSimulationComponent.h"
+#include "NovaOrbitalSimulationDatabases.h"
+
+#include "Spacecraft/NovaSpacecraft.h"
+#include "Spacecraft/System/NovaSpacecraftPowerSystem.h"
+#include "Spacecraft/System/NovaSpacecraftPropellantSystem.h"
+#include "Spacecraft/System/NovaSpacecraftProcessingSystem.h"
+
+#include "Nova.h"
+
+#include "Async/ParallelFor.h"
+
+/*----------------------------------------------------
+    Constructor
+----------------------------------------------------*/
+
+UNovaSystemSimulationComponent::UNovaSystemSimulationComponent() : Super()
+{}
+
+/*----------------------------------------------------
+    Interface
+----------------------------------------------------*/
+
+void UNovaSystemSimulationComponent::UpdateSimulation(
+	FNovaSpacecraftDatabase& Database, const TSet<FGuid>& PawnSpacecraft, FNovaTime InitialTime, FNovaTime FinalTime)
+{
+	NCHECK(GetOwner()->GetLocalRole() == ROLE_Authority);
+
+	// Get game pointers
+	const ANovaGameState* GameState = Cast<ANovaGameState>(GetOwner());
+	NCHECK(GameState);
+	const UNovaOrbitalSimulationComponent* OrbitalSimulation = GameState->GetOrbitalSimulation();
+	NCHECK(OrbitalSimulation);
+
+	// Drop states for spacecraft that were removed or are now simulated by a pawn, which mirrored the state when loading
+	for (auto It = SystemStates.CreateIterator(); It; ++It)
+	{
+		if (Database.Get(It.Key()) == nullptr || PawnSpacecraft.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Create or rebuild states before taking pointers to them
+	for (FNovaSpacecraft& Spacecraft : Database.Get())
+	{
+		if (!PawnSpacecraft.Contains(Spacecraft.Identifier))
+		{
+			FNovaSpacecraftSystemState& State = SystemStates.FindOrAdd(Spacecraft.Identifier);
+			if (!State.IsInitialized || State.AssemblyRevision != Spacecraft.GetAssemblyRevision())
+			{
+				InitializeState(Spacecraft, State);
+			}
+		}
+	}
+
+	// Build the batch, resolving lookups on the game thread
+	Batch.Reset();
+	for (FNovaSpacecraft& Spacecraft : Database.Get())
+	{
+		FNovaSpacecraftSystemState* State = SystemStates.Find(Spacecraft.Identifier);
+		if (State)
+		{
+			FNovaSpacecraftSystemBatchEntry Entry;
+			Entry.Spacecraft      = &Spacecraft;
+			Entry.State           = State;
+			Entry.Location        = OrbitalSimulation->GetSpacecraftLocation(Spacecraft.Identifier);
+			Entry.Trajectory      = OrbitalSimulation->GetSpacecraftTrajectory(Spacecraft.Identifier);
+			Entry.TrajectoryIndex = Entry.Trajectory ? OrbitalSimulation->GetSpacecraftTrajectoryIndex(Spacecraft.Identifier) : INDEX_NONE;
+			Entry.HasChangedCargo = false;
+			Batch.Add(Entry);
+		}
+	}
+
+	// Simulate all spacecraft in parallel, each entry only touches its own record and state
+	const FNovaTime DeltaTime = FinalTime - InitialTime;
+	ParallelFor(Batch.Num(),
+		[this, DeltaTime, FinalTime](int32 Index)
+		{
+			FNovaSpacecraftSystemBatchEntry& Entry      = Batch[Index];
+			FNovaSpacecraft&                 Spacecraft = *Entry.Spacecraft;
+			FNovaSpacecraftSystemState&      State      = *Entry.State;
+
+			// Processing runs on the energy left by the previous step, like the pawn systems, and directly on the spacecraft cargo
+			State.RemainingProductionTime = FNovaTime::FromMinutes(DBL_MAX);
+			Entry.HasChangedCargo         = UNovaSpacecraftProcessingSystem::UpdateProcessingGroups(
+				Spacecraft, State.ProcessingGroupsStates,
+				[&Spacecraft](int32 CompartmentIndex, int32 ModuleIndex) -> FNovaSpacecraftCargo&
+				{
+					return Spacecraft.GetCargo(CompartmentIndex, ModuleIndex);
+				},
+				false, UNovaSpacecraftPowerSystem::ComputePoweredTime(State.CurrentEnergy, State.CurrentPower), DeltaTime,
+				State.RemainingProductionTime);
+
+			// Power, without the mining rig and radio mast that require a physical spacecraft
+			double PowerConsumption = 0;
+			for (const FNovaSpacecraftProcessingSystemGroupState& GroupState : State.ProcessingGroupsStates)
+			{
+				PowerConsumption += UNovaSpacecraftProcessingSystem::GetGroupPowerUsage(GroupState, true);
+			}
+
+			// Integrate energy over the orbit so that long steps go through eclipses correctly
+			const double BaseProduction  = UNovaSpacecraftPowerSystem::ComputePowerProduction(Spacecraft, 0);
+			const double SolarProduction = UNovaSpacecraftPowerSystem::ComputePowerProduction(Spacecraft, 1) - BaseProduction;
+			const double EnergyCapacity  = Spacecraft.GetPowerMetrics().EnergyCapacity;
+			if (Entry.Location)
+			{
+				if (!State.ExposureProfile.IsValidFor(Entry.Location->Geometry))
+				{
+					UNovaSpacecraftPowerSystem::BuildSolarExposureProfile(Entry.Location->Geometry, State.ExposureProfile);
+				}
+
+				State.CurrentExposureRatio = UNovaSpacecraftPowerSystem::ComputeSolarExposure(*Entry.Location);
+				State.CurrentEnergy        = UNovaSpacecraftPowerSystem::IntegrateEnergy(State.ExposureProfile, Entry.Location->Phase,
+					DeltaTime, SolarProduction, BaseProduction - PowerConsumption, State.CurrentEnergy, EnergyCapacity);
+			}
+			else
+			{
+				const double Power         = BaseProduction - PowerConsumption;
+				State.CurrentExposureRatio = 0;
+				State.CurrentEnergy        = FMath::Clamp(State.CurrentEnergy + Power * DeltaTime.AsHours(), 0.0, EnergyCapacity);
+			}
+			State.CurrentPower = BaseProduction + State.CurrentExposureRatio * SolarProduction - PowerConsumption;
+
+			// Propellant
+			if (Entry.Trajectory)
+			{
+				State.PropellantMass = UNovaSpacecraftPropellantSystem::ComputePropellantMass(*Entry.Trajectory, Entry.TrajectoryIndex,
+					Spacecraft.GetPropulsionMetrics(), Spacecraft.PropellantMassAtLaunch, FinalTime, State.PropellantRate);
+			}
+			else
+			{
+				State.PropellantMass = Spacecraft.PropellantMassAtLaunch;
+				State.PropellantRate = 0;
+			}
+		});
+
+	// Replicate the records whose cargo changed
+	for (FNovaSpacecraftSystemBatchEntry& Entry : Batch)
+	{
+		if (Entry.HasChangedCargo)
+		{
+			Entry.Spacecraft->Revision++;
+			Database.MarkItemDirty(*Entry.Spacecraft);
+		}
+	}
+}
+
+/*----------------------------------------------------
+    Internals
+----------------------------------------------------*/
+
+void UNovaSystemSimulationComponent::InitializeState(FNovaSpacecraft& Spacecraft, FNovaSpacecraftSystemState& State)
+{
+	NLOG("UNovaSystemSimulationComponent::InitializeState : '%s'", *Spacecraft.Identifier.ToString(EGuidFormats::Short));
+
+	// Rebuild processing groups, resuming production as the pawn left it
+	Spacecraft.UpdateModuleGroups();
+	UNovaSpacecraftProcessingSystem::BuildProcessingGroups(Spacecraft, State.ProcessingGroupsStates);
+	for (FNovaSpacecraftProcessingSystemGroupState& GroupState : State.ProcessingGroupsStates)
+	{
+		GroupState.Active = Spacecraft.ActiveProcessingGroups.Contains(GroupState.GroupIndex);
+	}
+
+	// New spacecraft start with full batteries
+	const double EnergyCapacity = Spacecraft.GetPowerMetrics().EnergyCapacity;
+	State.CurrentEnergy         = State.IsInitialized ? FMath::Min(State.CurrentEnergy, EnergyCapacity) : EnergyCapacity;
+	State.AssemblyRevision      = Spacecraft.GetAssemblyRevision();
+	State.IsInitialized         = true;
+}
@@ -0,0 +1,99 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#pragma once
+
+#include "EngineMinimal.h"
+#include "NovaGameTypes.h"
+#include "Spacecraft/System/NovaSpacecraftPowerSystem.h"
+#include "Spacecraft/System/NovaSpacecraftProcessingSystem.h"
+#include "NovaSystemSimulationComponent.generated.h"
+
+/** Headless system state for a spacecraft simulated without a pawn */
+struct FNovaSpacecraftSystemState
+{
+	FNovaSpacecraftSystemState()
+		: RemainingProductionTime(FNovaTime::FromMinutes(DBL_MAX))
+		, CurrentEnergy(0)
+		, CurrentPower(0)
+		, CurrentExposureRatio(0)
+		, PropellantMass(0)
+		, PropellantRate(0)
+		, AssemblyRevision(0)
+		, IsInitialized(false)
+	{}
+
+	// Processing
+	TArray<FNovaSpacecraftProcessingSystemGroupState> ProcessingGroupsStates;
+	FNovaTime                                         RemainingProductionTime;
+
+	// Power
+	double                    CurrentEnergy;
+	double                    CurrentPower;
+	double                    CurrentExposureRatio;
+	FNovaSolarExposureProfile ExposureProfile;
+
+	// Propellant
+	float PropellantMass;
+	float PropellantRate;
+
+	// Assembly tracking
+	uint32 AssemblyRevision;
+	bool   IsInitialized;
+};
+
+/** Spacecraft record scheduled for a simulation batch, with its game-thread lookups resolved */
+struct FNovaSpacecraftSystemBatchEntry
+{
+	struct FNovaSpacecraft*            Spacecraft;
+	FNovaSpacecraftSystemState*        State;
+	const struct FNovaOrbitalLocation* Location;
+	const struct FNovaTrajectory*      Trajectory;
+	int32                              TrajectoryIndex;
+	bool                               HasChangedCargo;
+};
+
+/** Data-oriented simulation of power, propellant and processing for spacecraft that have no player pawn */
+UCLASS(ClassGroup = (Nova))
+class UNovaSystemSimulationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UNovaSystemSimulationComponent();
+
+	/*----------------------------------------------------
+	    Interface
+	----------------------------------------------------*/
+
+	/** Update all spacecraft records that are not simulated by the pawns in PawnSpacecraft, between InitialTime and FinalTime */
+	void UpdateSimulation(
+		struct FNovaSpacecraftDatabase& Database, const TSet<FGuid>& PawnSpacecraft, FNovaTime InitialTime, FNovaTime FinalTime);
+
+	/** Get the headless state for a spacecraft, if it is simulated here */
+	const FNovaSpacecraftSystemState* GetSystemState(const FGuid& Identifier) const
+	{
+		return SystemStates.Find(Identifier);
+	}
+
+	/*----------------------------------------------------
+	    Internals
+	----------------------------------------------------*/
+
+protected:
+
+	/** Rebuild the processing groups after an assembly change, with the activity stored on the spacecraft */
+	void InitializeState(struct FNovaSpacecraft& Spacecraft, FNovaSpacecraftSystemState& State);
+
+	/*----------------------------------------------------
+	    Data
+	----------------------------------------------------*/
+
+protected:
+
+	// Headless state for each spacecraft
+	TMap<FGuid, FNovaSpacecraftSystemState> SystemStates;
+
+	// Current batch, kept to avoid allocations
+	TArray<FNovaSpacecraftSystemBatchEntry> Batch;
+};
@@ -2,11 +2,36 @@
 
 #include "Nova.h"
 #include "Game/NovaGameTypes.h"
+#include "Game/NovaSaveData.h"
+#include "Spacecraft/NovaSpacecraft.h"
 
 #include "Engine.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE(FNovaModule, AstralShipwright, "AstralShipwright");
 
+/*----------------------------------------------------
+    Game module definition
+----------------------------------------------------*/
+
+void FNovaModule::StartupModule()
+{
+	FDefaultGameModuleImpl::StartupModule();
+
+	// Complete background save writes before the engine exits
+	PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&FNovaSaveArchive::Flush);
+
+	// Index assembly candidates once the asset catalog is loaded
+	FNovaAssemblyCompatibilityIndex::Initialize();
+}
+
+void FNovaModule::ShutdownModule()
+{
+	FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+	FNovaAssemblyCompatibilityIndex::Shutdown();
+
+	FDefaultGameModuleImpl::ShutdownModule();
+}
+
 #define LOCTEXT_NAMESPACE "AstralShipwright"
 
 /*----------------------------------------------------
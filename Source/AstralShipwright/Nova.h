@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "Neutron/Neutron.h"
+#include "NovaStats.h"
 
 /*----------------------------------------------------
     Debugging tools
@@ -25,13 +26,11 @@ class FNovaModule : public FDefaultGameModuleImpl
 
 public:
 
-	void StartupModule() override
-	{
-		FDefaultGameModuleImpl::StartupModule();
-	}
+	void StartupModule() override;
 
-	void ShutdownModule() override
-	{
-		FDefaultGameModuleImpl::ShutdownModule();
-	}
+	void ShutdownModule() override;
+
+private:
+
+	FDelegateHandle PreExitHandle;
 };
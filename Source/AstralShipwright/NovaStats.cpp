@@ -0,0 +1,254 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#include "NovaStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+/*----------------------------------------------------
+    Stat definitions
+----------------------------------------------------*/
+
+DEFINE_STAT(STAT_NovaGameSimulation);
+DEFINE_STAT(STAT_NovaSpacecraftMetrics);
+DEFINE_STAT(STAT_NovaPawnSystems);
+DEFINE_STAT(STAT_NovaHeadlessSystems);
+
+DEFINE_STAT(STAT_NovaOrbitalSimulation);
+DEFINE_STAT(STAT_NovaOrbitCleanup);
+DEFINE_STAT(STAT_NovaAreas);
+DEFINE_STAT(STAT_NovaAsteroids);
+DEFINE_STAT(STAT_NovaSpacecraftOrbits);
+DEFINE_STAT(STAT_NovaSpacecraftTrajectories);
+DEFINE_STAT(STAT_NovaComputeTrajectory);
+DEFINE_STAT(STAT_NovaComputeTrajectoryCost);
+
+DEFINE_STAT(STAT_NovaAIQuotas);
+DEFINE_STAT(STAT_NovaAISpawning);
+DEFINE_STAT(STAT_NovaAINavigation);
+DEFINE_STAT(STAT_NovaAsteroidSpawning);
+
+DEFINE_STAT(STAT_NovaOrbitalMap);
+
+DEFINE_STAT(STAT_NovaOrbitCount);
+DEFINE_STAT(STAT_NovaTrajectoryCount);
+DEFINE_STAT(STAT_NovaAsteroidCount);
+DEFINE_STAT(STAT_NovaCacheRebuilds);
+DEFINE_STAT(STAT_NovaTrajectoriesComputed);
+DEFINE_STAT(STAT_NovaMetricsUpdatesPerSecond);
+
+DEFINE_STAT(STAT_NovaOrbitalLocationMemory);
+DEFINE_STAT(STAT_NovaAsteroidCatalogMemory);
+
+#if !UE_BUILD_SHIPPING
+
+/*----------------------------------------------------
+    Stage histograms
+----------------------------------------------------*/
+
+// Number of recent runs kept for each stage
+static constexpr int32 StageHistogramSampleCount = 1000;
+
+// Recording is off by default since every run takes the histogram lock, which contends in parallel stages
+static bool                    RecordStageHistograms = false;
+static FAutoConsoleVariableRef RecordStageHistogramsVariable(TEXT("Nova.RecordStageHistograms"), RecordStageHistograms,
+	TEXT("Record the duration of each profiled Nova stage for Nova.DumpStageHistograms"));
+
+// Allocation counter provided by an instrumented allocator, when allocations are counted
+static const TAtomic<int64>* StageAllocationCounter = nullptr;
+
+// Upper bounds of the histogram buckets in milliseconds, with a last bucket for longer runs
+static constexpr float StageHistogramBuckets[] = {0.01f, 0.03f, 0.1f, 0.3f, 1.0f, 3.0f, 10.0f, 30.0f};
+
+/** List of all stage histograms */
+struct FNovaStageHistogramRegistry
+{
+	static FNovaStageHistogramRegistry& Get()
+	{
+		static FNovaStageHistogramRegistry Registry;
+		return Registry;
+	}
+
+	FCriticalSection             Lock;
+	TArray<FNovaStageHistogram*> Histograms;
+};
+
+FNovaStageHistogram::FNovaStageHistogram(const TCHAR* StatName)
+	: Name(StatName), NextSample(0), RunCount(0), TotalTime(0), MaxTime(0), AllocationCount(0)
+{
+	Name.RemoveFromStart(TEXT("STAT_Nova"));
+	Samples.Reserve(StageHistogramSampleCount);
+
+	FNovaStageHistogramRegistry& Registry = FNovaStageHistogramRegistry::Get();
+	FScopeLock                   ScopeLock(&Registry.Lock);
+	Registry.Histograms.Add(this);
+}
+
+FNovaStageHistogram::~FNovaStageHistogram()
+{
+	FNovaStageHistogramRegistry& Registry = FNovaStageHistogramRegistry::Get();
+	FScopeLock                   ScopeLock(&Registry.Lock);
+	Registry.Histograms.Remove(this);
+}
+
+void FNovaStageHistogram::Add(uint64 Cycles, int64 Allocations)
+{
+	const float Milliseconds = FPlatformTime::ToMilliseconds64(Cycles);
+
+	FScopeLock ScopeLock(&Lock);
+	if (Samples.Num() < StageHistogramSampleCount)
+	{
+		Samples.Add(Milliseconds);
+	}
+	else
+	{
+		Samples[NextSample] = Milliseconds;
+	}
+	NextSample = (NextSample + 1) % StageHistogramSampleCount;
+
+	RunCount++;
+	TotalTime += Milliseconds;
+	MaxTime = FMath::Max(MaxTime, Milliseconds);
+	AllocationCount += Allocations;
+}
+
+void FNovaStageHistogram::Dump(FOutputDevice& Ar) const
+{
+	TArray<float> SortedSamples;
+	{
+		FScopeLock ScopeLock(&Lock);
+		SortedSamples = Samples;
+	}
+	if (SortedSamples.Num() == 0)
+	{
+		return;
+	}
+	SortedSamples.Sort();
+
+	// Summary
+	double Total = 0;
+	for (float Sample : SortedSamples)
+	{
+		Total += Sample;
+	}
+	auto Percentile = [&SortedSamples](float Ratio)
+	{
+		return SortedSamples[FMath::Min(FMath::FloorToInt(Ratio * SortedSamples.Num()), SortedSamples.Num() - 1)];
+	};
+	Ar.Logf(TEXT("%s : %d runs, mean %.3fms, p50 %.3fms, p90 %.3fms, p99 %.3fms, max %.3fms"), *Name, SortedSamples.Num(),
+		Total / SortedSamples.Num(), Percentile(0.5f), Percentile(0.9f), Percentile(0.99f), SortedSamples.Last());
+
+	// Buckets
+	FString BucketText;
+	int32   SampleIndex = 0;
+	for (int32 BucketIndex = 0; BucketIndex <= UE_ARRAY_COUNT(StageHistogramBuckets); BucketIndex++)
+	{
+		const bool IsLastBucket = BucketIndex == UE_ARRAY_COUNT(StageHistogramBuckets);
+		int32      Count        = 0;
+		while (SampleIndex < SortedSamples.Num() && (IsLastBucket || SortedSamples[SampleIndex] < StageHistogramBuckets[BucketIndex]))
+		{
+			Count++;
+			SampleIndex++;
+		}
+
+		if (IsLastBucket)
+		{
+			BucketText += FString::Printf(TEXT("%d >= %gms"), Count, StageHistogramBuckets[BucketIndex - 1]);
+		}
+		else
+		{
+			BucketText += FString::Printf(TEXT("%d < %gms | "), Count, StageHistogramBuckets[BucketIndex]);
+		}
+	}
+	Ar.Logf(TEXT("    %s"), *BucketText);
+}
+
+FNovaStageSummary FNovaStageHistogram::GetSummary() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return FNovaStageSummary{Name, RunCount, TotalTime, MaxTime, AllocationCount};
+}
+
+void FNovaStageHistogram::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Samples.Reset();
+	NextSample      = 0;
+	RunCount        = 0;
+	TotalTime       = 0;
+	MaxTime         = 0;
+	AllocationCount = 0;
+}
+
+void FNovaStageHistogram::GetAllSummaries(TArray<FNovaStageSummary>& Summaries)
+{
+	FNovaStageHistogramRegistry& Registry = FNovaStageHistogramRegistry::Get();
+	FScopeLock                   ScopeLock(&Registry.Lock);
+	for (const FNovaStageHistogram* Histogram : Registry.Histograms)
+	{
+		FNovaStageSummary Summary = Histogram->GetSummary();
+		if (Summary.RunCount > 0)
+		{
+			Summaries.Add(Summary);
+		}
+	}
+}
+
+bool FNovaStageHistogram::IsRecording()
+{
+	return RecordStageHistograms;
+}
+
+void FNovaStageHistogram::SetRecording(bool Enabled)
+{
+	RecordStageHistograms = Enabled;
+}
+
+void FNovaStageHistogram::SetAllocationCounter(const TAtomic<int64>* Counter)
+{
+	StageAllocationCounter = Counter;
+}
+
+int64 FNovaStageHistogram::GetAllocationCount()
+{
+	return StageAllocationCounter ? StageAllocationCounter->Load(EMemoryOrder::Relaxed) : 0;
+}
+
+void FNovaStageHistogram::ResetAll()
+{
+	FNovaStageHistogramRegistry& Registry = FNovaStageHistogramRegistry::Get();
+	FScopeLock                   ScopeLock(&Registry.Lock);
+	for (FNovaStageHistogram* Histogram : Registry.Histograms)
+	{
+		Histogram->Reset();
+	}
+}
+
+/*----------------------------------------------------
+    Console commands
+----------------------------------------------------*/
+
+static void DumpStageHistograms(FOutputDevice& Ar)
+{
+	if (!RecordStageHistograms)
+	{
+		Ar.Logf(TEXT("Stage histograms are only recorded with Nova.RecordStageHistograms 1"));
+	}
+
+	FNovaStageHistogramRegistry& Registry = FNovaStageHistogramRegistry::Get();
+	FScopeLock                   ScopeLock(&Registry.Lock);
+	for (const FNovaStageHistogram* Histogram : Registry.Histograms)
+	{
+		Histogram->Dump(Ar);
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice DumpStageHistogramsCommand(TEXT("Nova.DumpStageHistograms"),
+	TEXT("Print the distribution of the recent durations of each profiled Nova stage"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpStageHistograms));
+
+static FAutoConsoleCommand ResetStageHistogramsCommand(TEXT("Nova.ResetStageHistograms"),
+	TEXT("Discard the recorded durations of all profiled Nova stages"),
+	FConsoleCommandDelegate::CreateStatic(&FNovaStageHistogram::ResetAll));
+
+#endif    // !UE_BUILD_SHIPPING
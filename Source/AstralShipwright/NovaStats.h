@@ -0,0 +1,157 @@
+// Astral Shipwright - Gwennaël Arbona
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/*----------------------------------------------------
+    Stat group
+----------------------------------------------------*/
+
+DECLARE_STATS_GROUP(TEXT("Nova"), STATGROUP_Nova, STATCAT_Advanced);
+
+// Game simulation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Game simulation"), STAT_NovaGameSimulation, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spacecraft metrics"), STAT_NovaSpacecraftMetrics, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pawn systems"), STAT_NovaPawnSystems, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Headless systems"), STAT_NovaHeadlessSystems, STATGROUP_Nova, );
+
+// Orbital simulation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Orbital simulation"), STAT_NovaOrbitalSimulation, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Orbit cleanup"), STAT_NovaOrbitCleanup, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Areas"), STAT_NovaAreas, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asteroid orbits"), STAT_NovaAsteroids, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spacecraft orbits"), STAT_NovaSpacecraftOrbits, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spacecraft trajectories"), STAT_NovaSpacecraftTrajectories, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute trajectory"), STAT_NovaComputeTrajectory, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute trajectory cost"), STAT_NovaComputeTrajectoryCost, STATGROUP_Nova, );
+
+// AI & asteroid simulation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI quotas"), STAT_NovaAIQuotas, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI spawning"), STAT_NovaAISpawning, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI navigation"), STAT_NovaAINavigation, STATGROUP_Nova, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asteroid spawning"), STAT_NovaAsteroidSpawning, STATGROUP_Nova, );
+
+// User interface
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Orbital map"), STAT_NovaOrbitalMap, STATGROUP_Nova, );
+
+// Counts
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Orbits"), STAT_NovaOrbitCount, STATGROUP_Nova, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Trajectories"), STAT_NovaTrajectoryCount, STATGROUP_Nova, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Asteroid count"), STAT_NovaAsteroidCount, STATGROUP_Nova, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cache rebuilds per frame"), STAT_NovaCacheRebuilds, STATGROUP_Nova, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trajectories computed per frame"), STAT_NovaTrajectoriesComputed, STATGROUP_Nova, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Metrics updates per second"), STAT_NovaMetricsUpdatesPerSecond, STATGROUP_Nova, );
+
+// Memory
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Orbital locations"), STAT_NovaOrbitalLocationMemory, STATGROUP_Nova, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Asteroid catalog"), STAT_NovaAsteroidCatalogMemory, STATGROUP_Nova, );
+
+/*----------------------------------------------------
+    Stage histograms
+----------------------------------------------------*/
+
+#if !UE_BUILD_SHIPPING
+
+/** Totals of all the runs of a profiled stage since the last reset */
+struct FNovaStageSummary
+{
+	FString Name;
+	int64   RunCount;
+	double  TotalTime;
+	double  MaxTime;
+	int64   AllocationCount;
+};
+
+/** Rolling histogram of the recent durations of a profiled stage, printed by Nova.DumpStageHistograms.
+ * Recording takes a lock per run, so it only happens while enabled with Nova.RecordStageHistograms. */
+class FNovaStageHistogram
+{
+public:
+
+	FNovaStageHistogram(const TCHAR* StatName);
+
+	~FNovaStageHistogram();
+
+	/** Record one run of this stage */
+	void Add(uint64 Cycles, int64 Allocations = 0);
+
+	/** Print the distribution of recent runs */
+	void Dump(FOutputDevice& Ar) const;
+
+	/** Get the totals of all runs */
+	FNovaStageSummary GetSummary() const;
+
+	/** Discard all samples */
+	void Reset();
+
+	/** Get the totals of every stage that ran since the last reset, in milliseconds */
+	static void GetAllSummaries(TArray<FNovaStageSummary>& Summaries);
+
+	/** Discard the samples of every stage */
+	static void ResetAll();
+
+	/** Check whether runs are being recorded */
+	static bool IsRecording();
+
+	/** Start or stop recording runs */
+	static void SetRecording(bool Enabled);
+
+	/** Count the allocations made during each run from a counter incremented by the allocator, or nullptr to stop counting.
+	 * The counter covers all threads, so only stages that don't overlap other work get exact counts. */
+	static void SetAllocationCounter(const TAtomic<int64>* Counter);
+
+	/** Get the current value of the allocation counter, or zero when allocations are not counted */
+	static int64 GetAllocationCount();
+
+private:
+
+	FString                  Name;
+	mutable FCriticalSection Lock;
+	TArray<float>            Samples;
+	int32                    NextSample;
+	int64                    RunCount;
+	double                   TotalTime;
+	float                    MaxTime;
+	int64                    AllocationCount;
+};
+
+/** Record the duration of a scope into a stage histogram, when recording */
+struct FNovaScopedStageHistogram
+{
+	FNovaScopedStageHistogram(FNovaStageHistogram& H)
+		: Histogram(FNovaStageHistogram::IsRecording() ? &H : nullptr)
+		, StartCycles(Histogram ? FPlatformTime::Cycles64() : 0)
+		, StartAllocations(Histogram ? FNovaStageHistogram::GetAllocationCount() : 0)
+	{}
+
+	~FNovaScopedStageHistogram()
+	{
+		if (Histogram)
+		{
+			Histogram->Add(FPlatformTime::Cycles64() - StartCycles, FNovaStageHistogram::GetAllocationCount() - StartAllocations);
+		}
+	}
+
+	FNovaStageHistogram* Histogram;
+	uint64               StartCycles;
+	int64                StartAllocations;
+};
+
+#define NOVA_SCOPE_HISTOGRAM(Stat)                                \
+	static FNovaStageHistogram NovaHistogram_##Stat(TEXT(#Stat)); \
+	FNovaScopedStageHistogram  NovaHistogramScope_##Stat(NovaHistogram_##Stat)
+
+#else
+
+#define NOVA_SCOPE_HISTOGRAM(Stat)
+
+#endif    // !UE_BUILD_SHIPPING
+
+/** Profile a scope with a Nova cycle stat, an Unreal Insights event and a stage histogram */
+#define NOVA_SCOPE_CYCLE_COUNTER(Stat)   \
+	SCOPE_CYCLE_COUNTER(Stat);           \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	NOVA_SCOPE_HISTOGRAM(Stat)
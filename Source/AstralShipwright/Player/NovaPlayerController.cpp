@@ -128,6 +128,7 @@ void ANovaPlayerController::Load(const FNovaPlayerSave& SaveData)
 
 	// Load parts
 	UnlockedComponents = SaveData.UnlockedComponents;
+	UpdateUnlockedComponentBits();
 }
 
 void ANovaPlayerController::SaveGame()
@@ -152,9 +153,8 @@ void ANovaPlayerController::SaveGame()
 	// Save contracts
 	SaveData->ContractManagerData = UNeutronContractManager::Get()->Save();
 
-	// Write the save data to the already open slot
-	UNeutronSaveManager::Get()->SetCurrentSaveData<FNovaGameSave>(SaveData);
-	UNeutronSaveManager::Get()->WriteCurrentSaveData<FNovaGameSave>();
+	// Write the save data to the already open slot in the background
+	FNovaSaveArchive::WriteGame(SaveData);
 	Notify(LOCTEXT("SavedGame", "Game saved"), FText(), ENeutronNotificationType::Save);
 }
 
@@ -166,7 +166,7 @@ void ANovaPlayerController::LoadGame(const FString SaveName)
 	NCHECK(SaveManager);
 
 	// Load the save data from slot
-	SaveManager->LoadGame<FNovaGameSave>(SaveName);
+	FNovaSaveArchive::LoadGame(SaveName);
 	NCHECK(SaveManager->HasLoadedSaveData());
 	TSharedPtr<FNovaGameSave> SaveData = SaveManager->GetCurrentSaveData<FNovaGameSave>();
 }
@@ -852,7 +852,26 @@ bool ANovaPlayerController::IsComponentUnlockable(const UNovaTradableAssetDescri
 
 bool ANovaPlayerController::IsComponentUnlocked(const UNovaTradableAssetDescription* Asset) const
 {
-	return IsValid(Asset) && (Asset->UnlockLevel == 0 || UnlockedComponents.Contains(Asset->Identifier));
+	if (!IsValid(Asset))
+	{
+		return false;
+	}
+	else if (Asset->UnlockLevel == 0)
+	{
+		return true;
+	}
+
+	// Use the bitset unless the index was rebuilt since it was filled
+	const FNovaAssemblyCompatibilityIndex& CompatibilityIndex = FNovaAssemblyCompatibilityIndex::Get();
+	if (UnlockedComponentBits.Num() == CompatibilityIndex.GetComponentBitCount())
+	{
+		const int32 Bit = CompatibilityIndex.GetComponentBit(Asset);
+		return Bit != INDEX_NONE && UnlockedComponentBits[Bit];
+	}
+	else
+	{
+		return UnlockedComponents.Contains(Asset->Identifier);
+	}
 }
 
 FNovaCredits ANovaPlayerController::GetComponentUnlockCost(int32 Level) const
@@ -869,9 +888,26 @@ void ANovaPlayerController::UnlockComponent(const UNovaTradableAssetDescription*
 {
 	ProcessTransaction(-GetComponentUnlockCost(Asset));
 	UnlockedComponents.Add(Asset->Identifier);
+	UpdateUnlockedComponentBits();
 	SaveGame();
 }
 
+void ANovaPlayerController::UpdateUnlockedComponentBits()
+{
+	const FNovaAssemblyCompatibilityIndex& CompatibilityIndex = FNovaAssemblyCompatibilityIndex::Get();
+
+	UnlockedComponentBits.Init(false, CompatibilityIndex.GetComponentBitCount());
+	for (const FGuid& Identifier : UnlockedComponents)
+	{
+		const int32 Bit =
+			CompatibilityIndex.GetComponentBit(UNeutronAssetManager::Get()->GetAsset<UNovaTradableAssetDescription>(Identifier));
+		if (Bit != INDEX_NONE)
+		{
+			UnlockedComponentBits[Bit] = true;
+		}
+	}
+}
+
 /*----------------------------------------------------
     Menus
 ----------------------------------------------------*/
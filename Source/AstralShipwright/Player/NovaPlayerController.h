@@ -231,6 +231,11 @@ public:
 	/** Unlock a part */
 	void UnlockComponent(const class UNovaTradableAssetDescription* Asset);
 
+protected:
+
+	/** Rebuild the unlock bitset from the list of unlocked components */
+	void UpdateUnlockedComponentBits();
+
 	/*----------------------------------------------------
 	    Menus
 	----------------------------------------------------*/
@@ -269,8 +274,9 @@ private:
 	// Gameplay state
 	TMap<ENovaPostProcessPreset, TSharedPtr<FNeutronPostProcessSetting>> PostProcessSettings;
 
-	// List of component IDs for career unlocks
+	// List of component IDs for career unlocks, and the matching bits from the assembly compatibility index
 	TArray<FGuid> UnlockedComponents;
+	TBitArray<>   UnlockedComponentBits;
 
 	/*----------------------------------------------------
 	    Getters
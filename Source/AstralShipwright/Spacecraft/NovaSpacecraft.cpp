@@ -10,6 +10,7 @@
 #include "Neutron/System/NeutronAssetManager.h"
 
 #include "Dom/JsonObject.h"
+#include "Engine/AssetManager.h"
 #include "EngineUtils.h"
 
 #define LOCTEXT_NAMESPACE "NovaSpacecraft"
@@ -713,6 +714,44 @@ bool FNovaSpacecraft::HasModule(const TSubclassOf<UNovaModuleDescription> Class)
 	return false;
 }
 
+TArray<FSoftObjectPath> FNovaSpacecraft::GetAsyncAssets() const
+{
+	TArray<FSoftObjectPath> Result;
+
+	for (const FNovaCompartment& Compartment : Compartments)
+	{
+		if (Compartment.Description)
+		{
+			for (FSoftObjectPath Asset : Compartment.Description->GetAsyncAssets())
+			{
+				Result.AddUnique(Asset);
+			}
+			for (const FNovaCompartmentModule& Module : Compartment.Modules)
+			{
+				if (Module.Description)
+				{
+					for (FSoftObjectPath Asset : Module.Description->GetAsyncAssets())
+					{
+						Result.AddUnique(Asset);
+					}
+				}
+			}
+			for (const UNovaEquipmentDescription* Equipment : Compartment.Equipment)
+			{
+				if (Equipment)
+				{
+					for (FSoftObjectPath Asset : Equipment->GetAsyncAssets())
+					{
+						Result.AddUnique(Asset);
+					}
+				}
+			}
+		}
+	}
+
+	return Result;
+}
+
 /*----------------------------------------------------
     Automated spacecraft details
 ----------------------------------------------------*/
@@ -922,6 +961,22 @@ void FNovaSpacecraft::UpdatePowerMetrics()
 	}
 }
 
+bool FNovaSpacecraft::UpdateMetricsIfChanged()
+{
+	if (!HasMetrics || MetricsRevision != AssemblyRevision)
+	{
+		UpdatePropulsionMetrics();
+		UpdatePowerMetrics();
+
+		MetricsRevision = AssemblyRevision;
+		HasMetrics      = true;
+
+		return true;
+	}
+
+	return false;
+}
+
 void FNovaSpacecraft::UpdateModuleGroups()
 {
 	ModuleGroups.Empty();
@@ -1172,85 +1227,39 @@ void FNovaSpacecraft::ClearCargo()
     UI helpers
 ----------------------------------------------------*/
 
-TArray<const UNovaCompartmentDescription*> FNovaSpacecraft::GetCompatibleCompartments(int32 CompartmentIndex) const
+const TArray<const UNovaCompartmentDescription*>& FNovaSpacecraft::GetCompatibleCompartments(int32 CompartmentIndex) const
 {
-	TArray<const UNovaCompartmentDescription*> CompartmentDescriptions;
-
-	for (const UNovaCompartmentDescription* Description : UNeutronAssetManager::Get()->GetSortedAssets<UNovaCompartmentDescription>())
-	{
-		if (Description->IsForwardCompartment && (!IsFirstCompartment(CompartmentIndex) || Compartments.Num() == 0))
-		{
-			continue;
-		}
-		else
-		{
-			CompartmentDescriptions.Add(Description);
-		}
-	}
-
-	return CompartmentDescriptions;
+	return FNovaAssemblyCompatibilityIndex::Get().GetCompartments(IsFirstCompartment(CompartmentIndex) && Compartments.Num() > 0);
 }
 
-TArray<const UNovaModuleDescription*> FNovaSpacecraft::GetCompatibleModules(int32 CompartmentIndex, int32 SlotIndex) const
+const TArray<const UNovaModuleDescription*>& FNovaSpacecraft::GetCompatibleModules(int32 CompartmentIndex, int32 SlotIndex) const
 {
-	TArray<const UNovaModuleDescription*> ModuleDescriptions;
+	const FNovaAssemblyCompatibilityIndex& CompatibilityIndex = FNovaAssemblyCompatibilityIndex::Get();
 
 	if (CompartmentIndex >= 0 && CompartmentIndex < Compartments.Num())
 	{
-		TArray<const UNovaModuleDescription*> AllModuleDescriptions =
-			UNeutronAssetManager::Get()->GetSortedAssets<UNovaModuleDescription>();
 		const FNovaCompartment& Compartment = Compartments[CompartmentIndex];
-
-		ModuleDescriptions.Add(nullptr);
 		if (Compartment.IsValid() && SlotIndex < Compartment.Description->ModuleSlots.Num())
 		{
-			for (const UNovaModuleDescription* ModuleDescription : AllModuleDescriptions)
-			{
-				ModuleDescriptions.AddUnique(ModuleDescription);
-			}
+			return CompatibilityIndex.GetModules();
 		}
 	}
 
-	return ModuleDescriptions;
+	return CompatibilityIndex.GetEmptyModules();
 }
 
-TArray<const UNovaEquipmentDescription*> FNovaSpacecraft::GetCompatibleEquipment(int32 CompartmentIndex, int32 SlotIndex) const
+const TArray<const UNovaEquipmentDescription*>& FNovaSpacecraft::GetCompatibleEquipment(int32 CompartmentIndex, int32 SlotIndex) const
 {
-	TArray<const UNovaEquipmentDescription*> EquipmentDescriptions;
+	const FNovaAssemblyCompatibilityIndex& CompatibilityIndex = FNovaAssemblyCompatibilityIndex::Get();
 
 	if (CompartmentIndex >= 0 && CompartmentIndex < Compartments.Num())
 	{
-		TArray<const UNovaEquipmentDescription*> AllEquipmentDescriptions =
-			UNeutronAssetManager::Get()->GetSortedAssets<UNovaEquipmentDescription>();
-		const FNovaCompartment& Compartment = Compartments[CompartmentIndex];
-
-		EquipmentDescriptions.Add(nullptr);
-		if (Compartment.IsValid() && SlotIndex < Compartment.Description->EquipmentSlots.Num())
-		{
-			for (const UNovaEquipmentDescription* EquipmentDescription : AllEquipmentDescriptions)
-			{
-				const TArray<ENovaEquipmentType>& SupportedTypes = Compartment.Description->EquipmentSlots[SlotIndex].SupportedTypes;
-				if (SupportedTypes.Num() == 0 ||
-					(::IsValid(EquipmentDescription) && SupportedTypes.Contains(EquipmentDescription->EquipmentType)))
-				{
-					if (EquipmentDescription->EquipmentType == ENovaEquipmentType::Forward && !IsFirstCompartment(CompartmentIndex))
-					{
-						continue;
-					}
-					else if (EquipmentDescription->EquipmentType == ENovaEquipmentType::Aft && !IsLastCompartment(CompartmentIndex))
-					{
-						continue;
-					}
-					else
-					{
-						EquipmentDescriptions.AddUnique(EquipmentDescription);
-					}
-				}
-			}
-		}
+		const bool IsFirst = IsFirstCompartment(CompartmentIndex);
+		const bool IsLast  = IsLastCompartment(CompartmentIndex);
+		return CompatibilityIndex.GetEquipment(Compartments[CompartmentIndex].Description, SlotIndex, IsFirst, IsLast);
 	}
 
-	return EquipmentDescriptions;
+	return CompatibilityIndex.GetEmptyEquipment();
 }
 
 bool FNovaSpacecraft::IsFirstCompartment(int32 CompartmentIndex) const
@@ -1385,4 +1394,145 @@ FText FNovaSpacecraft::GetModuleGroupIcon(ENovaModuleGroupType Type)
 	return INVTEXT("/Text/Module");
 }
 
+/*----------------------------------------------------
+    Assembly compatibility index
+----------------------------------------------------*/
+
+TUniquePtr<FNovaAssemblyCompatibilityIndex> FNovaAssemblyCompatibilityIndex::Instance;
+
+#if WITH_EDITOR
+FDelegateHandle FNovaAssemblyCompatibilityIndex::PropertyChangedHandle;
+#endif    // WITH_EDITOR
+
+const FNovaAssemblyCompatibilityIndex& FNovaAssemblyCompatibilityIndex::Get()
+{
+	NCHECK(IsInGameThread());
+	NCHECK(Instance.IsValid());
+
+	return *Instance;
+}
+
+void FNovaAssemblyCompatibilityIndex::Initialize()
+{
+	UAssetManager::CallOrRegister_OnCompletedInitialScan(
+		FSimpleMulticastDelegate::FDelegate::CreateStatic(&FNovaAssemblyCompatibilityIndex::Rebuild));
+
+#if WITH_EDITOR
+	PropertyChangedHandle =
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&FNovaAssemblyCompatibilityIndex::OnObjectPropertyChanged);
+#endif    // WITH_EDITOR
+}
+
+void FNovaAssemblyCompatibilityIndex::Shutdown()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+#endif    // WITH_EDITOR
+
+	Instance.Reset();
+}
+
+void FNovaAssemblyCompatibilityIndex::Rebuild()
+{
+	NCHECK(IsInGameThread());
+
+	TUniquePtr<FNovaAssemblyCompatibilityIndex> NewInstance = MakeUnique<FNovaAssemblyCompatibilityIndex>();
+	NewInstance->Build();
+	Instance = MoveTemp(NewInstance);
+}
+
+#if WITH_EDITOR
+
+void FNovaAssemblyCompatibilityIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (Instance.IsValid() && IsValid(Object) && Object->IsA<UNovaTradableAssetDescription>())
+	{
+		Rebuild();
+	}
+}
+
+#endif    // WITH_EDITOR
+
+const TArray<const UNovaEquipmentDescription*>& FNovaAssemblyCompatibilityIndex::GetEquipment(
+	const UNovaCompartmentDescription* Compartment, int32 SlotIndex, bool IsFirst, bool IsLast) const
+{
+	const TArray<TStaticArray<TArray<const UNovaEquipmentDescription*>, 4>>* Slots = EquipmentBySlot.Find(Compartment);
+	if (Slots && Slots->IsValidIndex(SlotIndex))
+	{
+		return (*Slots)[SlotIndex][(IsFirst ? 1 : 0) + (IsLast ? 2 : 0)];
+	}
+	else
+	{
+		return EmptyEquipment;
+	}
+}
+
+void FNovaAssemblyCompatibilityIndex::Build()
+{
+	NLOG("FNovaAssemblyCompatibilityIndex::Build");
+
+	const UNeutronAssetManager* AssetManager = UNeutronAssetManager::Get();
+	NCHECK(AssetManager);
+
+	// Compartments
+	Compartments           = AssetManager->GetSortedAssets<UNovaCompartmentDescription>();
+	NonForwardCompartments = Compartments.FilterByPredicate(
+		[](const UNovaCompartmentDescription* Description)
+		{
+			return !Description->IsForwardCompartment;
+		});
+
+	// Modules
+	Modules.Add(nullptr);
+	Modules.Append(AssetManager->GetSortedAssets<UNovaModuleDescription>());
+	EmptyModules.Add(nullptr);
+
+	// Equipment, filtered by the slot's supported types and by the compartment position for forward and aft equipment
+	const TArray<const UNovaEquipmentDescription*> AllEquipment = AssetManager->GetSortedAssets<UNovaEquipmentDescription>();
+	EmptyEquipment.Add(nullptr);
+	for (const UNovaCompartmentDescription* Compartment : Compartments)
+	{
+		TArray<TStaticArray<TArray<const UNovaEquipmentDescription*>, 4>>& Slots = EquipmentBySlot.Add(Compartment);
+		Slots.SetNum(Compartment->EquipmentSlots.Num());
+
+		for (int32 SlotIndex = 0; SlotIndex < Compartment->EquipmentSlots.Num(); SlotIndex++)
+		{
+			const TArray<ENovaEquipmentType>& SupportedTypes = Compartment->EquipmentSlots[SlotIndex].SupportedTypes;
+
+			for (int32 Position = 0; Position < 4; Position++)
+			{
+				const bool                                IsFirst    = (Position & 1) != 0;
+				const bool                                IsLast     = (Position & 2) != 0;
+				TArray<const UNovaEquipmentDescription*>& Candidates = Slots[SlotIndex][Position];
+
+				Candidates.Add(nullptr);
+				for (const UNovaEquipmentDescription* Equipment : AllEquipment)
+				{
+					if (SupportedTypes.Num() == 0 || (::IsValid(Equipment) && SupportedTypes.Contains(Equipment->EquipmentType)))
+					{
+						if (Equipment->EquipmentType == ENovaEquipmentType::Forward && !IsFirst)
+						{
+							continue;
+						}
+						else if (Equipment->EquipmentType == ENovaEquipmentType::Aft && !IsLast)
+						{
+							continue;
+						}
+						else
+						{
+							Candidates.Add(Equipment);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Unlock bits
+	for (const UNovaTradableAssetDescription* Asset : AssetManager->GetAssets<UNovaTradableAssetDescription>())
+	{
+		ComponentBits.Add(Asset, ComponentBits.Num());
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -359,6 +359,95 @@ struct FNovaSpacecraftUpgradeCost
 	FNovaCredits TotalCost;
 };
 
+/** Assembly candidates precomputed from the asset catalog, so that listing them doesn't walk all assets */
+struct FNovaAssemblyCompatibilityIndex
+{
+	/** Get the index, which is built once the asset manager completed loading */
+	static const FNovaAssemblyCompatibilityIndex& Get();
+
+	/** Build the index when the asset manager completed loading, and rebuild it when descriptions are edited */
+	static void Initialize();
+
+	/** Stop tracking description edits */
+	static void Shutdown();
+
+	/** Get the compartments that can be added, depending on whether the new one would be the first */
+	const TArray<const class UNovaCompartmentDescription*>& GetCompartments(bool IsFirst) const
+	{
+		return IsFirst ? Compartments : NonForwardCompartments;
+	}
+
+	/** Get the modules that can be used in any module slot, starting with the empty module */
+	const TArray<const class UNovaModuleDescription*>& GetModules() const
+	{
+		return Modules;
+	}
+
+	/** Get the modules for a missing module slot, which only has the empty module */
+	const TArray<const class UNovaModuleDescription*>& GetEmptyModules() const
+	{
+		return EmptyModules;
+	}
+
+	/** Get the equipment for a missing equipment slot, which only has the empty equipment */
+	const TArray<const class UNovaEquipmentDescription*>& GetEmptyEquipment() const
+	{
+		return EmptyEquipment;
+	}
+
+	/** Get the equipment supported by a compartment slot, starting with the empty equipment */
+	const TArray<const class UNovaEquipmentDescription*>& GetEquipment(
+		const class UNovaCompartmentDescription* Compartment, int32 SlotIndex, bool IsFirst, bool IsLast) const;
+
+	/** Get the bit of a component in unlock bitsets, or INDEX_NONE */
+	int32 GetComponentBit(const class UNovaTradableAssetDescription* Asset) const
+	{
+		const int32* Bit = ComponentBits.Find(Asset);
+		return Bit ? *Bit : INDEX_NONE;
+	}
+
+	/** Get the number of bits in unlock bitsets */
+	int32 GetComponentBitCount() const
+	{
+		return ComponentBits.Num();
+	}
+
+protected:
+
+	/** Replace the index with one built from the asset manager */
+	static void Rebuild();
+
+#if WITH_EDITOR
+
+	/** Rebuild the index after a component description was edited */
+	static void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+
+#endif    // WITH_EDITOR
+
+	/** Fill the index from the asset manager */
+	void Build();
+
+	// Sorted candidates
+	TArray<const class UNovaCompartmentDescription*> Compartments;
+	TArray<const class UNovaCompartmentDescription*> NonForwardCompartments;
+	TArray<const class UNovaModuleDescription*>      Modules;
+	TArray<const class UNovaModuleDescription*>      EmptyModules;
+	TArray<const class UNovaEquipmentDescription*>   EmptyEquipment;
+
+	// Equipment for each compartment slot, for the four combinations of first and last compartment positions
+	TMap<const class UNovaCompartmentDescription*, TArray<TStaticArray<TArray<const class UNovaEquipmentDescription*>, 4>>>
+		EquipmentBySlot;
+
+	// Unlock bit for each tradable component
+	TMap<const class UNovaTradableAssetDescription*, int32> ComponentBits;
+
+	static TUniquePtr<FNovaAssemblyCompatibilityIndex> Instance;
+
+#if WITH_EDITOR
+	static FDelegateHandle PropertyChangedHandle;
+#endif    // WITH_EDITOR
+};
+
 /*----------------------------------------------------
     Spacecraft implementation
 ----------------------------------------------------*/
@@ -377,7 +466,14 @@ public:
 	    Constructor & operators
 	----------------------------------------------------*/
 
-	FNovaSpacecraft() : Identifier(0, 0, 0, 0), SpacecraftClass(nullptr), PropellantMassAtLaunch(0)
+	FNovaSpacecraft()
+		: Identifier(0, 0, 0, 0)
+		, SpacecraftClass(nullptr)
+		, PropellantMassAtLaunch(0)
+		, Revision(0)
+		, AssemblyRevision(0)
+		, MetricsRevision(0)
+		, HasMetrics(false)
 	{}
 
 	bool operator==(const FNovaSpacecraft& Other) const;
@@ -452,6 +548,9 @@ public:
 	/** Check if the ship has such module */
 	bool HasModule(const TSubclassOf<UNovaModuleDescription> Class) const;
 
+	/** Get a list of all assets to load before this spacecraft can be built */
+	TArray<FSoftObjectPath> GetAsyncAssets() const;
+
 	/*----------------------------------------------------
 	    Propulsion metrics & cargo hold
 	----------------------------------------------------*/
@@ -521,6 +620,21 @@ public:
 	/** Update the spacecraft's power metrics */
 	void UpdatePowerMetrics();
 
+	/** Update propulsion & power metrics only if the assembly was edited since the last call, return true if they were */
+	bool UpdateMetricsIfChanged();
+
+	/** Flag the compartments, modules or equipment as edited, to be called after any assembly change */
+	void MarkAssemblyChanged()
+	{
+		AssemblyRevision++;
+	}
+
+	/** Get the revision of the assembly, which changes whenever compartments, modules or equipment are edited */
+	uint32 GetAssemblyRevision() const
+	{
+		return AssemblyRevision;
+	}
+
 	/** Update module groups*/
 	void UpdateModuleGroups();
 
@@ -578,13 +692,13 @@ public:
 	----------------------------------------------------*/
 
 	/** Get a list of compartment kits that can be added at a (new) index */
-	TArray<const class UNovaCompartmentDescription*> GetCompatibleCompartments(int32 CompartmentIndex) const;
+	const TArray<const class UNovaCompartmentDescription*>& GetCompatibleCompartments(int32 CompartmentIndex) const;
 
 	/** Get a list of compatible modules that can be added at a compartment index, and a module slot index */
-	TArray<const class UNovaModuleDescription*> GetCompatibleModules(int32 CompartmentIndex, int32 SlotIndex) const;
+	const TArray<const class UNovaModuleDescription*>& GetCompatibleModules(int32 CompartmentIndex, int32 SlotIndex) const;
 
 	/** Get a list of compatible equipment that can be added at a compartment index, and an equipment slot index */
-	TArray<const class UNovaEquipmentDescription*> GetCompatibleEquipment(int32 InCompartmentIndexdex, int32 SlotIndex) const;
+	const TArray<const class UNovaEquipmentDescription*>& GetCompatibleEquipment(int32 CompartmentIndex, int32 SlotIndex) const;
 
 	/** Get the module group classification for this module */
 	static ENovaModuleGroupType GetModuleType(const UNovaModuleDescription* Module);
@@ -668,8 +782,23 @@ public:
 	UPROPERTY()
 	float PropellantMassAtLaunch;
 
+	// Module groups with active processing - serves as persistent storage
+	// The real-time value while flying is handled by the processing system
+	UPROPERTY()
+	TArray<int32> ActiveProcessingGroups;
+
+	// Revision of the database record, bumped every time it is replaced so that changes are detected without a deep comparison
+	UPROPERTY()
+	uint32 Revision;
+
+	// Revision of the assembly, bumped on every edit so that metrics are only computed again after one
+	UPROPERTY()
+	uint32 AssemblyRevision;
+
 	// Local state
 	FNovaSpacecraftPropulsionMetrics PropulsionMetrics;
 	FNovaSpacecraftPowerMetrics      PowerMetrics;
 	TArray<FNovaModuleGroup>         ModuleGroups;
+	uint32                           MetricsRevision;
+	bool                             HasMetrics;
 };
@@ -31,6 +31,11 @@ UNovaSpacecraftCompartmentComponent::UNovaSpacecraftCompartmentComponent()
 	, LocationInitialized(false)
 	, ImmediateMode(false)
 	, CurrentAnimationTime(0)
+	, LocalBounds(ForceInit)
+	, LocalCentroid(FVector::ZeroVector)
+	, LocalRadius(0)
+	, BoundsElementCount(0)
+	, BoundsDirty(true)
 {
 	// Settings
 	PrimaryComponentTick.bCanEverTick = true;
@@ -216,6 +221,8 @@ void UNovaSpacecraftCompartmentComponent::BuildCompartment(const struct FNovaCom
 		FixedStructuredMesh->AttachToComponent(GetAttachParent(), FAttachmentTransformRules(EAttachmentRule::KeepWorld, true));
 		FixedStructuredMesh->SetWorldLocation(MainStructuredMesh->GetComponentLocation());
 	}
+
+	InvalidateBounds();
 }
 
 void UNovaSpacecraftCompartmentComponent::UpdateCustomization()
@@ -564,4 +571,54 @@ FVector UNovaSpacecraftCompartmentComponent::GetElementLength(TSoftObjectPtr<UOb
 	}
 }
 
+void UNovaSpacecraftCompartmentComponent::UpdateBounds()
+{
+	if (!BoundsDirty)
+	{
+		return;
+	}
+
+	// Collect the bounds of materialized elements relative to this component, so that moving or rotating it keeps them valid
+	// Elements still fading in or out keep the cache outdated until they settle
+	const FTransform ComponentTransform = GetComponentTransform();
+	TArray<FVector>  Origins;
+	bool             IsTransitioning = false;
+
+	LocalBounds = FBox(ForceInit);
+	ProcessCompartment(FNovaCompartment(),
+		FNovaAssemblyCallback::CreateLambda(
+			[&](FNovaAssemblyElement& Element, TSoftObjectPtr<UObject> Asset, FNovaAdditionalComponent AdditionalComponent)
+			{
+				const UPrimitiveComponent* Prim = Cast<UPrimitiveComponent>(Element.Mesh);
+				if (Prim && !Element.Mesh->IsMaterialized() && !Element.Mesh->IsDematerialized())
+				{
+					IsTransitioning = true;
+				}
+				else if (Prim && Prim->IsRegistered() && Element.Mesh->IsMaterialized())
+				{
+					const FBoxSphereBounds ElementBounds =
+						Prim->CalcBounds(Prim->GetComponentTransform().GetRelativeTransform(ComponentTransform));
+
+					LocalBounds += ElementBounds.GetBox();
+					Origins.Add(ElementBounds.Origin);
+				}
+			}));
+
+	// Summarize the point cloud from element origins
+	LocalCentroid = FVector::ZeroVector;
+	for (const FVector& Point : Origins)
+	{
+		LocalCentroid += Point / Origins.Num();
+	}
+
+	LocalRadius = 0;
+	for (const FVector& Point : Origins)
+	{
+		LocalRadius = FMath::Max(static_cast<float>((Point - LocalCentroid).Size()), LocalRadius);
+	}
+
+	BoundsElementCount = Origins.Num();
+	BoundsDirty        = IsTransitioning;
+}
+
 #undef LOCTEXT_NAMESPACE
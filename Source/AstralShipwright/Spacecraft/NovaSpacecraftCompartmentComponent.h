@@ -75,6 +75,40 @@ public:
 		return Cast<UPrimitiveComponent>(MainStructure.Mesh);
 	}
 
+	/** Mark the cached bounds as outdated after an assembly, materialization or display change */
+	void InvalidateBounds()
+	{
+		BoundsDirty = true;
+	}
+
+	/** Get the box of materialized elements in compartment space, refreshing it if outdated */
+	const FBox& GetLocalBounds()
+	{
+		UpdateBounds();
+		return LocalBounds;
+	}
+
+	/** Get the centroid of materialized element origins in compartment space, refreshing it if outdated */
+	FVector GetLocalCentroid()
+	{
+		UpdateBounds();
+		return LocalCentroid;
+	}
+
+	/** Get the largest distance from the centroid to a materialized element origin, refreshing it if outdated */
+	float GetLocalRadius()
+	{
+		UpdateBounds();
+		return LocalRadius;
+	}
+
+	/** Get the number of materialized elements accounted for in the bounds, refreshing them if outdated */
+	int32 GetBoundsElementCount()
+	{
+		UpdateBounds();
+		return BoundsElementCount;
+	}
+
 	/*----------------------------------------------------
 	    Processing methods
 	----------------------------------------------------*/
@@ -149,6 +183,9 @@ protected:
 	/** Get the length along X of a given mesh asset */
 	FVector GetElementLength(TSoftObjectPtr<UObject> Asset) const;
 
+	/** Recompute the cached bounds from materialized elements if they are outdated */
+	void UpdateBounds();
+
 	/*----------------------------------------------------
 	    Properties
 	----------------------------------------------------*/
@@ -178,6 +215,13 @@ protected:
 	bool    ImmediateMode;
 	float   CurrentAnimationTime;
 
+	// Cached bounds of materialized elements, in compartment space
+	FBox    LocalBounds;
+	FVector LocalCentroid;
+	float   LocalRadius;
+	int32   BoundsElementCount;
+	bool    BoundsDirty;
+
 	// Main elements
 	FNovaAssemblyElement MainStructure{ENovaAssemblyElementType::Structure};
 	FNovaAssemblyElement FixedStructure{ENovaAssemblyElementType::Structure};
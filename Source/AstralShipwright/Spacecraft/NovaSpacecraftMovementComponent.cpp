@@ -3,12 +3,14 @@
 #include "NovaSpacecraftMovementComponent.h"
 #include "NovaSpacecraftHatchComponent.h"
 #include "NovaSpacecraftPawn.h"
+#include "NovaSpacecraftThrusterComponent.h"
 
 #include "Game/NovaAsteroid.h"
 #include "Game/NovaGameMode.h"
 #include "Game/NovaGameState.h"
 #include "Game/NovaPlayerStart.h"
 #include "Game/NovaOrbitalSimulationComponent.h"
+#include "Game/Station/NovaStationRingComponent.h"
 
 #include "Player/NovaPlayerController.h"
 #include "Nova.h"
@@ -20,6 +22,9 @@
 #include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
+#include "DrawDebugHelpers.h"
+
+#define SHOW_THRUSTER_TRACES 0
 
 #define LOCTEXT_NAMESPACE "UNovaSpacecraftMovementComponent"
 
@@ -43,7 +48,11 @@ UNovaSpacecraftMovementComponent::UNovaSpacecraftMovementComponent()
 	, PreviousAngularVelocity(FVector::ZeroVector)
 	, MeasuredAcceleration(FVector::ZeroVector)
 	, MeasuredAngularAcceleration(FVector::ZeroVector)
+
+	, DockGeometryMoved(false)
 {
+	ThrusterTraceDelegate.BindUObject(this, &UNovaSpacecraftMovementComponent::OnThrusterTraceCompleted);
+
 	// Angular defaults
 	LinearDeadDistance    = 0.5;
 	MaxLinearVelocity     = 40;
@@ -115,6 +124,10 @@ void UNovaSpacecraftMovementComponent::TickComponent(float DeltaTime, ELevelTick
 	ProcessAngularAttitude(DeltaTime);
 	ProcessMeasurementsAfterAttitude(DeltaTime);
 	ProcessMovement(DeltaTime);
+
+	// Run thruster occlusion
+	ProcessDockGeometry();
+	ProcessThrusterTraces();
 }
 
 void UNovaSpacecraftMovementComponent::Initialize(const ANovaPlayerStart* Start)
@@ -273,6 +286,11 @@ void UNovaSpacecraftMovementComponent::ExitAnchor(FSimpleDelegate Callback)
 	RequestMovement(FNovaMovementCommand(ENovaMovementState::ExitingAnchor));
 }
 
+void UNovaSpacecraftMovementComponent::RequestThrusterTraces(UNovaSpacecraftThrusterComponent* Thruster)
+{
+	ThrusterTraceRequests.AddUnique(Thruster);
+}
+
 /*----------------------------------------------------
     High level movement
 ----------------------------------------------------*/
@@ -840,6 +858,97 @@ void UNovaSpacecraftMovementComponent::ProcessOrbitalMovement(float DeltaTime)
 	CurrentOrbitalLocation  = RelativeOrbitalLocation;
 }
 
+void UNovaSpacecraftMovementComponent::ProcessDockGeometry()
+{
+	DockGeometryMoved = false;
+
+	// Station rings move around the docked spacecraft while it stays in place
+	const AActor* Station = nullptr;
+	if (IsValid(DockState.Actor) && (IsDocked() || IsDockingUndocking()))
+	{
+		Station = DockState.Actor->GetAttachParentActor();
+	}
+
+	if (IsValid(Station))
+	{
+		TInlineComponentArray<UNovaStationRingComponent*> Rings(Station);
+		if (DockGeometryTransforms.Num() != Rings.Num())
+		{
+			DockGeometryTransforms.SetNum(Rings.Num());
+			DockGeometryMoved = true;
+		}
+
+		for (int32 RingIndex = 0; RingIndex < Rings.Num(); RingIndex++)
+		{
+			const FTransform RingTransform = Rings[RingIndex]->GetComponentTransform();
+			if (!RingTransform.Equals(DockGeometryTransforms[RingIndex]))
+			{
+				DockGeometryTransforms[RingIndex] = RingTransform;
+				DockGeometryMoved                 = true;
+			}
+		}
+	}
+	else
+	{
+		DockGeometryTransforms.Reset();
+	}
+}
+
+void UNovaSpacecraftMovementComponent::ProcessThrusterTraces()
+{
+	if (ThrusterTraceRequests.Num() == 0)
+	{
+		return;
+	}
+
+	// Results from the previous batch were delivered at the start of this frame, replace it
+	ThrusterTraces.Reset();
+	for (const TWeakObjectPtr<UNovaSpacecraftThrusterComponent>& Thruster : ThrusterTraceRequests)
+	{
+		if (!Thruster.IsValid())
+		{
+			continue;
+		}
+
+		for (int32 ExhaustIndex = 0; ExhaustIndex < Thruster->GetExhaustCount(); ExhaustIndex++)
+		{
+			FVector Start, End;
+			Thruster->GetExhaustTrace(ExhaustIndex, Start, End);
+
+			FNovaThrusterTrace Trace;
+			Trace.Thruster     = Thruster;
+			Trace.ExhaustIndex = ExhaustIndex;
+			Trace.Handle       = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End,
+				ECollisionChannel::ECC_WorldDynamic, Thruster->GetExhaustTraceParams(), FCollisionResponseParams::DefaultResponseParam,
+				&ThrusterTraceDelegate, ThrusterTraces.Num());
+			ThrusterTraces.Add(Trace);
+
+#if SHOW_THRUSTER_TRACES
+			DrawDebugLine(GetWorld(), Start, End, Thruster->IsExhaustOccluded(ExhaustIndex) ? FColor::Red : FColor::Green, false);
+#endif
+		}
+	}
+
+	ThrusterTraceRequests.Reset();
+}
+
+void UNovaSpacecraftMovementComponent::OnThrusterTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	// Ignore results from traces that were replaced since
+	const int32 Index = Datum.UserData;
+	if (!ThrusterTraces.IsValidIndex(Index) || ThrusterTraces[Index].Handle != Handle)
+	{
+		return;
+	}
+
+	FNovaThrusterTrace& Trace = ThrusterTraces[Index];
+	Trace.Handle              = FTraceHandle();
+	if (Trace.Thruster.IsValid())
+	{
+		Trace.Thruster->SetExhaustOccluded(Trace.ExhaustIndex, FHitResult::GetFirstBlockingHit(Datum.OutHits) != nullptr);
+	}
+}
+
 void UNovaSpacecraftMovementComponent::OnHit(const FHitResult& Hit, const FVector& HitVelocity)
 {}
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/MovementComponent.h"
+#include "WorldCollision.h"
 #include "Game/NovaGameTypes.h"
 #include "NovaSpacecraftMovementComponent.generated.h"
 
@@ -89,6 +90,14 @@ struct FNovaAttitudeCommand
 	float Roll;
 };
 
+/** Exhaust occlusion trace issued on behalf of a thruster */
+struct FNovaThrusterTrace
+{
+	TWeakObjectPtr<class UNovaSpacecraftThrusterComponent> Thruster;
+	int32                                                  ExhaustIndex;
+	FTraceHandle                                           Handle;
+};
+
 /** Spacecraft movement component */
 UCLASS(ClassGroup = (Nova))
 class UNovaSpacecraftMovementComponent : public UMovementComponent
@@ -195,6 +204,15 @@ public:
 	/** Release the anchor and go back to orbit */
 	void ExitAnchor(FSimpleDelegate Callback = FSimpleDelegate());
 
+	/** Request occlusion traces for the exhausts of a thruster, issued with the rest of the spacecraft on the next update */
+	void RequestThrusterTraces(class UNovaSpacecraftThrusterComponent* Thruster);
+
+	/** Check if the station geometry around the dock moved during this update */
+	bool HasDockGeometryMoved() const
+	{
+		return DockGeometryMoved;
+	}
+
 	/*----------------------------------------------------
 	    High level movement
 	----------------------------------------------------*/
@@ -253,6 +271,15 @@ protected:
 	/** Process trajectory movement */
 	void ProcessOrbitalMovement(float DeltaTime);
 
+	/** Detect station geometry moving around the spacecraft while it's at the dock */
+	void ProcessDockGeometry();
+
+	/** Issue all thruster occlusion traces requested since the previous update */
+	void ProcessThrusterTraces();
+
+	/** Process the result of a thruster occlusion trace */
+	void OnThrusterTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
 	/** Apply hit effects */
 	virtual void OnHit(const FHitResult& Hit, const FVector& HitVelocity);
 
@@ -374,6 +401,15 @@ protected:
 	FVector MeasuredAcceleration;
 	FVector MeasuredAngularAcceleration;
 
+	// Dock geometry
+	TArray<FTransform> DockGeometryTransforms;
+	bool               DockGeometryMoved;
+
+	// Thruster occlusion traces
+	TArray<TWeakObjectPtr<class UNovaSpacecraftThrusterComponent>> ThrusterTraceRequests;
+	TArray<FNovaThrusterTrace>                                      ThrusterTraces;
+	FTraceDelegate                                                  ThrusterTraceDelegate;
+
 	/*----------------------------------------------------
 	    Getters
 	----------------------------------------------------*/
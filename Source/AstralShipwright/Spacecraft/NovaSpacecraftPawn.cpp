@@ -32,6 +32,8 @@
 
 ANovaSpacecraftPawn::ANovaSpacecraftPawn()
 	: Super()
+	, IsRegistered(false)
+	, LoadedSpacecraftRevision(0)
 	, AssemblyState(ENovaAssemblyState::Idle)
 	, SelfDestruct(false)
 	, EditingSpacecraft(false)
@@ -40,6 +42,7 @@ ANovaSpacecraftPawn::ANovaSpacecraftPawn()
 
 	, HoveredCompartment(ENeutronUIConstants::FadeDurationMinimal)
 	, SelectedCompartment(ENeutronUIConstants::FadeDurationMinimal)
+	, HighlightSignature(0)
 
 	, DisplayFilterType(ENovaAssemblyDisplayFilter::All)
 	, DisplayFilterIndex(INDEX_NONE)
@@ -76,20 +79,42 @@ ANovaSpacecraftPawn::ANovaSpacecraftPawn()
 void ANovaSpacecraftPawn::BeginPlay()
 {
 	Super::BeginPlay();
+
+	UpdateRegistration();
+}
+
+void ANovaSpacecraftPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
+	if (IsRegistered && IsValid(GameState))
+	{
+		GameState->UnregisterSpacecraftPawn(this, RegisteredSpacecraftIdentifier);
+	}
+	IsRegistered = false;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANovaSpacecraftPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Keep the game state registry up-to-date with replicated identifier changes, once the game state has replicated
+	if ((!IsRegistered || RegisteredSpacecraftIdentifier != RequestedSpacecraftIdentifier) &&
+		IsValid(GetWorld()->GetGameState<ANovaGameState>()))
+	{
+		UpdateRegistration();
+	}
+
 	// Update visual effects
 	HoveredCompartment.Update(DeltaTime);
 	SelectedCompartment.Update(DeltaTime);
 
-	// Assembly sequence
+	// Assembly sequence, after which highlights need to be set again on the new meshes
 	if (AssemblyState != ENovaAssemblyState::Idle)
 	{
 		UpdateAssembly();
+		HighlightSignature = 0;
 	}
 
 	// Idle processing
@@ -108,15 +133,21 @@ void ANovaSpacecraftPawn::Tick(float DeltaTime)
 
 			if (IsValid(GameState))
 			{
-				// Creating or updating spacecraft
+				// Creating or updating spacecraft, only comparing contents when the record was replaced
 				if (RequestedSpacecraftIdentifier.IsValid())
 				{
 					const FNovaSpacecraft* NewSpacecraft = GameState->GetSpacecraft(RequestedSpacecraftIdentifier);
-					if (NewSpacecraft && (!Spacecraft.IsValid() || *NewSpacecraft != *Spacecraft.Get()))
+					if (NewSpacecraft && (!Spacecraft.IsValid() || NewSpacecraft->Identifier != Spacecraft->Identifier ||
+											 NewSpacecraft->Revision != LoadedSpacecraftRevision))
 					{
-						NLOG("ANovaSpacecraftPawn::Tick : updating spacecraft");
-						SetSpacecraft(NewSpacecraft);
-						SelfDestruct = false;
+						LoadedSpacecraftRevision = NewSpacecraft->Revision;
+
+						if (!Spacecraft.IsValid() || *NewSpacecraft != *Spacecraft.Get())
+						{
+							NLOG("ANovaSpacecraftPawn::Tick : updating spacecraft");
+							SetSpacecraft(NewSpacecraft);
+							SelfDestruct = false;
+						}
 					}
 				}
 
@@ -131,23 +162,33 @@ void ANovaSpacecraftPawn::Tick(float DeltaTime)
 			}
 		}
 
-		// Update selection
-		for (int32 CompartmentIndex = 0; CompartmentIndex < CompartmentComponents.Num(); CompartmentIndex++)
+		// Update selection when the hovered or selected compartment, their fade or the highlight color changed
+		const FLinearColor HighlightColor = UNeutronMenuManager::Get()->GetHighlightColor();
+		uint32             NewHighlightSignature =
+			HashCombine(HashCombine(GetTypeHash(HoveredCompartment.GetCurrent()), GetTypeHash(HoveredCompartment.GetAlpha())),
+				HashCombine(GetTypeHash(SelectedCompartment.GetCurrent()), GetTypeHash(SelectedCompartment.GetAlpha())));
+		NewHighlightSignature = HashCombine(NewHighlightSignature, GetTypeHash(HighlightColor)) | 1;
+		if (NewHighlightSignature != HighlightSignature)
 		{
-			ProcessCompartment(CompartmentComponents[CompartmentIndex], FNovaCompartment(),
-				FNovaAssemblyCallback::CreateLambda(
-					[&](FNovaAssemblyElement& Element, TSoftObjectPtr<UObject> Asset, FNovaAdditionalComponent AdditionalComponent)
-					{
-						if (Element.Mesh)
+			for (int32 CompartmentIndex = 0; CompartmentIndex < CompartmentComponents.Num(); CompartmentIndex++)
+			{
+				ProcessCompartment(CompartmentComponents[CompartmentIndex], FNovaCompartment(),
+					FNovaAssemblyCallback::CreateLambda(
+						[&](FNovaAssemblyElement& Element, TSoftObjectPtr<UObject> Asset, FNovaAdditionalComponent AdditionalComponent)
 						{
-							int32 HoveredValue  = CompartmentIndex == HoveredCompartment.GetCurrent() ? 1 : 0;
-							int32 SelectedValue = CompartmentIndex == SelectedCompartment.GetCurrent() ? 1 : 0;
+							if (Element.Mesh)
+							{
+								int32 HoveredValue  = CompartmentIndex == HoveredCompartment.GetCurrent() ? 1 : 0;
+								int32 SelectedValue = CompartmentIndex == SelectedCompartment.GetCurrent() ? 1 : 0;
 
-							Element.Mesh->RequestParameter("OutlineAlpha", HoveredValue * HoveredCompartment.GetAlpha(), true);
-							Element.Mesh->RequestParameter("HighlightAlpha", SelectedValue * SelectedCompartment.GetAlpha(), true);
-							Element.Mesh->RequestParameter("HighlightColor", UNeutronMenuManager::Get()->GetHighlightColor(), true);
-						}
-					}));
+								Element.Mesh->RequestParameter("OutlineAlpha", HoveredValue * HoveredCompartment.GetAlpha(), true);
+								Element.Mesh->RequestParameter("HighlightAlpha", SelectedValue * SelectedCompartment.GetAlpha(), true);
+								Element.Mesh->RequestParameter("HighlightColor", HighlightColor, true);
+							}
+						}));
+			}
+
+			HighlightSignature = NewHighlightSignature;
 		}
 
 		UpdateBounds();
@@ -313,14 +354,11 @@ TArray<const class UNovaCompartmentDescription*> ANovaSpacecraftPawn::GetCompati
 	NCHECK(Spacecraft.IsValid());
 	if (Spacecraft.IsValid())
 	{
-		TArray<const class UNovaCompartmentDescription*> Compartments = Spacecraft->GetCompatibleCompartments(CompartmentIndex);
-
-		Compartments = Compartments.FilterByPredicate(
+		return Spacecraft->GetCompatibleCompartments(CompartmentIndex).FilterByPredicate(
 			[PC](const UNovaCompartmentDescription* Module)
 			{
 				return PC->IsComponentUnlocked(Module);
 			});
-		return Compartments;
 	}
 	else
 	{
@@ -334,14 +372,11 @@ TArray<const class UNovaModuleDescription*> ANovaSpacecraftPawn::GetCompatibleMo
 	NCHECK(Spacecraft.IsValid());
 	if (Spacecraft.IsValid())
 	{
-		TArray<const class UNovaModuleDescription*> Modules = Spacecraft->GetCompatibleModules(CompartmentIndex, SlotIndex);
-
-		Modules = Modules.FilterByPredicate(
+		return Spacecraft->GetCompatibleModules(CompartmentIndex, SlotIndex).FilterByPredicate(
 			[PC](const UNovaModuleDescription* Module)
 			{
 				return Module == nullptr || PC->IsComponentUnlocked(Module);
 			});
-		return Modules;
 	}
 	else
 	{
@@ -355,14 +390,11 @@ TArray<const class UNovaEquipmentDescription*> ANovaSpacecraftPawn::GetCompatibl
 	NCHECK(Spacecraft.IsValid());
 	if (Spacecraft.IsValid())
 	{
-		TArray<const class UNovaEquipmentDescription*> Equipment = Spacecraft->GetCompatibleEquipment(CompartmentIndex, SlotIndex);
-
-		Equipment = Equipment.FilterByPredicate(
+		return Spacecraft->GetCompatibleEquipment(CompartmentIndex, SlotIndex).FilterByPredicate(
 			[PC](const UNovaEquipmentDescription* Equipment)
 			{
 				return Equipment == nullptr || PC->IsComponentUnlocked(Equipment);
 			});
-		return Equipment;
 	}
 	else
 	{
@@ -575,6 +607,17 @@ void ANovaSpacecraftPawn::SetDisplayFilter(ENovaAssemblyDisplayFilter Filter, in
     Compartment assembly internals
 ----------------------------------------------------*/
 
+void ANovaSpacecraftPawn::UpdateRegistration()
+{
+	ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
+	if (IsValid(GameState))
+	{
+		GameState->RegisterSpacecraftPawn(this, IsRegistered ? RegisteredSpacecraftIdentifier : FGuid());
+		RegisteredSpacecraftIdentifier = RequestedSpacecraftIdentifier;
+		IsRegistered                   = true;
+	}
+}
+
 void ANovaSpacecraftPawn::SetSpacecraft(const FNovaSpacecraft* NewSpacecraft)
 {
 	if (AssemblyState == ENovaAssemblyState::Idle)
@@ -625,36 +668,7 @@ void ANovaSpacecraftPawn::StartAssemblyUpdate()
 
 	// Find new assets to load
 	NCHECK(RequestedAssets.Num() == 0);
-	for (const FNovaCompartment& Compartment : Spacecraft->Compartments)
-	{
-		if (Compartment.Description)
-		{
-			for (FSoftObjectPath Asset : Compartment.Description->GetAsyncAssets())
-			{
-				RequestedAssets.AddUnique(Asset);
-			}
-			for (const FNovaCompartmentModule& Module : Compartment.Modules)
-			{
-				if (Module.Description)
-				{
-					for (FSoftObjectPath Asset : Module.Description->GetAsyncAssets())
-					{
-						RequestedAssets.AddUnique(Asset);
-					}
-				}
-			}
-			for (const UNovaEquipmentDescription* Equipment : Compartment.Equipment)
-			{
-				if (Equipment)
-				{
-					for (FSoftObjectPath Asset : Equipment->GetAsyncAssets())
-					{
-						RequestedAssets.AddUnique(Asset);
-					}
-				}
-			}
-		}
-	}
+	RequestedAssets = Spacecraft->GetAsyncAssets();
 
 	// Request loading of new assets
 	if (RequestedAssets.Num())
@@ -764,6 +778,8 @@ void ANovaSpacecraftPawn::UpdateDisplayFilter()
 {
 	for (int32 CompartmentIndex = 0; CompartmentIndex < Spacecraft->Compartments.Num(); CompartmentIndex++)
 	{
+		CompartmentComponents[CompartmentIndex]->InvalidateBounds();
+
 		ProcessCompartment(CompartmentComponents[CompartmentIndex], FNovaCompartment(),
 			FNovaAssemblyCallback::CreateLambda(
 				[&](FNovaAssemblyElement& Element, TSoftObjectPtr<UObject> Asset, FNovaAdditionalComponent AdditionalComponent)
@@ -865,45 +881,53 @@ void ANovaSpacecraftPawn::UpdateBounds()
 	if (DisplayFilterIndex != INDEX_NONE || IsDocked())
 	{
 		FBox Bounds(ForceInit);
-		ForEachComponent<UPrimitiveComponent>(false,
-			[&](const UPrimitiveComponent* Prim)
+		for (int32 CompartmentIndex = 0; CompartmentIndex < CompartmentComponents.Num(); CompartmentIndex++)
+		{
+			UNovaSpacecraftCompartmentComponent* CompartmentComponent = CompartmentComponents[CompartmentIndex];
+			if (IsDocked() || CompartmentIndex == DisplayFilterIndex)
 			{
-				if (Prim->IsRegistered() && (IsDocked() || Prim->IsAttachedTo(CompartmentComponents[DisplayFilterIndex])) &&
-					Prim->Implements<UNeutronMeshInterface>() && Cast<INeutronMeshInterface>(Prim)->IsMaterialized())
+				const FBox& LocalBounds = CompartmentComponent->GetLocalBounds();
+				if (LocalBounds.IsValid)
 				{
-					Bounds += Prim->Bounds.GetBox();
+					Bounds += LocalBounds.TransformBy(CompartmentComponent->GetComponentTransform());
 				}
-			});
+			}
+		}
 		Bounds.GetCenterAndExtents(CurrentOrigin, CurrentExtent);
 	}
 
-	// In other cases, use a point cloud from component origins because we rotate, and the size doesn't change much
+	// In other cases, use a point cloud from element origins because we rotate, and the size doesn't change much
+	// Each compartment summarizes its own points as a sphere, so only compartments are visited here
 	else
 	{
-		CurrentOrigin = FVector::ZeroVector;
-
-		TArray<FVector> Origins;
-		ForEachComponent<UPrimitiveComponent>(false,
-			[&](const UPrimitiveComponent* Prim)
-			{
-				if (Prim->IsRegistered() && Prim->Implements<UNeutronMeshInterface>() &&
-					Cast<INeutronMeshInterface>(Prim)->IsMaterialized())
-				{
-					Origins.Add(Prim->Bounds.Origin);
-				}
-			});
+		int32 ElementCount = 0;
+		for (UNovaSpacecraftCompartmentComponent* CompartmentComponent : CompartmentComponents)
+		{
+			ElementCount += CompartmentComponent->GetBoundsElementCount();
+		}
 
 		FVector Origin = FVector::ZeroVector;
-		for (const FVector& Point : Origins)
+		for (UNovaSpacecraftCompartmentComponent* CompartmentComponent : CompartmentComponents)
 		{
-			Origin += Point / Origins.Num();
+			const int32 Count = CompartmentComponent->GetBoundsElementCount();
+			if (Count > 0)
+			{
+				const FVector Centroid = CompartmentComponent->GetComponentTransform().TransformPosition(
+					CompartmentComponent->GetLocalCentroid());
+				Origin += Centroid * Count / ElementCount;
+			}
 		}
 
 		float Radius = 0;
-		for (const FVector& Point : Origins)
+		for (UNovaSpacecraftCompartmentComponent* CompartmentComponent : CompartmentComponents)
 		{
-			float Distance = (Point - Origin).Size();
-			Radius         = FMath::Max(Distance, Radius);
+			if (CompartmentComponent->GetBoundsElementCount() > 0)
+			{
+				const FVector Centroid = CompartmentComponent->GetComponentTransform().TransformPosition(
+					CompartmentComponent->GetLocalCentroid());
+				float Distance = (Centroid - Origin).Size() + CompartmentComponent->GetLocalRadius();
+				Radius         = FMath::Max(Distance, Radius);
+			}
 		}
 
 		CurrentExtent = Radius * FVector(1, 1, 1);
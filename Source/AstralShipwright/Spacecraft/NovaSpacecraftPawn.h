@@ -98,6 +98,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 	virtual void PossessedBy(AController* NewController) override;
@@ -113,6 +115,9 @@ public:
 		if (Editing != EditingSpacecraft)
 		{
 			NLOG("ANovaSpacecraftPawn::SetEditing %d", Editing);
+
+			// Compare against the game state again once editing ends, since the local copy may have diverged
+			LoadedSpacecraftRevision = 0;
 		}
 		EditingSpacecraft = Editing;
 	}
@@ -262,9 +267,10 @@ public:
 	/** Swap equipment */
 	bool SwapEquipment(int32 CompartmentIndex, int32 IndexA, int32 IndexB);
 
-	/** Request updating of the assembly */
+	/** Request updating of the assembly after an edit */
 	void RequestAssemblyUpdate()
 	{
+		Spacecraft->MarkAssemblyChanged();
 		StartAssemblyUpdate();
 	}
 
@@ -344,6 +350,9 @@ public:
 
 protected:
 
+	/** Register this pawn to the game state under the current spacecraft identifier */
+	void UpdateRegistration();
+
 	/** Store a copy of a spacecraft and start editing it */
 	void SetSpacecraft(const FNovaSpacecraft* NewSpacecraft);
 
@@ -412,8 +421,13 @@ protected:
 	UPROPERTY(Replicated)
 	FGuid RequestedSpacecraftIdentifier;
 
+	// Game state registration
+	FGuid RegisteredSpacecraftIdentifier;
+	bool  IsRegistered;
+
 	// Assembly data
 	TSharedPtr<FNovaSpacecraft>                        Spacecraft;
+	uint32                                             LoadedSpacecraftRevision;
 	ENovaAssemblyState                                 AssemblyState;
 	TArray<class UNovaSpacecraftCompartmentComponent*> CompartmentComponents;
 	bool                                               SelfDestruct;
@@ -427,6 +441,7 @@ protected:
 	// Outlining
 	FNovaSpacecraftPawnCompartmentIndex HoveredCompartment;
 	FNovaSpacecraftPawnCompartmentIndex SelectedCompartment;
+	uint32                              HighlightSignature;
 
 	// Display state
 	ENovaAssemblyDisplayFilter DisplayFilterType;
@@ -2,7 +2,6 @@
 #include "NovaSpacecraftSolarPanelComponent.h"
 
 #include "Game/NovaGameState.h"
-#include "Game/NovaPlanetarium.h"
 #include "Nova.h"
 
 #include "Neutron/Actor/NeutronMeshInterface.h"
@@ -49,15 +48,14 @@ void UNovaSpacecraftSolarPanelComponent::TickComponent(
 	USceneComponent* ParentMesh = GetAttachParent();
 	NCHECK(ParentMesh);
 
-	// Get the planetarium
-	TArray<AActor*> PlanetariumCandidates;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ANovaPlanetarium::StaticClass(), PlanetariumCandidates);
-	NCHECK(PlanetariumCandidates.Num() > 0);
-	const ANovaPlanetarium* Planetarium = Cast<ANovaPlanetarium>(PlanetariumCandidates[0]);
+	// Get the sun direction published by the planetarium
+	const ANovaGameState* GameState = GetWorld()->GetGameState<ANovaGameState>();
+	NCHECK(GameState);
+	const FVector SunDirection = GameState->GetSunDirection();
 
 	// Determine if the time has changed a lot since last tick
 	bool            RequiresInitialOrientation = false;
-	const FNovaTime CurrentGameTime            = Cast<ANovaGameState>(GetWorld()->GetGameState())->GetCurrentTime();
+	const FNovaTime CurrentGameTime            = GameState->GetCurrentTime();
 	if ((CurrentGameTime - LastUpdateGameTime).AsMinutes() > 1)
 	{
 		RequiresInitialOrientation = true;
@@ -65,7 +63,7 @@ void UNovaSpacecraftSolarPanelComponent::TickComponent(
 	LastUpdateGameTime = CurrentGameTime;
 
 	// Update
-	if (ParentMesh && Planetarium)
+	if (ParentMesh && !SunDirection.IsZero())
 	{
 		// Rotation axis
 		FRotator Axis;
@@ -83,7 +81,6 @@ void UNovaSpacecraftSolarPanelComponent::TickComponent(
 		}
 
 		// Get the local sun direction
-		const FVector SunDirection            = Planetarium->GetSunDirection();
 		const FVector LocalSunDirection       = ParentMesh->GetComponentToWorld().GetRotation().Inverse().RotateVector(SunDirection);
 		FVector       LocalPlanarSunDirection = LocalSunDirection;
 		if (RotationMode == ERotationMode::Pitch)
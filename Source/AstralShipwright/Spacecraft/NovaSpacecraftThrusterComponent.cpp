@@ -7,15 +7,13 @@
 #include "Neutron/Actor/NeutronMeshInterface.h"
 
 #include "Materials/MaterialInstanceDynamic.h"
-#include "DrawDebugHelpers.h"
-
-#define SHOW_TRACES 0
 
 /*----------------------------------------------------
     Constructor
 ----------------------------------------------------*/
 
-UNovaSpacecraftThrusterComponent::UNovaSpacecraftThrusterComponent() : Super()
+UNovaSpacecraftThrusterComponent::UNovaSpacecraftThrusterComponent()
+	: Super(), ExhaustMesh(nullptr), MovementComponent(nullptr), HasThrusterTraces(false)
 {
 	// Settings
 	SetAbsolute(false, false, true);
@@ -41,6 +39,10 @@ void UNovaSpacecraftThrusterComponent::BeginPlay()
 	INeutronMeshInterface*    ParentMesh = Cast<INeutronMeshInterface>(GetAttachParent());
 	NCHECK(ParentMesh);
 
+	MovementComponent = GetOwner()->FindComponentByClass<UNovaSpacecraftMovementComponent>();
+	NCHECK(MovementComponent);
+	AddTickPrerequisiteComponent(MovementComponent);
+
 	ThrusterTraceParams.bTraceComplex = true;
 	ThrusterTraceParams.AddIgnoredComponent(Cast<UPrimitiveComponent>(ParentMesh));
 
@@ -55,7 +57,8 @@ void UNovaSpacecraftThrusterComponent::BeginPlay()
 		{
 			// Create exhaust structure
 			FNovaThrusterExhaust Exhaust;
-			Exhaust.Name = FName(*SocketName);
+			Exhaust.Name            = FName(*SocketName);
+			Exhaust.SocketTransform = Cast<UPrimitiveComponent>(ParentMesh)->GetSocketTransform(Exhaust.Name, RTS_Component);
 			Exhaust.Power.SetPeriod(0.4f);
 
 			// Create mesh
@@ -92,68 +95,57 @@ void UNovaSpacecraftThrusterComponent::TickComponent(float DeltaTime, ELevelTick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// Get data
-	UNovaSpacecraftMovementComponent* MovementComponent = GetOwner()->FindComponentByClass<UNovaSpacecraftMovementComponent>();
-	NCHECK(MovementComponent);
-
-	if (MovementComponent && IsValid(GetAttachParent()))
+	if (IsValid(MovementComponent) && IsValid(GetAttachParent()))
 	{
 		INeutronMeshInterface* ParentMesh = Cast<INeutronMeshInterface>(GetAttachParent());
 		NCHECK(ParentMesh);
 
 		// Initialize thrust data
-		FHitResult HitResult;
-		FVector    LinearAcceleration  = MovementComponent->GetThrusterAcceleration();
-		FVector    AngularAcceleration = MovementComponent->GetThrusterAngularAcceleration();
+		const FTransform ParentTransform     = GetAttachParent()->GetComponentTransform();
+		FVector          LinearAcceleration  = MovementComponent->GetThrusterAcceleration();
+		FVector          AngularAcceleration = MovementComponent->GetThrusterAngularAcceleration();
+		bool             IsThrusting         = !LinearAcceleration.IsNearlyZero() || !AngularAcceleration.IsNearlyZero();
+
+		// Refresh occlusion while thrusting, once the ship or the station geometry around it moved since the previous traces
+		if (IsThrusting && !ParentMesh->IsDematerializing() &&
+			(!HasThrusterTraces || !ParentTransform.Equals(ThrusterTraceTransform) || MovementComponent->HasDockGeometryMoved()))
+		{
+			MovementComponent->RequestThrusterTraces(this);
+
+			ThrusterTraceTransform = ParentTransform;
+			HasThrusterTraces      = true;
+		}
 
 		// Update all exhaust effects
 		for (FNovaThrusterExhaust& Exhaust : ThrusterExhausts)
 		{
 			float EngineIntensity = 0.0f;
 
-			if (ParentMesh->IsDematerializing())
+			if (ParentMesh->IsDematerializing() || !IsThrusting || Exhaust.IsOccluded)
 			{
 				EngineIntensity = 0.0f;
 			}
+
+			// Proceed with intensity calculation
 			else
 			{
 				// Get transform data
-				FVector  SocketLocation;
-				FRotator SocketRotation;
-				Cast<UPrimitiveComponent>(ParentMesh)->GetSocketWorldLocationAndRotation(Exhaust.Name, SocketLocation, SocketRotation);
-				FVector EngineDirection = SocketRotation.RotateVector(FVector(1.0f, 0, 0));
-				FVector EngineOffset    = (SocketLocation - GetOwner()->GetActorLocation()) / 100;
-
-				// Did we collide ?
-				if (GetWorld()->LineTraceSingleByChannel(HitResult, SocketLocation, SocketLocation + EngineDirection * 1000,
-						ECollisionChannel::ECC_WorldDynamic, ThrusterTraceParams))
-				{
-#if SHOW_TRACES
-					DrawDebugLine(GetWorld(), SocketLocation, SocketLocation + EngineDirection * 1000, FColor::Red, false);
-#endif
-					EngineIntensity = 0;
-				}
+				const FTransform SocketTransform = Exhaust.SocketTransform * ParentTransform;
+				FVector          EngineDirection = SocketTransform.GetUnitAxis(EAxis::X);
+				FVector          EngineOffset    = (SocketTransform.GetLocation() - GetOwner()->GetActorLocation()) / 100;
 
-				// Proceed with intensity calculation
-				else
+				// Get linear alpha
+				float LinearAlpha = -FVector::DotProduct(EngineDirection, LinearAcceleration.GetSafeNormal());
+
+				// Get Angular alpha
+				FVector TorqueDirection = FVector::CrossProduct(EngineOffset, EngineDirection).GetSafeNormal();
+				float   AngularAlpha    = 0;
+				if (!AngularAcceleration.IsNearlyZero())
 				{
-#if SHOW_TRACES
-					DrawDebugLine(GetWorld(), SocketLocation, SocketLocation + EngineDirection * 1000, FColor::Green, false);
-#endif
-
-					// Get linear alpha
-					float LinearAlpha = -FVector::DotProduct(EngineDirection, LinearAcceleration.GetSafeNormal());
-
-					// Get Angular alpha
-					FVector TorqueDirection = FVector::CrossProduct(EngineOffset, EngineDirection).GetSafeNormal();
-					float   AngularAlpha    = 0;
-					if (!AngularAcceleration.IsNearlyZero())
-					{
-						AngularAlpha = -FVector::DotProduct(TorqueDirection, AngularAcceleration.GetSafeNormal());
-					}
-
-					EngineIntensity = FMath::Max(LinearAlpha + AngularAlpha, 0.0f);
+					AngularAlpha = -FVector::DotProduct(TorqueDirection, AngularAcceleration.GetSafeNormal());
 				}
+
+				EngineIntensity = FMath::Max(LinearAlpha + AngularAlpha, 0.0f);
 			}
 
 			// Apply power
@@ -165,3 +157,18 @@ void UNovaSpacecraftThrusterComponent::TickComponent(float DeltaTime, ELevelTick
 		}
 	}
 }
+
+/*----------------------------------------------------
+    Occlusion
+----------------------------------------------------*/
+
+void UNovaSpacecraftThrusterComponent::GetExhaustTrace(int32 Index, FVector& Start, FVector& End) const
+{
+	NCHECK(ThrusterExhausts.IsValidIndex(Index));
+	NCHECK(IsValid(GetAttachParent()));
+
+	const FTransform SocketTransform = ThrusterExhausts[Index].SocketTransform * GetAttachParent()->GetComponentTransform();
+
+	Start = SocketTransform.GetLocation();
+	End   = Start + SocketTransform.GetUnitAxis(EAxis::X) * 1000;
+}
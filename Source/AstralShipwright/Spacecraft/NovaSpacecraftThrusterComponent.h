@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "NovaSpacecraftTypes.h"
 #include "Components/SceneComponent.h"
+#include "WorldCollision.h"
 
 #include "Neutron/Actor/NeutronActorTools.h"
 
@@ -16,12 +17,15 @@ struct FNovaThrusterExhaust
 {
 	GENERATED_BODY()
 
-	FNovaThrusterExhaust() : Mesh(nullptr), Material(nullptr)
+	FNovaThrusterExhaust() : Mesh(nullptr), Material(nullptr), IsOccluded(false)
 	{}
 
 	// Exhaust identifier
 	FName Name;
 
+	// Socket transform relative to the parent mesh
+	FTransform SocketTransform;
+
 	// Exhaust mesh
 	UPROPERTY()
 	class UStaticMeshComponent* Mesh;
@@ -32,6 +36,9 @@ struct FNovaThrusterExhaust
 
 	// Current power
 	TNeutronTimedAverage<float> Power;
+
+	// Latest occlusion result, kept until the next trace completes
+	bool IsOccluded;
 };
 
 /** Thruster component class that attaches to a mesh to add thrusters effects */
@@ -60,6 +67,36 @@ public:
 		return false;
 	}
 
+	/** Get the number of exhausts */
+	int32 GetExhaustCount() const
+	{
+		return ThrusterExhausts.Num();
+	}
+
+	/** Get the world-space occlusion trace of an exhaust */
+	void GetExhaustTrace(int32 Index, FVector& Start, FVector& End) const;
+
+	/** Get the collision parameters for exhaust traces */
+	const FCollisionQueryParams& GetExhaustTraceParams() const
+	{
+		return ThrusterTraceParams;
+	}
+
+	/** Check if an exhaust is currently occluded */
+	bool IsExhaustOccluded(int32 Index) const
+	{
+		return ThrusterExhausts.IsValidIndex(Index) && ThrusterExhausts[Index].IsOccluded;
+	}
+
+	/** Update the occlusion of an exhaust after a trace completed */
+	void SetExhaustOccluded(int32 Index, bool Occluded)
+	{
+		if (ThrusterExhausts.IsValidIndex(Index))
+		{
+			ThrusterExhausts[Index].IsOccluded = Occluded;
+		}
+	}
+
 	/*----------------------------------------------------
 	    Inherited
 	----------------------------------------------------*/
@@ -84,6 +121,12 @@ protected:
 	UPROPERTY()
 	TArray<FNovaThrusterExhaust> ThrusterExhausts;
 
+	// Movement component
+	UPROPERTY()
+	class UNovaSpacecraftMovementComponent* MovementComponent;
+
 	// Local data
 	FCollisionQueryParams ThrusterTraceParams;
+	FTransform            ThrusterTraceTransform;
+	bool                  HasThrusterTraces;
 };
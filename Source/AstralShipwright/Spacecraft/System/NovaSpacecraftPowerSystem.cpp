@@ -7,11 +7,10 @@
 #include "Game/NovaGameState.h"
 #include "Game/NovaOrbitalSimulationComponent.h"
 #include "Game/NovaOrbitalSimulationTypes.h"
+#include "Game/NovaSystemSimulationComponent.h"
 
 #include "Nova.h"
 
-#include "Neutron/System/NeutronAssetManager.h"
-
 #include "Net/UnrealNetwork.h"
 
 /*----------------------------------------------------
@@ -34,6 +33,26 @@ UNovaSpacecraftPowerSystem::UNovaSpacecraftPowerSystem()
     System implementation
 ----------------------------------------------------*/
 
+void UNovaSpacecraftPowerSystem::Load(const FNovaSpacecraft& Spacecraft)
+{
+	NLOG("UNovaSpacecraftPowerSystem::Load");
+
+	CurrentEnergy  = Spacecraft.GetPowerMetrics().EnergyCapacity;
+	EnergyCapacity = Spacecraft.GetPowerMetrics().EnergyCapacity;
+	CurrentPower   = 0;
+
+	// Mirror the headless simulation when this spacecraft was simulated without a pawn
+	const ANovaGameState*             GameState = GetWorld()->GetGameState<ANovaGameState>();
+	const FNovaSpacecraftSystemState* State =
+		IsValid(GameState) ? GameState->GetSystemSimulation()->GetSystemState(Spacecraft.Identifier) : nullptr;
+	if (State)
+	{
+		CurrentEnergy        = FMath::Min(State->CurrentEnergy, EnergyCapacity);
+		CurrentPower         = State->CurrentPower;
+		CurrentExposureRatio = State->CurrentExposureRatio;
+	}
+}
+
 void UNovaSpacecraftPowerSystem::Update(FNovaTime InitialTime, FNovaTime FinalTime)
 {
 	NCHECK(GetOwner()->GetLocalRole() == ROLE_Authority);
@@ -52,44 +71,14 @@ void UNovaSpacecraftPowerSystem::Update(FNovaTime InitialTime, FNovaTime FinalTi
 	CurrentPowerConsumption = 0;
 	CurrentExposureRatio    = 0;
 
-	// Compute solar exposure
-	double CurrentExposure = 0;
-	if (Spacecraft)
+	// Compute solar exposure, and the exposure profile when the orbit changed
+	const FNovaOrbitalLocation* PlayerLocation = Spacecraft ? OrbitalSimulation->GetSpacecraftLocation(Spacecraft->Identifier) : nullptr;
+	if (PlayerLocation)
 	{
-		// Get the relevant planetary bodies
-		const UNovaCelestialBody* SunBody    = nullptr;
-		const UNovaCelestialBody* PlanetBody = UNeutronAssetManager::Get()->GetDefaultAsset<UNovaCelestialBody>();
-		for (const UNovaCelestialBody* Body : UNeutronAssetManager::Get()->GetAssets<UNovaCelestialBody>())
+		CurrentExposureRatio = ComputeSolarExposure(*PlayerLocation);
+		if (!ExposureProfile.IsValidFor(PlayerLocation->Geometry))
 		{
-			if (Body->Body == nullptr)
-			{
-				SunBody = Body;
-				break;
-			}
-		}
-		NCHECK(SunBody);
-		NCHECK(PlanetBody);
-
-		// Compute the planet's occlusion
-		const FNovaOrbitalLocation* PlayerLocation = OrbitalSimulation->GetSpacecraftLocation(Spacecraft->Identifier);
-		if (PlayerLocation)
-		{
-			FVector2D SpacecraftCartesianLocation = PlayerLocation->GetCartesianLocation();
-
-			// Fetch basic data
-			const double SunDistanceFromPlanetKm = PlanetBody->Altitude.GetValue();
-			const double PlanetOcclusionHalfAngle =
-				FMath::RadiansToDegrees(FMath::Asin(PlanetBody->Radius / SpacecraftCartesianLocation.Size()));
-			const double PlayerRotationAngle =
-				FMath::RadiansToDegrees(FVector(SpacecraftCartesianLocation.X, SpacecraftCartesianLocation.Y, 0).HeadingAngle());
-
-			// Process angles into an exposure value using an arbitrary smoothing value
-			const double AngularDistance     = FMath::Abs(PlayerRotationAngle + 90);
-			const double ExposureCurveLength = 0.15 * PlanetOcclusionHalfAngle;
-			CurrentExposureRatio = FMath::Clamp(FMath::Abs(AngularDistance - PlanetOcclusionHalfAngle) / ExposureCurveLength, 0.0, 1.0);
-
-			// NLOG("%f - %f (%f) = %f -> %f", AngularDistance, PlanetOcclusionHalfAngle, ExposureCurveLength,
-			//	FMath::Abs(AngularDistance - PlanetOcclusionHalfAngle), CurrentExposureRatio);
+			BuildSolarExposureProfile(PlayerLocation->Geometry, ExposureProfile);
 		}
 	}
 
@@ -101,29 +90,17 @@ void UNovaSpacecraftPowerSystem::Update(FNovaTime InitialTime, FNovaTime FinalTi
 			CurrentPowerConsumption += ProcessingSystem->GetPowerUsage(GroupIndex);
 		}
 
+		// Handle production from modules and solar panels
+		const double BaseProduction  = ComputePowerProduction(*GetSpacecraft(), 0);
+		const double SolarProduction = ComputePowerProduction(*GetSpacecraft(), 1) - BaseProduction;
+		CurrentPowerProduction       = BaseProduction + CurrentExposureRatio * SolarProduction;
+
+		// Iterate over equipment for consumption
 		const auto& Compartments = GetSpacecraft()->Compartments;
 		for (int32 CompartmentIndex = 0; CompartmentIndex < Compartments.Num(); CompartmentIndex++)
 		{
-			// Iterate over modules for *production* only, never consumption that we already handled per group
-			for (const FNovaCompartmentModule& CompartmentModule : Compartments[CompartmentIndex].Modules)
-			{
-				const UNovaProcessingModuleDescription* Module = Cast<UNovaProcessingModuleDescription>(CompartmentModule.Description);
-				if (::IsValid(Module))
-				{
-					CurrentPowerProduction += FMath::Max(-Module->Power, 0);
-				}
-			}
-
-			// Iterate over equipment
 			for (const UNovaEquipmentDescription* Equipment : Compartments[CompartmentIndex].Equipment)
 			{
-				// Solar panels
-				const UNovaPowerEquipmentDescription* PowerEquipment = Cast<UNovaPowerEquipmentDescription>(Equipment);
-				if (PowerEquipment)
-				{
-					CurrentPowerProduction += CurrentExposureRatio * PowerEquipment->Power;
-				}
-
 				// Mining rig
 				const UNovaMiningEquipmentDescription* MiningEquipment = Cast<UNovaMiningEquipmentDescription>(Equipment);
 				if (MiningEquipment && ProcessingSystem->IsMiningRigActive() && ProcessingSystem->CanMiningRigBeActive())
@@ -141,10 +118,238 @@ void UNovaSpacecraftPowerSystem::Update(FNovaTime InitialTime, FNovaTime FinalTi
 			}
 		}
 
-		// Handle batteries
+		// Handle batteries, integrating over the orbit so that long steps go through eclipses correctly
 		CurrentPower = CurrentPowerProduction - CurrentPowerConsumption;
-		CurrentEnergy += CurrentPower * (FinalTime - InitialTime).AsHours();
-		CurrentEnergy = FMath::Clamp(CurrentEnergy, 0.0, EnergyCapacity);
+		if (PlayerLocation)
+		{
+			CurrentEnergy = IntegrateEnergy(ExposureProfile, PlayerLocation->Phase, FinalTime - InitialTime, SolarProduction,
+				BaseProduction - CurrentPowerConsumption, CurrentEnergy, EnergyCapacity);
+		}
+		else
+		{
+			CurrentEnergy += CurrentPower * (FinalTime - InitialTime).AsHours();
+			CurrentEnergy = FMath::Clamp(CurrentEnergy, 0.0, EnergyCapacity);
+		}
+	}
+}
+
+/*----------------------------------------------------
+    Data-oriented power
+----------------------------------------------------*/
+
+double UNovaSpacecraftPowerSystem::ComputeSolarExposure(const FNovaOrbitalLocation& Location)
+{
+	const UNovaCelestialBody* PlanetBody = Location.Geometry.Body;
+	NCHECK(PlanetBody);
+
+	FVector2D SpacecraftCartesianLocation = Location.GetCartesianLocation();
+
+	// Fetch basic data
+	const double PlanetOcclusionHalfAngle = FMath::RadiansToDegrees(FMath::Asin(PlanetBody->Radius / SpacecraftCartesianLocation.Size()));
+	const double PlayerRotationAngle =
+		FMath::RadiansToDegrees(FVector(SpacecraftCartesianLocation.X, SpacecraftCartesianLocation.Y, 0).HeadingAngle());
+
+	// Process angles into an exposure value using an arbitrary smoothing value
+	const double AngularDistance     = FMath::Abs(PlayerRotationAngle + 90);
+	const double ExposureCurveLength = 0.15 * PlanetOcclusionHalfAngle;
+	return FMath::Clamp(FMath::Abs(AngularDistance - PlanetOcclusionHalfAngle) / ExposureCurveLength, 0.0, 1.0);
+}
+
+void UNovaSpacecraftPowerSystem::BuildSolarExposureProfile(const FNovaOrbitGeometry& Geometry, FNovaSolarExposureProfile& Profile)
+{
+	NCHECK(Geometry.IsValid());
+
+	constexpr int32 SegmentCount   = 360;
+	constexpr int32 SubsampleCount = 4;
+	const double    SegmentWidth   = 360.0 / SegmentCount;
+
+	Profile.Geometry      = Geometry;
+	Profile.OrbitalPeriod = Geometry.GetOrbitalPeriod();
+	Profile.SegmentExposure.SetNumUninitialized(SegmentCount);
+
+	// Average the exposure over each segment
+	double TotalExposure = 0;
+	Profile.MinExposure  = 1;
+	Profile.MaxExposure  = 0;
+	for (int32 SegmentIndex = 0; SegmentIndex < SegmentCount; SegmentIndex++)
+	{
+		double SegmentExposure = 0;
+		for (int32 SampleIndex = 0; SampleIndex < SubsampleCount; SampleIndex++)
+		{
+			const double Phase = (SegmentIndex + (SampleIndex + 0.5) / SubsampleCount) * SegmentWidth;
+			SegmentExposure += ComputeSolarExposure(FNovaOrbitalLocation(Geometry, Phase));
+		}
+
+		Profile.SegmentExposure[SegmentIndex] = SegmentExposure / SubsampleCount;
+		TotalExposure += Profile.SegmentExposure[SegmentIndex];
+		Profile.MinExposure = FMath::Min(Profile.MinExposure, Profile.SegmentExposure[SegmentIndex]);
+		Profile.MaxExposure = FMath::Max(Profile.MaxExposure, Profile.SegmentExposure[SegmentIndex]);
+	}
+	Profile.MeanExposure = TotalExposure / SegmentCount;
+
+	// Find the eclipse as the run of segments without full exposure
+	auto IsLit = [&Profile](int32 SegmentIndex)
+	{
+		return Profile.SegmentExposure[SegmentIndex] >= 1.0 - KINDA_SMALL_NUMBER;
+	};
+	int32 EclipseCount = 0;
+	int32 StartSegment = 0;
+	int32 EndSegment   = 0;
+	for (int32 SegmentIndex = 0; SegmentIndex < SegmentCount; SegmentIndex++)
+	{
+		const int32 PreviousSegmentIndex = (SegmentIndex + SegmentCount - 1) % SegmentCount;
+		if (IsLit(PreviousSegmentIndex) && !IsLit(SegmentIndex))
+		{
+			StartSegment = SegmentIndex;
+			EclipseCount++;
+		}
+		else if (!IsLit(PreviousSegmentIndex) && IsLit(SegmentIndex))
+		{
+			EndSegment = SegmentIndex;
+		}
+	}
+
+	// A single eclipse is integrated segment by segment, fully lit orbits at once, and anything else over the entire orbit
+	if (EclipseCount == 1)
+	{
+		Profile.HasEclipse        = true;
+		Profile.EclipseStartPhase = StartSegment * SegmentWidth;
+		Profile.EclipseEndPhase   = EndSegment * SegmentWidth;
+	}
+	else
+	{
+		Profile.HasEclipse        = EclipseCount > 0 || !IsLit(0);
+		Profile.EclipseStartPhase = 0;
+		Profile.EclipseEndPhase   = 360;
+	}
+}
+
+double UNovaSpacecraftPowerSystem::IntegrateEnergy(const FNovaSolarExposureProfile& Profile, double FinalPhase, FNovaTime DeltaTime,
+	double SolarPower, double BasePower, double InitialEnergy, double Capacity)
+{
+	const double HoursPerDegree = Profile.OrbitalPeriod.AsHours() / 360.0;
+	double       Energy         = InitialEnergy;
+
+	// Power is constant without an eclipse, so the clamped result is exact in one step
+	if (!Profile.HasEclipse || SolarPower == 0 || HoursPerDegree <= 0 || Profile.SegmentExposure.Num() == 0)
+	{
+		const double Power = SolarPower * Profile.MeanExposure + BasePower;
+		return FMath::Clamp(Energy + Power * DeltaTime.AsHours(), 0.0, Capacity);
+	}
+
+	// A battery pinned at a limit stays there when the power never changes sign over the orbit
+	const bool IsChargedForever = Energy >= Capacity && SolarPower * Profile.MinExposure + BasePower >= 0;
+	const bool IsDrainedForever = Energy <= 0 && SolarPower * Profile.MaxExposure + BasePower <= 0;
+	if (IsChargedForever || IsDrainedForever)
+	{
+		return FMath::Clamp(Energy, 0.0, Capacity);
+	}
+
+	const int32  SegmentCount   = Profile.SegmentExposure.Num();
+	const double SegmentWidth   = 360.0 / SegmentCount;
+	double       RemainingPhase = DeltaTime.AsHours() / HoursPerDegree;
+	double       Phase          = FMath::Fmod(FinalPhase - RemainingPhase, 360.0);
+	if (Phase < 0)
+	{
+		Phase += 360.0;
+	}
+
+	// Orbits that never reach full exposure are a single eclipse starting at phase zero
+	const bool IsFullEclipse = Profile.EclipseStartPhase == 0 && Profile.EclipseEndPhase == 360;
+
+	// Walk the lit arc in one step and the eclipse segment by segment, clamping the battery after each step
+	double LastEclipseEnergy    = 0;
+	bool   HasLastEclipseEnergy = false;
+	while (RemainingPhase > 0)
+	{
+		double Step;
+		double Exposure;
+		bool   ReachesEclipse = false;
+		if (Profile.IsInEclipse(Phase))
+		{
+			const int32 SegmentIndex = FMath::Clamp(FMath::FloorToInt(Phase / SegmentWidth), 0, SegmentCount - 1);
+			const double PhaseToSegmentEnd = (SegmentIndex + 1) * SegmentWidth - Phase;
+			ReachesEclipse                 = IsFullEclipse && SegmentIndex == SegmentCount - 1 && PhaseToSegmentEnd <= RemainingPhase;
+			Step                           = FMath::Min(PhaseToSegmentEnd, RemainingPhase);
+			Exposure                       = Profile.SegmentExposure[SegmentIndex];
+		}
+		else
+		{
+			double PhaseToEclipse = Profile.EclipseStartPhase - Phase;
+			if (PhaseToEclipse <= 0)
+			{
+				PhaseToEclipse += 360.0;
+			}
+
+			ReachesEclipse = PhaseToEclipse <= RemainingPhase;
+			Step           = FMath::Min(PhaseToEclipse, RemainingPhase);
+			Exposure       = 1.0;
+		}
+
+		Energy = FMath::Clamp(Energy + (SolarPower * Exposure + BasePower) * Step * HoursPerDegree, 0.0, Capacity);
+		Phase  = FMath::Fmod(Phase + Step, 360.0);
+		RemainingPhase -= Step;
+
+		// Once the battery is identical at two eclipse entries, all further orbits are too, with or without a lit arc
+		if (ReachesEclipse)
+		{
+			Phase = Profile.EclipseStartPhase;
+			if (HasLastEclipseEnergy && FMath::IsNearlyEqual(Energy, LastEclipseEnergy, 1e-6))
+			{
+				RemainingPhase = FMath::Fmod(RemainingPhase, 360.0);
+			}
+
+			LastEclipseEnergy    = Energy;
+			HasLastEclipseEnergy = true;
+		}
+	}
+
+	return Energy;
+}
+
+double UNovaSpacecraftPowerSystem::ComputePowerProduction(const FNovaSpacecraft& Spacecraft, double ExposureRatio)
+{
+	double PowerProduction = 0;
+
+	for (const FNovaCompartment& Compartment : Spacecraft.Compartments)
+	{
+		// Iterate over modules for *production* only, never consumption that is handled per processing group
+		for (const FNovaCompartmentModule& CompartmentModule : Compartment.Modules)
+		{
+			const UNovaProcessingModuleDescription* Module = Cast<UNovaProcessingModuleDescription>(CompartmentModule.Description);
+			if (::IsValid(Module))
+			{
+				PowerProduction += FMath::Max(-Module->Power, 0);
+			}
+		}
+
+		// Solar panels
+		for (const UNovaEquipmentDescription* Equipment : Compartment.Equipment)
+		{
+			const UNovaPowerEquipmentDescription* PowerEquipment = Cast<UNovaPowerEquipmentDescription>(Equipment);
+			if (PowerEquipment)
+			{
+				PowerProduction += ExposureRatio * PowerEquipment->Power;
+			}
+		}
+	}
+
+	return PowerProduction;
+}
+
+FNovaTime UNovaSpacecraftPowerSystem::ComputePoweredTime(double Energy, double Power)
+{
+	if (Energy <= 0)
+	{
+		return FNovaTime();
+	}
+	else if (Power >= 0)
+	{
+		return FNovaTime::FromMinutes(DBL_MAX);
+	}
+	else
+	{
+		return FNovaTime::FromHours(Energy / -Power);
 	}
 }
 
@@ -4,10 +4,59 @@
 
 #include "CoreMinimal.h"
 #include "NovaSpacecraftSystemInterface.h"
+#include "Game/NovaOrbitalSimulationTypes.h"
 #include "Components/SceneComponent.h"
 
 #include "NovaSpacecraftPowerSystem.generated.h"
 
+/** Solar exposure over one revolution of an orbit, precomputed to integrate energy over long intervals */
+struct FNovaSolarExposureProfile
+{
+	FNovaSolarExposureProfile()
+		: HasEclipse(false), EclipseStartPhase(0), EclipseEndPhase(0), MeanExposure(1), MinExposure(1), MaxExposure(1)
+	{}
+
+	/** Check whether this profile was built for an orbit */
+	bool IsValidFor(const FNovaOrbitGeometry& OtherGeometry) const
+	{
+		return Geometry.IsValid() && Geometry == OtherGeometry && Geometry.Body == OtherGeometry.Body;
+	}
+
+	/** Check whether a phase in degrees in [0, 360[ is inside the eclipse */
+	bool IsInEclipse(double Phase) const
+	{
+		if (!HasEclipse)
+		{
+			return false;
+		}
+		else if (EclipseStartPhase <= EclipseEndPhase)
+		{
+			return Phase >= EclipseStartPhase && Phase < EclipseEndPhase;
+		}
+		else
+		{
+			return Phase >= EclipseStartPhase || Phase < EclipseEndPhase;
+		}
+	}
+
+	// Orbit this profile was built for
+	FNovaOrbitGeometry Geometry;
+	FNovaTime          OrbitalPeriod;
+
+	// Phases in degrees where the exposure starts decreasing and where it is fully restored, may wrap around 360
+	bool   HasEclipse;
+	double EclipseStartPhase;
+	double EclipseEndPhase;
+
+	// Average exposure over each phase segment, and over the whole orbit
+	TArray<double> SegmentExposure;
+	double         MeanExposure;
+
+	// Lowest and highest segment exposure over the whole orbit
+	double MinExposure;
+	double MaxExposure;
+};
+
 /** Power system that simulates power usage */
 UCLASS(ClassGroup = (Nova), meta = (BlueprintSpawnableComponent))
 class UNovaSpacecraftPowerSystem
@@ -24,14 +73,7 @@ public:
 	    System implementation
 	----------------------------------------------------*/
 
-	virtual void Load(const FNovaSpacecraft& Spacecraft) override
-	{
-		NLOG("UNovaSpacecraftPowerSystem::Load");
-
-		CurrentEnergy  = Spacecraft.GetPowerMetrics().EnergyCapacity;
-		EnergyCapacity = Spacecraft.GetPowerMetrics().EnergyCapacity;
-		CurrentPower   = 0;
-	}
+	virtual void Load(const FNovaSpacecraft& Spacecraft) override;
 
 	virtual void Save(FNovaSpacecraft& Spacecraft) override
 	{
@@ -97,6 +139,26 @@ public:
 		return CurrentExposureRatio;
 	}
 
+	/*----------------------------------------------------
+	    Data-oriented power
+	----------------------------------------------------*/
+
+	/** Compute the solar exposure ratio at an orbital location, occluded by the body it orbits */
+	static double ComputeSolarExposure(const FNovaOrbitalLocation& Location);
+
+	/** Build the exposure profile for an orbit, finding its eclipse phases */
+	static void BuildSolarExposureProfile(const FNovaOrbitGeometry& Geometry, FNovaSolarExposureProfile& Profile);
+
+	/** Integrate battery energy over DeltaTime up to FinalPhase, with a power of SolarPower * exposure + BasePower */
+	static double IntegrateEnergy(const FNovaSolarExposureProfile& Profile, double FinalPhase, FNovaTime DeltaTime, double SolarPower,
+		double BasePower, double InitialEnergy, double Capacity);
+
+	/** Compute the power produced by a spacecraft's modules and solar panels at a given exposure ratio */
+	static double ComputePowerProduction(const FNovaSpacecraft& Spacecraft, double ExposureRatio);
+
+	/** Compute how long the batteries can keep the spacecraft powered at a given power delta */
+	static FNovaTime ComputePoweredTime(double Energy, double Power);
+
 	/*----------------------------------------------------
 	    Data
 	----------------------------------------------------*/
@@ -126,4 +188,7 @@ protected:
 	// Current battery capacity
 	UPROPERTY(Replicated)
 	double EnergyCapacity;
+
+	// Exposure profile for the current orbit
+	FNovaSolarExposureProfile ExposureProfile;
 };
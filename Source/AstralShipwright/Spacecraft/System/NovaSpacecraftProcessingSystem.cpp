@@ -39,142 +39,12 @@ void UNovaSpacecraftProcessingSystem::Load(const FNovaSpacecraft& Spacecraft)
 	MiningRigStatus   = ENovaSpacecraftProcessingSystemStatus::Stopped;
 
 	// Initialize processing groups with all unique descriptions
-	ProcessingGroupsStates.Empty();
-	for (const FNovaModuleGroup& Group : Spacecraft.GetModuleGroups())
-	{
-		// Find out potential mining rig
-		const UNovaMiningEquipmentDescription* MiningRig = nullptr;
-		for (const FNovaModuleGroupCompartment& GroupCompartment : Group.Compartments)
-		{
-			const FNovaCompartment& Compartment = Spacecraft.Compartments[GroupCompartment.CompartmentIndex];
-			for (FName EquipmentSlotName : GroupCompartment.LinkedEquipments)
-			{
-				const UNovaMiningEquipmentDescription* MiningRigCandidate =
-					Cast<UNovaMiningEquipmentDescription>(Compartment.GetEquipmentySocket(EquipmentSlotName));
-				if (MiningRigCandidate)
-				{
-					MiningRig = MiningRigCandidate;
-					break;
-				}
-			}
-		}
-
-		// Find all processing modules
-		TArray<FNovaSpacecraftProcessingSystemChainStateModule> ProcessingModules;
-		for (const auto& CompartmentModuleIndex : Spacecraft.GetAllModules<UNovaProcessingModuleDescription>(Group))
-		{
-			const FNovaCompartment& Compartment = Spacecraft.Compartments[CompartmentModuleIndex.Key];
-
-			FNovaSpacecraftProcessingSystemChainStateModule Entry;
-			Entry.Module           = Cast<UNovaProcessingModuleDescription>(Compartment.Modules[CompartmentModuleIndex.Value].Description);
-			Entry.CompartmentIndex = CompartmentModuleIndex.Key;
-			Entry.ModuleIndex      = CompartmentModuleIndex.Value;
-
-			ProcessingModules.Add(Entry);
-		}
-
-		// Merge modules into chains
-		TArray<FNovaSpacecraftProcessingSystemChainState> ProcessingChains;
-		for (auto It = ProcessingModules.CreateIterator(); It; ++It)
-		{
-			const UNovaProcessingModuleDescription* Module = It->Module;
-
-			// Find out whether an already merged chain has valid inputs that this modules provides as output, or vice versa
-			FNovaSpacecraftProcessingSystemChainState* ChainState = ProcessingChains.FindByPredicate(
-				[Module](const FNovaSpacecraftProcessingSystemChainState& Chain)
-				{
-					for (const UNovaResource* Resource : Module->Inputs)
-					{
-						if (Chain.Outputs.Contains(Resource))
-						{
-							return true;
-						}
-					}
-
-					for (const UNovaResource* Resource : Module->Outputs)
-					{
-						if (Chain.Inputs.Contains(Resource))
-						{
-							return true;
-						}
-					}
-
-					return false;
-				});
-
-			// Update the chain with the current module
-			if (ChainState)
-			{
-				ChainState->Modules.Add(*It);
-
-				// For each new output, either consume an input, or add it
-				for (const UNovaResource* Resource : Module->Outputs)
-				{
-					if (ChainState->Inputs.Contains(Resource))
-					{
-						ChainState->Inputs.RemoveSingle(Resource);
-					}
-					else
-					{
-						ChainState->Outputs.Add(Resource);
-					}
-				}
-
-				// For each new input, either consume an output, or add it
-				for (const UNovaResource* Resource : Module->Inputs)
-				{
-					if (ChainState->Outputs.Contains(Resource))
-					{
-						ChainState->Outputs.RemoveSingle(Resource);
-					}
-					else
-					{
-						ChainState->Inputs.Add(Resource);
-					}
-				}
-			}
-
-			// Else, add the module as a new chain
-			else
-			{
-				FNovaSpacecraftProcessingSystemChainState NewChainState;
-
-				NewChainState.Inputs         = Module->Inputs;
-				NewChainState.Outputs        = Module->Outputs;
-				NewChainState.ProcessingRate = Module->ProcessingRate;
-				NewChainState.Modules.Add(*It);
-
-				ProcessingChains.Add(NewChainState);
-			}
-
-			It.RemoveCurrent();
-		}
-
-		// Initialize the processing group and compute the processing rate
-		if (ProcessingChains.Num() || MiningRig)
-		{
-			FNovaSpacecraftProcessingSystemGroupState GroupState(Group.Index);
-			for (FNovaSpacecraftProcessingSystemChainState& ChainState : ProcessingChains)
-			{
-				if (ChainState.Modules.Num())
-				{
-					NCHECK(ChainState.Inputs.Num());
-					NCHECK(ChainState.Outputs.Num());
-
-					ChainState.ProcessingRate = ChainState.Modules[0].Module->ProcessingRate;
-					for (const FNovaSpacecraftProcessingSystemChainStateModule& ModuleEntry : ChainState.Modules)
-					{
-						ChainState.ProcessingRate = FMath::Min(ChainState.ProcessingRate, ModuleEntry.Module->ProcessingRate);
-					}
-
-					GroupState.Chains.Add(ChainState);
-				}
-			}
-
-			GroupState.MiningRig = MiningRig;
+	BuildProcessingGroups(Spacecraft, ProcessingGroupsStates);
 
-			ProcessingGroupsStates.Add(GroupState);
-		}
+	// Resume production as stored on the spacecraft
+	for (FNovaSpacecraftProcessingSystemGroupState& GroupState : ProcessingGroupsStates)
+	{
+		GroupState.Active = Spacecraft.ActiveProcessingGroups.Contains(GroupState.GroupIndex);
 	}
 
 	// Load all cargo from the spacecraft
@@ -211,10 +81,14 @@ void UNovaSpacecraftProcessingSystem::Save(FNovaSpacecraft& Spacecraft)
 		}
 	}
 
-	// Shutdown production
-	for (auto& GroupState : ProcessingGroupsStates)
+	// Save production to the spacecraft so that it carries on without the pawn
+	Spacecraft.ActiveProcessingGroups.Reset();
+	for (const FNovaSpacecraftProcessingSystemGroupState& GroupState : ProcessingGroupsStates)
 	{
-		GroupState.Active = false;
+		if (GroupState.Active)
+		{
+			Spacecraft.ActiveProcessingGroups.Add(GroupState.GroupIndex);
+		}
 	}
 
 	MiningRigActive   = false;
@@ -234,378 +108,131 @@ void UNovaSpacecraftProcessingSystem::Update(FNovaTime InitialTime, FNovaTime Fi
 	RemainingProductionTime = FNovaTime::FromMinutes(DBL_MAX);
 
 	// Update processing groups
-	int32 CurrentGroupIndex = 0;
-	for (auto& GroupState : ProcessingGroupsStates)
-	{
-		for (auto& ChainState : GroupState.Chains)
+	const FNovaTime PoweredTime =
+		UNovaSpacecraftPowerSystem::ComputePoweredTime(PowerSystem->GetRemainingEnergy(), PowerSystem->GetCurrentPower());
+	UpdateProcessingGroups(
+		*Spacecraft, ProcessingGroupsStates,
+		[this](int32 CompartmentIndex, int32 ModuleIndex) -> FNovaSpacecraftCargo&
 		{
-			if (IsSpacecraftDocked())
-			{
-				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Docked;
-			}
-			else
-			{
-				// Get required constants for each processing module entry
-				const FNovaModuleGroup&            Group             = Spacecraft->GetModuleGroups()[GroupState.GroupIndex];
-				const TArray<TPair<int32, int32>>& GroupCargoModules = Spacecraft->GetAllModules<UNovaCargoModuleDescription>(Group);
-
-				// Define processing targets
-				int32                              EmptyOutputSlotCount = 0;
-				TArray<FNovaSpacecraftCargo*>      InputCargoSlots;
-				TArray<FNovaSpacecraftCargo*>      OutputCargoSlots;
-				TMap<FNovaSpacecraftCargo*, float> CargoSlotCapacities;
-				TMap<const UNovaResource*, float>  InputResourceAmounts;
-				TMap<const UNovaResource*, float>  OutputResourceAmounts;
-
-				// Process cargo for targets, identify empty slots
-				float MinCargoCapacity = 1000;
-				for (const auto& Indices : GroupCargoModules)
-				{
-					FNovaSpacecraftCargo& Cargo         = RealtimeCompartments[Indices.Key].Cargo[Indices.Value];
-					const float           CargoCapacity = Spacecraft->GetCargoCapacity(Indices.Key, Indices.Value);
-					MinCargoCapacity                    = FMath::Min(MinCargoCapacity, CargoCapacity);
-					CargoSlotCapacities.Add(&Cargo, CargoCapacity);
+			return RealtimeCompartments[CompartmentIndex].Cargo[ModuleIndex];
+		},
+		IsSpacecraftDocked(), PoweredTime, FinalTime - InitialTime, RemainingProductionTime);
 
-					// Valid resource input: add to the input map, and the list of current input slots
-					if (Cargo.Resource && ChainState.Inputs.Contains(Cargo.Resource) && Cargo.Amount > 0)
-					{
-						auto& ResourceAmount = InputResourceAmounts.FindOrAdd(Cargo.Resource);
-						ResourceAmount += Cargo.Amount;
-						InputCargoSlots.AddUnique(&Cargo);
-					}
+	// Process the mining rig
+	MiningRigResource = nullptr;
+	if (IsSpacecraftDocked())
+	{
+		MiningRigActive = false;
+		MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Docked;
+	}
+	else if (IsValid(SpacecraftPawn) && !SpacecraftPawn->GetSpacecraftMovement()->IsAnchored())
+	{
+		MiningRigActive = false;
+		MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Stopped;
+	}
+	else
+	{
+		const ANovaAsteroid* AsteroidActor =
+			UNeutronActorTools::GetClosestActor<ANovaAsteroid>(SpacecraftPawn, SpacecraftPawn->GetActorLocation());
 
-					// Valid resource output: add to the output map, the list of current output slots, process empty modifier
-					else if ((ChainState.Outputs.Contains(Cargo.Resource) || Cargo.Resource == nullptr) && Cargo.Amount < CargoCapacity)
-					{
-						if (Cargo.Resource)
-						{
-							auto& ResourceAmount = OutputResourceAmounts.FindOrAdd(Cargo.Resource);
-							ResourceAmount += CargoCapacity - Cargo.Amount;
-						}
-						else
-						{
-							EmptyOutputSlotCount++;
-						}
+		// Process activity
+		if (IsValid(AsteroidActor))
+		{
+			// Get data
+			const FNovaAsteroid&               Asteroid          = Cast<ANovaAsteroid>(AsteroidActor)->GetAsteroidData();
+			const int32                        GroupIndex        = GetMiningRigIndex();
+			const FNovaModuleGroup&            Group             = Spacecraft->GetModuleGroups()[GroupIndex];
+			const TArray<TPair<int32, int32>>& GroupCargoModules = Spacecraft->GetAllModules<UNovaCargoModuleDescription>(Group);
 
-						OutputCargoSlots.AddUnique(&Cargo);
-					}
-				}
+			// Define processing targets, with the capacity of each output slot
+			MiningRigResource         = Asteroid.MineralResource;
+			float TotalProcessingLeft = 0;
+			TArray<TPair<FNovaSpacecraftCargo*, float>, TInlineAllocator<16>> CurrentOutputs;
 
-				// Ensure all output resources have at least an empty entry
-				for (const UNovaResource* Resource : ChainState.Outputs)
-				{
-					if (!OutputResourceAmounts.Contains(Resource))
-					{
-						OutputResourceAmounts.Add(Resource, 0);
-					}
-				}
+			// Process cargo for targets
+			for (const auto& Indices : GroupCargoModules)
+			{
+				FNovaSpacecraftCargo& Cargo         = RealtimeCompartments[Indices.Key].Cargo[Indices.Value];
+				const float           CargoCapacity = Spacecraft->GetCargoCapacity(Indices.Key, Indices.Value);
 
-				// Attribute empty slots to the resources with the least space
-				OutputResourceAmounts.ValueSort(TLess<float>());
-				int32 RemainingEmptySlots = EmptyOutputSlotCount;
-				for (TPair<const UNovaResource*, float>& Output : OutputResourceAmounts)
+				// Valid resource output
+				if ((MiningRigResource == Cargo.Resource || Cargo.Resource == nullptr) && Cargo.Amount < CargoCapacity)
 				{
-					if (RemainingEmptySlots > 0)
-					{
-						Output.Value += MinCargoCapacity;
-						RemainingEmptySlots--;
-					}
+					TotalProcessingLeft += CargoCapacity - Cargo.Amount;
+					CurrentOutputs.Add(TPair<FNovaSpacecraftCargo*, float>(&Cargo, CargoCapacity));
 				}
+			}
 
-				// Start production based on input
-				if (!GroupState.Active)
-				{
-					ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Stopped;
-				}
-				else if (ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Stopped)
-				{
-					ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Processing;
-				}
+			// Cancel production when blocked
+			if (CurrentOutputs.Num() == 0)
+			{
+				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Blocked;
+			}
+
+			// Cancel production when out of power
+			else if (PowerSystem->GetRemainingEnergy() <= 0)
+			{
+				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::PowerLoss;
+			}
+
+			// Handle explicit stop
+			else if (!MiningRigActive)
+			{
+				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Stopped;
+			}
 
-				// Cancel production when blocked
-				if (ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Processing)
+			// Proceed with processing
+			else if (MiningRigActive)
+			{
+				// Compute the mining delta
+				MiningRigStatus     = ENovaSpacecraftProcessingSystemStatus::Processing;
+				float ResourceDelta = GetCurrentMiningRate() * (FinalTime - InitialTime).AsSeconds();
+				ResourceDelta       = FMath::Min(ResourceDelta, TotalProcessingLeft);
+				if (ResourceDelta > 0)
 				{
-					auto CargoHasResource = [](const TArray<FNovaSpacecraftCargo*>& Entries, const UNovaResource* Resource)
+					TotalProcessingLeft -= ResourceDelta;
+
+					auto ProcessOutput = [this, &ResourceDelta](const TPair<FNovaSpacecraftCargo*, float>& Output, bool AcceptEmpty)
 					{
-						for (const FNovaSpacecraftCargo* Cargo : Entries)
+						FNovaSpacecraftCargo* Cargo              = Output.Key;
+						float                 LocalResourceDelta = FMath::Min(ResourceDelta, Output.Value - Cargo->Amount);
+						if (LocalResourceDelta > 0 && (Cargo->Resource == MiningRigResource || (Cargo->Resource == nullptr && AcceptEmpty)))
 						{
-							if (Cargo->Resource == Resource)
-							{
-								return true;
-							}
+							Cargo->Resource = MiningRigResource;
+							Cargo->Amount += LocalResourceDelta;
+
+							ResourceDelta = FMath::Max(ResourceDelta - LocalResourceDelta, 0);
 						}
-						return false;
 					};
 
-					bool HasMissingResource = false;
-
-					// Check inputs
-					for (const UNovaResource* Resource : ChainState.Inputs)
+					for (const TPair<FNovaSpacecraftCargo*, float>& Output : CurrentOutputs)
 					{
-						if (!CargoHasResource(InputCargoSlots, Resource))
-						{
-							HasMissingResource = true;
-							break;
-						}
+						ProcessOutput(Output, false);
 					}
 
-					// Check outputs, allow empty cargo
-					for (const UNovaResource* Resource : ChainState.Outputs)
+					if (ResourceDelta > 0)
 					{
-						if (CargoHasResource(OutputCargoSlots, Resource))
-						{}
-						else if (EmptyOutputSlotCount > 0 && CargoHasResource(OutputCargoSlots, nullptr))
-						{
-							EmptyOutputSlotCount--;
-						}
-						else
+						for (const TPair<FNovaSpacecraftCargo*, float>& Output : CurrentOutputs)
 						{
-							HasMissingResource = true;
-							break;
+							ProcessOutput(Output, true);
 						}
 					}
 
-					if (HasMissingResource)
+					NCHECK(ResourceDelta == 0);
+
+					// Compute remaining time for simulation purposes
+					const FNovaTime TotalMiningTimeRemaining = FNovaTime::FromSeconds(TotalProcessingLeft / GetCurrentMiningRate());
+					if (RemainingProductionTime < FLT_MAX)
+					{
+						RemainingProductionTime = FMath::Max(RemainingProductionTime, TotalMiningTimeRemaining);
+					}
+					else
 					{
-						ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Blocked;
-						NLOG("UNovaSpacecraftProcessingSystem::Update : blocked production for group %d", CurrentGroupIndex);
+						RemainingProductionTime = TotalMiningTimeRemaining;
 					}
-				}
 
-				// Cancel production when out of power
-				if (ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Processing && PowerSystem->GetRemainingEnergy() <= 0)
-				{
-					ChainState.Status = ENovaSpacecraftProcessingSystemStatus::PowerLoss;
-					NLOG("UNovaSpacecraftProcessingSystem::Update : power loss for group %d", CurrentGroupIndex);
-				}
-
-				// Proceed with processing
-				if (ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Processing)
-				{
-					float     MinimumProcessingLeft   = FLT_MAX;
-					FNovaTime TotalChainTimeRemaining = FLT_MAX;
-
-					auto UpdateTotalTimeRemaining = [&MinimumProcessingLeft, &TotalChainTimeRemaining, &ChainState](
-														const TMap<const UNovaResource*, float>&  ResourceAmounts,
-														const TArray<const class UNovaResource*>& ProductionResources)
-					{
-						for (const TPair<const UNovaResource*, float>& Input : ResourceAmounts)
-						{
-							// Compute the processing rate
-							int32 InputProcessorCount = 0;
-							for (const UNovaResource* Resource : ProductionResources)
-							{
-								if (Resource == Input.Key)
-								{
-									InputProcessorCount++;
-								}
-							}
-							const float ProcessingRate = InputProcessorCount * ChainState.ProcessingRate;
-							TotalChainTimeRemaining =
-								FMath::Min(TotalChainTimeRemaining, FNovaTime::FromSeconds(Input.Value / ProcessingRate));
-							MinimumProcessingLeft = FMath::Min(MinimumProcessingLeft, Input.Value);
-						}
-					};
-
-					// Process the total processing time remaining
-					UpdateTotalTimeRemaining(InputResourceAmounts, ChainState.Inputs);
-					UpdateTotalTimeRemaining(OutputResourceAmounts, ChainState.Outputs);
-					if (RemainingProductionTime < FLT_MAX)
-					{
-						RemainingProductionTime = FMath::Max(RemainingProductionTime, TotalChainTimeRemaining);
-					}
-					else
-					{
-						RemainingProductionTime = TotalChainTimeRemaining;
-					}
-
-					// NLOG("%.2f minutes remaining, min %.2f, processing %.2f", TotalChainTimeRemaining.AsMinutes(), MinimumProcessingLeft,
-					//	(FinalTime - InitialTime).AsMinutes());
-
-					const float ResourceDelta =
-						FMath::Min(ChainState.ProcessingRate * (FinalTime - InitialTime).AsSeconds(), MinimumProcessingLeft);
-					if (ResourceDelta > 0)
-					{
-						// Process outputs, prefer existing resource
-						for (const UNovaResource* Resource : ChainState.Outputs)
-						{
-							float CurrentDelta = ResourceDelta;
-
-							auto ProcessOutput = [Resource, &CurrentDelta, &CargoSlotCapacities](
-													 FNovaSpacecraftCargo* Cargo, bool AcceptEmpty)
-							{
-								float LocalResourceDelta = FMath::Min(CurrentDelta, CargoSlotCapacities[Cargo] - Cargo->Amount);
-								if (LocalResourceDelta > 0 && (Cargo->Resource == Resource || (Cargo->Resource == nullptr && AcceptEmpty)))
-								{
-									Cargo->Resource = Resource;
-									Cargo->Amount += LocalResourceDelta;
-
-									CurrentDelta = FMath::Max(CurrentDelta - LocalResourceDelta, 0);
-								}
-							};
-
-							for (FNovaSpacecraftCargo* Output : OutputCargoSlots)
-							{
-								ProcessOutput(Output, false);
-							}
-
-							if (ResourceDelta > 0)
-							{
-								for (FNovaSpacecraftCargo* Output : OutputCargoSlots)
-								{
-									ProcessOutput(Output, true);
-								}
-							}
-
-							NCHECK(CurrentDelta == 0);
-						}
-
-						// Process inputs
-						for (const UNovaResource* Resource : ChainState.Inputs)
-						{
-							float CurrentDelta = ResourceDelta;
-
-							for (FNovaSpacecraftCargo* Input : InputCargoSlots)
-							{
-								if (Input->Resource == Resource)
-								{
-									float LocalResourceDelta = FMath::Min(CurrentDelta, Input->Amount);
-
-									Input->Amount -= LocalResourceDelta;
-									if (Input->Amount < ENovaConstants::ResourceQuantityThreshold)
-									{
-										Input->Resource = nullptr;
-										Input->Amount   = 0;
-									}
-
-									CurrentDelta -= LocalResourceDelta;
-								}
-							}
-
-							NCHECK(CurrentDelta == 0);
-						}
-					}
-				}
-			}
-		}
-
-		CurrentGroupIndex++;
-	}
-
-	// Process the mining rig
-	MiningRigResource = nullptr;
-	if (IsSpacecraftDocked())
-	{
-		MiningRigActive = false;
-		MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Docked;
-	}
-	else if (IsValid(SpacecraftPawn) && !SpacecraftPawn->GetSpacecraftMovement()->IsAnchored())
-	{
-		MiningRigActive = false;
-		MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Stopped;
-	}
-	else
-	{
-		const ANovaAsteroid* AsteroidActor =
-			UNeutronActorTools::GetClosestActor<ANovaAsteroid>(SpacecraftPawn, SpacecraftPawn->GetActorLocation());
-
-		// Process activity
-		if (IsValid(AsteroidActor))
-		{
-			// Get data
-			const FNovaAsteroid&               Asteroid          = Cast<ANovaAsteroid>(AsteroidActor)->GetAsteroidData();
-			const int32                        GroupIndex        = GetMiningRigIndex();
-			const FNovaModuleGroup&            Group             = Spacecraft->GetModuleGroups()[GroupIndex];
-			const TArray<TPair<int32, int32>>& GroupCargoModules = Spacecraft->GetAllModules<UNovaCargoModuleDescription>(Group);
-			TMap<FNovaSpacecraftCargo*, float> CargoSlotCapacities;
-
-			// Define processing targets
-			MiningRigResource                                 = Asteroid.MineralResource;
-			float                         TotalProcessingLeft = 0;
-			TArray<FNovaSpacecraftCargo*> CurrentOutputs;
-
-			// Process cargo for targets
-			for (const auto& Indices : GroupCargoModules)
-			{
-				FNovaSpacecraftCargo& Cargo         = RealtimeCompartments[Indices.Key].Cargo[Indices.Value];
-				const float           CargoCapacity = Spacecraft->GetCargoCapacity(Indices.Key, Indices.Value);
-				CargoSlotCapacities.Add(&Cargo, CargoCapacity);
-
-				// Valid resource output
-				if ((MiningRigResource == Cargo.Resource || Cargo.Resource == nullptr) && Cargo.Amount < CargoCapacity)
-				{
-					TotalProcessingLeft += CargoCapacity - Cargo.Amount;
-					CurrentOutputs.AddUnique(&Cargo);
-				}
-			}
-
-			// Cancel production when blocked
-			if (CurrentOutputs.Num() == 0)
-			{
-				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Blocked;
-			}
-
-			// Cancel production when out of power
-			else if (PowerSystem->GetRemainingEnergy() <= 0)
-			{
-				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::PowerLoss;
-			}
-
-			// Handle explicit stop
-			else if (!MiningRigActive)
-			{
-				MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Stopped;
-			}
-
-			// Proceed with processing
-			else if (MiningRigActive)
-			{
-				// Compute the mining delta
-				MiningRigStatus     = ENovaSpacecraftProcessingSystemStatus::Processing;
-				float ResourceDelta = GetCurrentMiningRate() * (FinalTime - InitialTime).AsSeconds();
-				ResourceDelta       = FMath::Min(ResourceDelta, TotalProcessingLeft);
-				if (ResourceDelta > 0)
-				{
-					auto ProcessOutput = [this, &ResourceDelta, &CargoSlotCapacities](FNovaSpacecraftCargo* Cargo, bool AcceptEmpty)
-					{
-						float LocalResourceDelta = FMath::Min(ResourceDelta, CargoSlotCapacities[Cargo] - Cargo->Amount);
-						if (LocalResourceDelta > 0 && (Cargo->Resource == MiningRigResource || (Cargo->Resource == nullptr && AcceptEmpty)))
-						{
-							Cargo->Resource = MiningRigResource;
-							Cargo->Amount += LocalResourceDelta;
-
-							ResourceDelta = FMath::Max(ResourceDelta - LocalResourceDelta, 0);
-						}
-					};
-
-					for (FNovaSpacecraftCargo* Output : CurrentOutputs)
-					{
-						ProcessOutput(Output, false);
-					}
-
-					if (ResourceDelta > 0)
-					{
-						for (FNovaSpacecraftCargo* Output : CurrentOutputs)
-						{
-							ProcessOutput(Output, true);
-						}
-					}
-
-					NCHECK(ResourceDelta == 0);
-
-					// Compute remaining time for simulation purposes
-					const FNovaTime TotalMiningTimeRemaining = FNovaTime::FromSeconds(TotalProcessingLeft / GetCurrentMiningRate());
-					if (RemainingProductionTime < FLT_MAX)
-					{
-						RemainingProductionTime = FMath::Max(RemainingProductionTime, TotalMiningTimeRemaining);
-					}
-					else
-					{
-						RemainingProductionTime = TotalMiningTimeRemaining;
-					}
-
-					// NLOG("%.2f minutes remaining, min %.2f, processing %.2f", TotalMiningTimeRemaining.AsMinutes(), TotalProcessingLeft,
-					//	(FinalTime - InitialTime).AsMinutes());
+					// NLOG("%.2f minutes remaining, min %.2f, processing %.2f", TotalMiningTimeRemaining.AsMinutes(), TotalProcessingLeft,
+					//	(FinalTime - InitialTime).AsMinutes());
 				}
 			}
 		}
@@ -615,12 +242,6 @@ void UNovaSpacecraftProcessingSystem::Update(FNovaTime InitialTime, FNovaTime Fi
 			MiningRigStatus = ENovaSpacecraftProcessingSystemStatus::Stopped;
 		}
 	}
-
-	// Account for the time we're literally in the process of simulating
-	if (RemainingProductionTime < FLT_MAX)
-	{
-		RemainingProductionTime -= (FinalTime - InitialTime);
-	}
 }
 
 TArray<ENovaSpacecraftProcessingSystemStatus> UNovaSpacecraftProcessingSystem::GetProcessingGroupStatus(int32 ProcessingGroupIndex) const
@@ -786,9 +407,14 @@ int32 UNovaSpacecraftProcessingSystem::GetProcessingGroupPowerUsage(int32 Proces
 {
 	NCHECK(ProcessingGroupIndex >= 0 && ProcessingGroupIndex < ProcessingGroupsStates.Num());
 
+	return GetGroupPowerUsage(ProcessingGroupsStates[ProcessingGroupIndex], FilterByActive);
+}
+
+int32 UNovaSpacecraftProcessingSystem::GetGroupPowerUsage(const FNovaSpacecraftProcessingSystemGroupState& GroupState, bool FilterByActive)
+{
 	int32 Power = 0;
 
-	for (const auto& ChainState : ProcessingGroupsStates[ProcessingGroupIndex].Chains)
+	for (const auto& ChainState : GroupState.Chains)
 	{
 		if (FilterByActive == false || ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Processing)
 		{
@@ -802,6 +428,409 @@ int32 UNovaSpacecraftProcessingSystem::GetProcessingGroupPowerUsage(int32 Proces
 	return Power;
 }
 
+/*----------------------------------------------------
+    Data-oriented processing
+----------------------------------------------------*/
+
+void UNovaSpacecraftProcessingSystem::BuildProcessingGroups(
+	const FNovaSpacecraft& Spacecraft, TArray<FNovaSpacecraftProcessingSystemGroupState>& GroupStates)
+{
+	GroupStates.Empty();
+	for (const FNovaModuleGroup& Group : Spacecraft.GetModuleGroups())
+	{
+		// Find out potential mining rig
+		const UNovaMiningEquipmentDescription* MiningRig = nullptr;
+		for (const FNovaModuleGroupCompartment& GroupCompartment : Group.Compartments)
+		{
+			const FNovaCompartment& Compartment = Spacecraft.Compartments[GroupCompartment.CompartmentIndex];
+			for (FName EquipmentSlotName : GroupCompartment.LinkedEquipments)
+			{
+				const UNovaMiningEquipmentDescription* MiningRigCandidate =
+					Cast<UNovaMiningEquipmentDescription>(Compartment.GetEquipmentySocket(EquipmentSlotName));
+				if (MiningRigCandidate)
+				{
+					MiningRig = MiningRigCandidate;
+					break;
+				}
+			}
+		}
+
+		// Find all processing modules
+		TArray<FNovaSpacecraftProcessingSystemChainStateModule> ProcessingModules;
+		for (const auto& CompartmentModuleIndex : Spacecraft.GetAllModules<UNovaProcessingModuleDescription>(Group))
+		{
+			const FNovaCompartment& Compartment = Spacecraft.Compartments[CompartmentModuleIndex.Key];
+
+			FNovaSpacecraftProcessingSystemChainStateModule Entry;
+			Entry.Module           = Cast<UNovaProcessingModuleDescription>(Compartment.Modules[CompartmentModuleIndex.Value].Description);
+			Entry.CompartmentIndex = CompartmentModuleIndex.Key;
+			Entry.ModuleIndex      = CompartmentModuleIndex.Value;
+
+			ProcessingModules.Add(Entry);
+		}
+
+		// Merge modules into chains
+		TArray<FNovaSpacecraftProcessingSystemChainState> ProcessingChains;
+		for (auto It = ProcessingModules.CreateIterator(); It; ++It)
+		{
+			const UNovaProcessingModuleDescription* Module = It->Module;
+
+			// Find out whether an already merged chain has valid inputs that this modules provides as output, or vice versa
+			FNovaSpacecraftProcessingSystemChainState* ChainState = ProcessingChains.FindByPredicate(
+				[Module](const FNovaSpacecraftProcessingSystemChainState& Chain)
+				{
+					for (const UNovaResource* Resource : Module->Inputs)
+					{
+						if (Chain.Outputs.Contains(Resource))
+						{
+							return true;
+						}
+					}
+
+					for (const UNovaResource* Resource : Module->Outputs)
+					{
+						if (Chain.Inputs.Contains(Resource))
+						{
+							return true;
+						}
+					}
+
+					return false;
+				});
+
+			// Update the chain with the current module
+			if (ChainState)
+			{
+				ChainState->Modules.Add(*It);
+
+				// For each new output, either consume an input, or add it
+				for (const UNovaResource* Resource : Module->Outputs)
+				{
+					if (ChainState->Inputs.Contains(Resource))
+					{
+						ChainState->Inputs.RemoveSingle(Resource);
+					}
+					else
+					{
+						ChainState->Outputs.Add(Resource);
+					}
+				}
+
+				// For each new input, either consume an output, or add it
+				for (const UNovaResource* Resource : Module->Inputs)
+				{
+					if (ChainState->Outputs.Contains(Resource))
+					{
+						ChainState->Outputs.RemoveSingle(Resource);
+					}
+					else
+					{
+						ChainState->Inputs.Add(Resource);
+					}
+				}
+			}
+
+			// Else, add the module as a new chain
+			else
+			{
+				FNovaSpacecraftProcessingSystemChainState NewChainState;
+
+				NewChainState.Inputs         = Module->Inputs;
+				NewChainState.Outputs        = Module->Outputs;
+				NewChainState.ProcessingRate = Module->ProcessingRate;
+				NewChainState.Modules.Add(*It);
+
+				ProcessingChains.Add(NewChainState);
+			}
+
+			It.RemoveCurrent();
+		}
+
+		// Initialize the processing group and compute the processing rate
+		if (ProcessingChains.Num() || MiningRig)
+		{
+			FNovaSpacecraftProcessingSystemGroupState GroupState(Group.Index);
+			for (FNovaSpacecraftProcessingSystemChainState& ChainState : ProcessingChains)
+			{
+				if (ChainState.Modules.Num())
+				{
+					NCHECK(ChainState.Inputs.Num());
+					NCHECK(ChainState.Outputs.Num());
+
+					ChainState.ProcessingRate = ChainState.Modules[0].Module->ProcessingRate;
+					for (const FNovaSpacecraftProcessingSystemChainStateModule& ModuleEntry : ChainState.Modules)
+					{
+						ChainState.ProcessingRate = FMath::Min(ChainState.ProcessingRate, ModuleEntry.Module->ProcessingRate);
+					}
+
+					// Precompute the chain topology
+					auto AddResource = [](TArray<FNovaSpacecraftProcessingSystemChainResource>& Resources, const UNovaResource* Resource)
+					{
+						FNovaSpacecraftProcessingSystemChainResource* Entry = Resources.FindByPredicate(
+							[Resource](const FNovaSpacecraftProcessingSystemChainResource& Candidate)
+							{
+								return Candidate.Resource == Resource;
+							});
+
+						if (Entry)
+						{
+							Entry->Count++;
+						}
+						else
+						{
+							Resources.Add({Resource, 1});
+						}
+					};
+					for (const UNovaResource* Resource : ChainState.Inputs)
+					{
+						AddResource(ChainState.InputResources, Resource);
+					}
+					for (const UNovaResource* Resource : ChainState.Outputs)
+					{
+						AddResource(ChainState.OutputResources, Resource);
+					}
+
+					GroupState.Chains.Add(ChainState);
+				}
+			}
+
+			// Precompute the cargo slots
+			GroupState.MinCargoCapacity = TNumericLimits<float>::Max();
+			for (const auto& Indices : Spacecraft.GetAllModules<UNovaCargoModuleDescription>(Group))
+			{
+				const float CargoCapacity   = Spacecraft.GetCargoCapacity(Indices.Key, Indices.Value);
+				GroupState.MinCargoCapacity = FMath::Min(GroupState.MinCargoCapacity, CargoCapacity);
+				GroupState.CargoSlots.Add({Indices.Key, Indices.Value, CargoCapacity});
+			}
+
+			GroupState.MiningRig = MiningRig;
+
+			GroupStates.Add(GroupState);
+		}
+	}
+}
+
+bool UNovaSpacecraftProcessingSystem::UpdateProcessingGroups(const FNovaSpacecraft& Spacecraft,
+	TArray<FNovaSpacecraftProcessingSystemGroupState>& GroupStates, TFunctionRef<FNovaSpacecraftCargo&(int32, int32)> GetCargo,
+	bool IsDocked, FNovaTime PoweredTime, FNovaTime DeltaTime, FNovaTime& RemainingTime)
+{
+	bool HasChangedCargo = false;
+
+	int32 CurrentGroupIndex = 0;
+	for (auto& GroupState : GroupStates)
+	{
+		for (auto& ChainState : GroupState.Chains)
+		{
+			if (IsDocked)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Docked;
+				continue;
+			}
+
+			// Start production based on input
+			if (!GroupState.Active)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Stopped;
+			}
+			else if (ChainState.Status == ENovaSpacecraftProcessingSystemStatus::Stopped)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Processing;
+			}
+			if (ChainState.Status != ENovaSpacecraftProcessingSystemStatus::Processing)
+			{
+				continue;
+			}
+
+			// Sum the available input amounts and output space for each resource, identify empty slots
+			TArray<float, TInlineAllocator<8>> InputAmounts;
+			TArray<float, TInlineAllocator<8>> OutputSpaces;
+			InputAmounts.SetNumZeroed(ChainState.InputResources.Num());
+			OutputSpaces.SetNumZeroed(ChainState.OutputResources.Num());
+			int32 EmptyOutputSlotCount = 0;
+			for (const FNovaSpacecraftProcessingSystemCargoSlot& Slot : GroupState.CargoSlots)
+			{
+				const FNovaSpacecraftCargo& Cargo = GetCargo(Slot.CompartmentIndex, Slot.ModuleIndex);
+
+				const int32 InputIndex  = Cargo.Resource ? FindChainResource(ChainState.InputResources, Cargo.Resource) : INDEX_NONE;
+				const int32 OutputIndex = FindChainResource(ChainState.OutputResources, Cargo.Resource);
+				if (InputIndex != INDEX_NONE && Cargo.Amount > 0)
+				{
+					InputAmounts[InputIndex] += Cargo.Amount;
+				}
+				else if ((OutputIndex != INDEX_NONE || Cargo.Resource == nullptr) && Cargo.Amount < Slot.Capacity)
+				{
+					if (Cargo.Resource)
+					{
+						OutputSpaces[OutputIndex] += Slot.Capacity - Cargo.Amount;
+					}
+					else
+					{
+						EmptyOutputSlotCount++;
+					}
+				}
+			}
+
+			// Check inputs, and outputs that can use an empty slot if they have none
+			bool  HasMissingResource  = false;
+			int32 RemainingEmptySlots = EmptyOutputSlotCount;
+			for (int32 InputIndex = 0; InputIndex < InputAmounts.Num(); InputIndex++)
+			{
+				HasMissingResource |= InputAmounts[InputIndex] <= 0;
+			}
+			for (int32 OutputIndex = 0; OutputIndex < OutputSpaces.Num() && !HasMissingResource; OutputIndex++)
+			{
+				if (OutputSpaces[OutputIndex] <= 0)
+				{
+					HasMissingResource = RemainingEmptySlots == 0;
+					RemainingEmptySlots--;
+				}
+			}
+
+			if (HasMissingResource)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Blocked;
+				NLOG("UNovaSpacecraftProcessingSystem::Update : blocked production for group %d", CurrentGroupIndex);
+				continue;
+			}
+
+			// Cancel production when out of power
+			if (PoweredTime <= FNovaTime())
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::PowerLoss;
+				NLOG("UNovaSpacecraftProcessingSystem::Update : power loss for group %d", CurrentGroupIndex);
+				continue;
+			}
+
+			// Attribute empty slots to the outputs with the least space
+			for (int32 SlotIndex = 0; SlotIndex < EmptyOutputSlotCount; SlotIndex++)
+			{
+				int32 SmallestOutputIndex = INDEX_NONE;
+				for (int32 OutputIndex = 0; OutputIndex < OutputSpaces.Num(); OutputIndex++)
+				{
+					if (SmallestOutputIndex == INDEX_NONE || OutputSpaces[OutputIndex] < OutputSpaces[SmallestOutputIndex])
+					{
+						SmallestOutputIndex = OutputIndex;
+					}
+				}
+
+				if (SmallestOutputIndex != INDEX_NONE)
+				{
+					OutputSpaces[SmallestOutputIndex] += GroupState.MinCargoCapacity;
+				}
+			}
+
+			// Find when the chain blocks on inputs or outputs, with each module consuming or producing at the chain rate
+			double BlockingTime = DBL_MAX;
+			for (int32 InputIndex = 0; InputIndex < InputAmounts.Num(); InputIndex++)
+			{
+				const double Rate = ChainState.InputResources[InputIndex].Count * ChainState.ProcessingRate;
+				BlockingTime      = FMath::Min(BlockingTime, InputAmounts[InputIndex] / Rate);
+			}
+			for (int32 OutputIndex = 0; OutputIndex < OutputSpaces.Num(); OutputIndex++)
+			{
+				const double Rate = ChainState.OutputResources[OutputIndex].Count * ChainState.ProcessingRate;
+				BlockingTime      = FMath::Min(BlockingTime, OutputSpaces[OutputIndex] / Rate);
+			}
+
+			// Process the entire interval at once, up to the first blocking event
+			const double ProcessingTime = FMath::Min3(DeltaTime.AsSeconds(), PoweredTime.AsSeconds(), BlockingTime);
+			const float  ResourceDelta  = ChainState.ProcessingRate * ProcessingTime;
+			bool         HasFullOutput  = false;
+			if (ResourceDelta > 0)
+			{
+				HasChangedCargo = true;
+
+				// Process outputs, prefer existing resource
+				for (const FNovaSpacecraftProcessingSystemChainResource& Output : ChainState.OutputResources)
+				{
+					float CurrentDelta = Output.Count * ResourceDelta;
+					for (int32 Pass = 0; Pass < 2 && CurrentDelta > 0; Pass++)
+					{
+						for (const FNovaSpacecraftProcessingSystemCargoSlot& Slot : GroupState.CargoSlots)
+						{
+							FNovaSpacecraftCargo& Cargo = GetCargo(Slot.CompartmentIndex, Slot.ModuleIndex);
+							if (Cargo.Resource == Output.Resource || (Cargo.Resource == nullptr && Pass == 1))
+							{
+								const float LocalResourceDelta = FMath::Min(CurrentDelta, Slot.Capacity - Cargo.Amount);
+								if (LocalResourceDelta > 0)
+								{
+									Cargo.Resource = Output.Resource;
+									Cargo.Amount += LocalResourceDelta;
+									CurrentDelta -= LocalResourceDelta;
+								}
+							}
+						}
+					}
+
+					// Output space was checked above, so only rounding errors should remain
+					NCHECK(CurrentDelta < ENovaConstants::ResourceQuantityThreshold);
+					HasFullOutput |= CurrentDelta >= ENovaConstants::ResourceQuantityThreshold;
+				}
+
+				// Process inputs
+				for (const FNovaSpacecraftProcessingSystemChainResource& Input : ChainState.InputResources)
+				{
+					float CurrentDelta = Input.Count * ResourceDelta;
+					for (const FNovaSpacecraftProcessingSystemCargoSlot& Slot : GroupState.CargoSlots)
+					{
+						FNovaSpacecraftCargo& Cargo = GetCargo(Slot.CompartmentIndex, Slot.ModuleIndex);
+						if (Cargo.Resource == Input.Resource && CurrentDelta > 0)
+						{
+							const float LocalResourceDelta = FMath::Min(CurrentDelta, Cargo.Amount);
+
+							Cargo.Amount -= LocalResourceDelta;
+							if (Cargo.Amount < ENovaConstants::ResourceQuantityThreshold)
+							{
+								Cargo.Resource = nullptr;
+								Cargo.Amount   = 0;
+							}
+
+							CurrentDelta -= LocalResourceDelta;
+						}
+					}
+
+					NCHECK(CurrentDelta < ENovaConstants::ResourceQuantityThreshold);
+				}
+			}
+
+			// Stop chains that ran out during the interval, or report how long they can keep going
+			if (BlockingTime <= ProcessingTime || HasFullOutput)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::Blocked;
+				NLOG("UNovaSpacecraftProcessingSystem::Update : blocked production for group %d", CurrentGroupIndex);
+			}
+			else if (PoweredTime.AsSeconds() <= ProcessingTime && PoweredTime < DeltaTime)
+			{
+				ChainState.Status = ENovaSpacecraftProcessingSystemStatus::PowerLoss;
+				NLOG("UNovaSpacecraftProcessingSystem::Update : power loss for group %d", CurrentGroupIndex);
+			}
+			else
+			{
+				const FNovaTime ChainTimeRemaining = FNovaTime::FromSeconds(BlockingTime - ProcessingTime);
+				RemainingTime = RemainingTime < FLT_MAX ? FMath::Max(RemainingTime, ChainTimeRemaining) : ChainTimeRemaining;
+			}
+		}
+
+		CurrentGroupIndex++;
+	}
+
+	return HasChangedCargo;
+}
+
+int32 UNovaSpacecraftProcessingSystem::FindChainResource(
+	const TArray<FNovaSpacecraftProcessingSystemChainResource>& Resources, const UNovaResource* Resource)
+{
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		if (Resources[Index].Resource == Resource)
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
 /*----------------------------------------------------
     Networking
 ----------------------------------------------------*/
@@ -49,6 +49,21 @@ struct FNovaSpacecraftProcessingSystemChainStateModule
 	int32 ModuleIndex;
 };
 
+/** Resource consumed or produced by a chain, with the number of modules doing so */
+struct FNovaSpacecraftProcessingSystemChainResource
+{
+	const class UNovaResource* Resource;
+	int32                      Count;
+};
+
+/** Cargo slot available to a processing group */
+struct FNovaSpacecraftProcessingSystemCargoSlot
+{
+	int32 CompartmentIndex;
+	int32 ModuleIndex;
+	float Capacity;
+};
+
 /** Processing state for a chain */
 USTRUCT()
 struct FNovaSpacecraftProcessingSystemChainState
@@ -77,6 +92,10 @@ struct FNovaSpacecraftProcessingSystemChainState
 	// Replicated module list
 	UPROPERTY()
 	TArray<FNovaSpacecraftProcessingSystemChainStateModule> Modules;
+
+	// Unique inputs and outputs with their multiplicity, built with the modules
+	TArray<FNovaSpacecraftProcessingSystemChainResource> InputResources;
+	TArray<FNovaSpacecraftProcessingSystemChainResource> OutputResources;
 };
 
 /** Processing state for a full module group */
@@ -85,10 +104,10 @@ struct FNovaSpacecraftProcessingSystemGroupState
 {
 	GENERATED_BODY();
 
-	FNovaSpacecraftProcessingSystemGroupState() : GroupIndex(-1), Active(false), MiningRig(nullptr)
+	FNovaSpacecraftProcessingSystemGroupState() : GroupIndex(-1), Active(false), MiningRig(nullptr), MinCargoCapacity(0)
 	{}
 
-	FNovaSpacecraftProcessingSystemGroupState(int32 Index) : GroupIndex(Index), Active(false), MiningRig(nullptr)
+	FNovaSpacecraftProcessingSystemGroupState(int32 Index) : GroupIndex(Index), Active(false), MiningRig(nullptr), MinCargoCapacity(0)
 	{}
 
 	// Module group index
@@ -106,6 +125,10 @@ struct FNovaSpacecraftProcessingSystemGroupState
 	// Mining rig
 	UPROPERTY()
 	const class UNovaMiningEquipmentDescription* MiningRig;
+
+	// Cargo slots of the group, built with the modules
+	TArray<FNovaSpacecraftProcessingSystemCargoSlot> CargoSlots;
+	float                                            MinCargoCapacity;
 };
 
 /** Resource processing system that transforms resources */
@@ -358,6 +381,26 @@ public:
 	/** Get the crew count for a processing group, either total or active */
 	int32 GetProcessingGroupCrew(int32 ProcessingGroupIndex, bool FilterByActive) const;
 
+	/*----------------------------------------------------
+	    Data-oriented processing
+	----------------------------------------------------*/
+
+	/** Build the processing groups for a spacecraft, which needs up-to-date module groups */
+	static void BuildProcessingGroups(const FNovaSpacecraft& Spacecraft, TArray<FNovaSpacecraftProcessingSystemGroupState>& GroupStates);
+
+	/** Run processing groups over DeltaTime in one evaluation using cargo slots from GetCargo, with power lasting PoweredTime.
+	 * Return true if cargo was modified, and the longest time running chains can still process after DeltaTime in RemainingTime. */
+	static bool UpdateProcessingGroups(const FNovaSpacecraft& Spacecraft, TArray<FNovaSpacecraftProcessingSystemGroupState>& GroupStates,
+		TFunctionRef<FNovaSpacecraftCargo&(int32, int32)> GetCargo, bool IsDocked, FNovaTime PoweredTime, FNovaTime DeltaTime,
+		FNovaTime& RemainingTime);
+
+	/** Get the power usage for a processing group state, either total or active */
+	static int32 GetGroupPowerUsage(const FNovaSpacecraftProcessingSystemGroupState& GroupState, bool FilterByActive);
+
+	/** Find a resource in a chain's precomputed inputs or outputs */
+	static int32 FindChainResource(
+		const TArray<FNovaSpacecraftProcessingSystemChainResource>& Resources, const class UNovaResource* Resource);
+
 	/*----------------------------------------------------
 	    Data
 	----------------------------------------------------*/
@@ -40,23 +40,9 @@ void UNovaSpacecraftPropellantSystem::Update(FNovaTime InitialTime, FNovaTime Fi
 		const FNovaTrajectory* Trajectory = Simulation->GetSpacecraftTrajectory(Identifier);
 		if (Trajectory)
 		{
-			PropellantMass = InitialPropellantMass;
-
-			for (const FNovaManeuver& Maneuver : Trajectory->Maneuvers)
-			{
-				FNovaTime ManeuverEndTime          = FMath::Min(Maneuver.Time + Maneuver.Duration, FinalTime);
-				FNovaTime AdjustedManeuverDuration = ManeuverEndTime - Maneuver.Time;
-				double    DeltaTimeSeconds         = AdjustedManeuverDuration.AsSeconds();
-
-				if (DeltaTimeSeconds > 0)
-				{
-					int32 SpacecraftIndex = Simulation->GetSpacecraftTrajectoryIndex(Identifier);
-					NCHECK(SpacecraftIndex != INDEX_NONE && SpacecraftIndex >= 0 && SpacecraftIndex < Maneuver.ThrustFactors.Num());
-
-					PropellantRate = PropulsionMetrics->PropellantRate * Maneuver.ThrustFactors[SpacecraftIndex];
-					PropellantMass -= PropellantRate * DeltaTimeSeconds;
-				}
-			}
+			int32 SpacecraftIndex = Simulation->GetSpacecraftTrajectoryIndex(Identifier);
+			PropellantMass =
+				ComputePropellantMass(*Trajectory, SpacecraftIndex, *PropulsionMetrics, InitialPropellantMass, FinalTime, PropellantRate);
 #if 0
 			NLOG("PropellantRate %f, InitialPropellantMass %f, PropellantMass %f", PropellantRate, InitialPropellantMass, PropellantMass);
 #endif
@@ -66,6 +52,34 @@ void UNovaSpacecraftPropellantSystem::Update(FNovaTime InitialTime, FNovaTime Fi
 	}
 }
 
+/*----------------------------------------------------
+    Data-oriented propellant
+----------------------------------------------------*/
+
+float UNovaSpacecraftPropellantSystem::ComputePropellantMass(const FNovaTrajectory& Trajectory, int32 SpacecraftIndex,
+	const FNovaSpacecraftPropulsionMetrics& PropulsionMetrics, float InitialMass, FNovaTime FinalTime, float& CurrentRate)
+{
+	float CurrentMass = InitialMass;
+	CurrentRate       = 0;
+
+	for (const FNovaManeuver& Maneuver : Trajectory.Maneuvers)
+	{
+		FNovaTime ManeuverEndTime          = FMath::Min(Maneuver.Time + Maneuver.Duration, FinalTime);
+		FNovaTime AdjustedManeuverDuration = ManeuverEndTime - Maneuver.Time;
+		double    DeltaTimeSeconds         = AdjustedManeuverDuration.AsSeconds();
+
+		if (DeltaTimeSeconds > 0)
+		{
+			NCHECK(SpacecraftIndex != INDEX_NONE && SpacecraftIndex >= 0 && SpacecraftIndex < Maneuver.ThrustFactors.Num());
+
+			CurrentRate = PropulsionMetrics.PropellantRate * Maneuver.ThrustFactors[SpacecraftIndex];
+			CurrentMass -= CurrentRate * DeltaTimeSeconds;
+		}
+	}
+
+	return CurrentMass;
+}
+
 void UNovaSpacecraftPropellantSystem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -83,6 +83,14 @@ public:
 		}
 	}
 
+	/*----------------------------------------------------
+	    Data-oriented propellant
+	----------------------------------------------------*/
+
+	/** Compute the propellant mass left at FinalTime after flying Trajectory from InitialMass, and the current mass rate in T/s */
+	static float ComputePropellantMass(const struct FNovaTrajectory& Trajectory, int32 SpacecraftIndex,
+		const FNovaSpacecraftPropulsionMetrics& PropulsionMetrics, float InitialMass, FNovaTime FinalTime, float& CurrentRate);
+
 	/*----------------------------------------------------
 	    Data
 	----------------------------------------------------*/
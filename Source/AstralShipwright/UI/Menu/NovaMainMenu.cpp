@@ -11,6 +11,7 @@
 #include "NovaMainMenuSettings.h"
 
 #include "Game/NovaGameState.h"
+#include "Game/NovaSaveData.h"
 #include "Player/NovaPlayerController.h"
 
 #include "Spacecraft/NovaSpacecraftPawn.h"
@@ -19,7 +20,6 @@
 #include "Nova.h"
 
 #include "Neutron/System/NeutronMenuManager.h"
-#include "Neutron/System/NeutronSaveManager.h"
 #include "Neutron/UI/Widgets/NeutronButton.h"
 #include "Neutron/UI/Widgets/NeutronFadingWidget.h"
 #include "Neutron/UI/Widgets/NeutronKeyLabel.h"
@@ -462,7 +462,7 @@ void SNovaMainMenu::OnClose()
 		// Ship is not docked, some progress will be lost
 		else
 		{
-			double MinutesSinceLastSave = UNeutronSaveManager::Get()->GetMinutesSinceLastSave();
+			double MinutesSinceLastSave = FNovaSaveArchive::GetMinutesSinceLastSave();
 
 			ModalPanel->Show(LOCTEXT("ConfirmQuitWithoutSaving", "Quit without saving ?"),
 				FText::FormatNamed(LOCTEXT("ConfirmQuitWithoutSavingHelp",
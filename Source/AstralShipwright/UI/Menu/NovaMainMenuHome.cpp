@@ -4,6 +4,7 @@
 
 #include "NovaMainMenu.h"
 
+#include "Game/NovaSaveData.h"
 #include "Player/NovaPlayerController.h"
 #include "UI/Widgets/NovaLargeButton.h"
 
@@ -11,7 +12,6 @@
 
 #include "Neutron/Player/NeutronPlayerController.h"
 #include "Neutron/System/NeutronMenuManager.h"
-#include "Neutron/System/NeutronSaveManager.h"
 #include "Neutron/UI/Widgets/NeutronModalPanel.h"
 
 #include "Widgets/Layout/SBackgroundBlur.h"
@@ -337,7 +337,7 @@ void SNovaMainMenuHome::OnDeleteGame(uint32 Index)
 		FSimpleDelegate::CreateLambda(
 			[this, Index]()
 			{
-				UNeutronSaveManager::Get()->DeleteGame(FString::FromInt(Index));
+				FNovaSaveArchive::DeleteGame(FString::FromInt(Index));
 			}));
 }
 
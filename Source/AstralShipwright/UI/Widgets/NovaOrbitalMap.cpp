@@ -105,6 +105,8 @@ void SNovaOrbitalMap::Construct(const FArguments& InArgs)
 
 void SNovaOrbitalMap::Tick(const FGeometry& AllottedGeometry, const double CurrentTime, const float DeltaTime)
 {
+	NOVA_SCOPE_CYCLE_COUNTER(STAT_NovaOrbitalMap);
+
 	SCompoundWidget::Tick(AllottedGeometry, CurrentTime, DeltaTime);
 
 	// Debug data
@@ -113,7 +115,8 @@ void SNovaOrbitalMap::Tick(const FGeometry& AllottedGeometry, const double Curre
 	// Reset state
 	ClearBatches();
 	CurrentDesiredSize = 100;
-	HoveredOrbitalObjects.Empty();
+	HoveredOrbitalObjects.Reset();
+	HoveredObjectSet.Reset();
 
 	// Integrate analog input
 	const double    PositionFreedom = 1.0;
@@ -123,6 +126,12 @@ void SNovaOrbitalMap::Tick(const FGeometry& AllottedGeometry, const double Curre
 	CurrentPosition.Y = FMath::Clamp(CurrentPosition.Y, PositionFreedom * -HalfLocalSize.Y, PositionFreedom * HalfLocalSize.Y);
 	CurrentOrigin     = HalfLocalSize + CurrentPosition;
 
+	// Compute the visible area in map space, and the hover position, once for all objects
+	CurrentVisibleBounds = FBox2D(-CurrentOrigin, 2 * HalfLocalSize - CurrentOrigin);
+	CurrentHoverPosition = MenuManager->IsUsingGamepad()
+	                         ? HalfLocalSize
+	                         : GetTickSpaceGeometry().AbsoluteToLocal(FSlateApplication::Get().GetCursorPos());
+
 	// Step the preview simulation
 	UNovaOrbitalSimulationComponent* OrbitalSimulation = UNovaOrbitalSimulationComponent::Get(MenuManager.Get());
 	if (CurrentPreviewTrajectory.IsValid())
@@ -154,7 +163,7 @@ void SNovaOrbitalMap::Tick(const FGeometry& AllottedGeometry, const double Curre
 		Point.Color = FLinearColor::White;
 		Point.Scale = 1.0f;
 		Point.Brush = FNeutronStyleSet::GetBrush("Map/SB_Crosshair");
-		BatchedPoints.AddUnique(Point);
+		BatchedPoints.Add(Point);
 	}
 }
 
@@ -273,24 +282,23 @@ void SNovaOrbitalMap::ProcessAreas(const FVector2D& Origin)
 	{
 		FNovaSplineStyle AsteroidStyle(FLinearColor(1, 1, 1, 0.5f));
 
-		for (const auto AreaAndOrbitalLocation : OrbitalSimulation->GetPreviewAreasLocations())
+		const TNovaOrbitalLocationStore<const UNovaArea*>& AreaLocations = OrbitalSimulation->GetPreviewAreasLocations();
+		for (int32 Index = 0; Index < AreaLocations.Num(); Index++)
 		{
-			const FNovaOrbitalLocation& OrbitalLocation = AreaAndOrbitalLocation.Value;
+			const FNovaOrbitalLocation& OrbitalLocation = AreaLocations.GetLocation(Index);
 			const FNovaOrbitGeometry&   Geometry        = OrbitalLocation.Geometry;
 
 			UpdateDesiredSize(Geometry.GetHighestAltitude());
 
 			float              BaseAltitude = GetObjectBaseAltitude(Geometry.Body);
 			FNovaOrbitalObject AreaObject =
-				FNovaOrbitalObject(AreaAndOrbitalLocation.Key, OrbitalLocation.GetCartesianLocation(BaseAltitude));
+				FNovaOrbitalObject(AreaLocations.GetKey(Index), OrbitalLocation.GetCartesianLocation(BaseAltitude));
 
 			if (ShouldDisplayObject(AreaObject))
 			{
 				if (CurrentPreviewTrajectory.IsValid())
 				{
-					TArray<FNovaOrbitalObject> Objects;
-					Objects.Add(AreaObject);
-					AddOrbit(Origin, nullptr, OrbitalLocation.Geometry, Objects, AsteroidStyle);
+					AddOrbit(Origin, nullptr, OrbitalLocation.Geometry, MakeArrayView(&AreaObject, 1), AsteroidStyle);
 				}
 				else
 				{
@@ -306,30 +314,67 @@ void SNovaOrbitalMap::ProcessAsteroids(const FVector2D& Origin)
 	UNovaOrbitalSimulationComponent* OrbitalSimulation = UNovaOrbitalSimulationComponent::Get(MenuManager.Get());
 	if (IsValid(OrbitalSimulation))
 	{
-		FNovaSplineStyle AreaStyle(FLinearColor(1, 1, 1, 0.5f));
+		FNovaSplineStyle   AreaStyle(FLinearColor(1, 1, 1, 0.5f));
+		const FSlateBrush* AsteroidBrush = FNeutronStyleSet::GetBrush("Map/SB_Asteroid");
+
+		const TNovaOrbitalLocationStore<FGuid>& AsteroidLocations = OrbitalSimulation->GetPreviewAsteroidsLocations();
+
+		// Previews draw orbits for the few relevant asteroids, otherwise asteroids are retained points indexed like the store
+		if (CurrentPreviewTrajectory.IsValid())
+		{
+			RetainedAsteroidPoints.Reset();
+		}
+		else
+		{
+			RetainedAsteroidPoints.SetNum(AsteroidLocations.Num(), false);
+		}
 
-		for (const auto AsteroidAndOrbitalLocation : OrbitalSimulation->GetPreviewAsteroidsLocations())
+		for (int32 Index = 0; Index < AsteroidLocations.Num(); Index++)
 		{
-			const FNovaOrbitalLocation& OrbitalLocation = AsteroidAndOrbitalLocation.Value;
+			const FNovaOrbitalLocation& OrbitalLocation = AsteroidLocations.GetLocation(Index);
 			const FNovaOrbitGeometry&   Geometry        = OrbitalLocation.Geometry;
 
 			UpdateDesiredSize(Geometry.GetHighestAltitude());
 
-			float              BaseAltitude = GetObjectBaseAltitude(Geometry.Body);
-			FNovaOrbitalObject AsteroidObject =
-				FNovaOrbitalObject(AsteroidAndOrbitalLocation.Key, OrbitalLocation.GetCartesianLocation(BaseAltitude), true);
+			float BaseAltitude = GetObjectBaseAltitude(Geometry.Body);
 
-			if (ShouldDisplayObject(AsteroidObject))
+			if (CurrentPreviewTrajectory.IsValid())
 			{
-				if (CurrentPreviewTrajectory.IsValid())
+				FNovaOrbitalObject AsteroidObject =
+					FNovaOrbitalObject(AsteroidLocations.GetKey(Index), OrbitalLocation.GetCartesianLocation(BaseAltitude), true);
+
+				if (ShouldDisplayObject(AsteroidObject))
 				{
-					TArray<FNovaOrbitalObject> Objects;
-					Objects.Add(AsteroidObject);
-					AddOrbit(Origin, nullptr, OrbitalLocation.Geometry, Objects, AreaStyle);
+					AddOrbit(Origin, nullptr, OrbitalLocation.Geometry, MakeArrayView(&AsteroidObject, 1), AreaStyle);
 				}
-				else
+			}
+			else
+			{
+				const FVector2D     Position = OrbitalLocation.GetCartesianLocation(BaseAltitude) * CurrentDrawScale;
+				FNovaRetainedPoint& Retained = RetainedAsteroidPoints[Index];
+
+				// Cull before any other work
+				Retained.Visible = IsVisible(Position, AsteroidBrush->GetImageSize().GetMax());
+				if (!Retained.Visible)
+				{
+					continue;
+				}
+
+				// Check for hover
+				const bool IsObjectHovered = IsHovered(Position);
+				if (IsObjectHovered)
 				{
-					AddOrbitalObject(AsteroidObject, AreaStyle.ColorOuter);
+					AddHoveredObject(FNovaOrbitalObject(AsteroidLocations.GetKey(Index), Position, true));
+				}
+
+				// Only rewrite points that moved by a noticeable amount, or changed state
+				const float Scale = IsObjectHovered ? 2.0f : 1.5f;
+				if (!Retained.Point.Pos.Equals(Position, 0.25f) || Retained.Point.Scale != Scale || Retained.Point.Brush != AsteroidBrush)
+				{
+					Retained.Point.Pos   = Position;
+					Retained.Point.Color = AreaStyle.ColorOuter;
+					Retained.Point.Scale = Scale;
+					Retained.Point.Brush = AsteroidBrush;
 				}
 			}
 		}
@@ -351,13 +396,14 @@ void SNovaOrbitalMap::ProcessSpacecraftLocations(const FVector2D& Origin)
 	OrbitStyle.WidthInner = 1;
 
 	// Add the current orbit
-	for (const auto SpacecraftIdentifierAndOrbitalLocation : OrbitalSimulation->GetPreviewSpacecraftLocations())
+	const TNovaOrbitalLocationStore<FGuid>& SpacecraftLocations = OrbitalSimulation->GetPreviewSpacecraftLocations();
+	for (int32 Index = 0; Index < SpacecraftLocations.Num(); Index++)
 	{
-		const FGuid& Identifier = SpacecraftIdentifierAndOrbitalLocation.Key;
+		const FGuid& Identifier = SpacecraftLocations.GetKey(Index);
 
-		if (SpacecraftIdentifierAndOrbitalLocation.Value.Geometry.IsValid())
+		if (SpacecraftLocations.GetLocation(Index).Geometry.IsValid())
 		{
-			const FNovaOrbitalLocation& Location = SpacecraftIdentifierAndOrbitalLocation.Value;
+			const FNovaOrbitalLocation& Location = SpacecraftLocations.GetLocation(Index);
 
 			float              BaseAltitude = GetObjectBaseAltitude(Location.Geometry.Body);
 			FNovaOrbitalObject Object       = FNovaOrbitalObject(Identifier, Location.GetCartesianLocation(BaseAltitude), false);
@@ -470,7 +516,7 @@ void SNovaOrbitalMap::AddPlanet(const FVector2D& Pos, const class UNovaCelestial
 	FNovaBatchedBrush Brush;
 	Brush.Brush = &Planet->Image;
 	Brush.Pos   = Pos * CurrentDrawScale;
-	BatchedBrushes.AddUnique(Brush);
+	BatchedBrushes.Add(Brush);
 }
 
 void SNovaOrbitalMap::AddTrajectory(const FVector2D& Position, const FNovaTrajectory& Trajectory, const FNovaSpacecraft* Spacecraft,
@@ -599,7 +645,7 @@ void SNovaOrbitalMap::AddTrajectory(const FVector2D& Position, const FNovaTrajec
 }
 
 bool SNovaOrbitalMap::AddOrbit(const FVector2D& Position, const TSharedPtr<FVector2D>& StartPosition, const FNovaOrbitGeometry& Geometry,
-	TArray<FNovaOrbitalObject>& Objects, const FNovaSplineStyle& Style, float InitialPhase)
+	TArrayView<const FNovaOrbitalObject> Objects, const FNovaSplineStyle& Style, float InitialPhase)
 {
 	const FVector2D LocalPosition = Position * CurrentDrawScale;
 
@@ -617,6 +663,17 @@ bool SNovaOrbitalMap::AddOrbit(const FVector2D& Position, const TSharedPtr<FVect
 		AddOrbitalObject(Object, Style.ColorOuter);
 	}
 
+	// Skip orbits that can't intersect the visible area, unless they are anchored to a spacecraft
+	if (!StartPosition.IsValid())
+	{
+		const float BoundingRadius = FMath::Max(SemiMajorAxis, SemiMinorAxis) + FMath::Abs(Offset);
+		const float DistanceToView = FMath::Sqrt(CurrentVisibleBounds.ComputeSquaredDistanceToPoint(LocalPosition));
+		if (DistanceToView > BoundingRadius + Style.WidthOuter)
+		{
+			return false;
+		}
+	}
+
 	return AddOrbitInternal(
 		FNovaSplineOrbit(LocalPosition, StartPosition, SemiMajorAxis, SemiMinorAxis, Phase, InitialAngle, AngularLength, Offset), Style);
 }
@@ -625,27 +682,21 @@ void SNovaOrbitalMap::AddOrbitalObject(FNovaOrbitalObject Object, const FLinearC
 {
 	Object.Position *= CurrentDrawScale;
 
-	// Check for hover
-	float HoverRadius = 30;
-	bool  IsObjectHovered;
-	if (MenuManager->IsUsingGamepad())
-	{
-		IsObjectHovered = (CurrentOrigin + Object.Position - GetTickSpaceGeometry().GetLocalSize() / 2).Size() < HoverRadius;
-	}
-	else
+	// Cull before any other work, accounting for the label
+	const FSlateBrush* Brush = Object.GetBrush();
+	if (!IsVisible(Object.Position, Brush->GetImageSize().GetMax() + 32))
 	{
-		IsObjectHovered =
-			(CurrentOrigin + Object.Position - GetTickSpaceGeometry().AbsoluteToLocal(FSlateApplication::Get().GetCursorPos())).Size() <
-			HoverRadius;
+		return;
 	}
 
 	// Add the point
+	const bool        IsObjectHovered = IsHovered(Object.Position);
 	FNovaBatchedPoint Point;
 	Point.Pos   = Object.Position;
 	Point.Color = Color;
 	Point.Scale = IsObjectHovered ? 2.0f : 1.5f;
-	Point.Brush = Object.GetBrush();
-	BatchedPoints.AddUnique(Point);
+	Point.Brush = Brush;
+	BatchedPoints.Add(Point);
 
 	// Add the text
 	if (Object.Area.IsValid())
@@ -661,7 +712,7 @@ void SNovaOrbitalMap::AddOrbitalObject(FNovaOrbitalObject Object, const FLinearC
 
 	if (IsObjectHovered)
 	{
-		HoveredOrbitalObjects.AddUnique(Object);
+		AddHoveredObject(Object);
 	}
 }
 
@@ -748,7 +799,13 @@ bool SNovaOrbitalMap::AddOrbitInternal(const FNovaSplineOrbit& Orbit, const FNov
 		}
 
 		// Batch the spline segment if we haven't done a full circle yet, including partial start & end segments
-		if (RenderedSplineCount < 6)
+		// Segments outside the view are culled, since a spline always lies within the hull of its control points
+		FBox2D SplineBounds(ForceInit);
+		SplineBounds += P0;
+		SplineBounds += P1;
+		SplineBounds += P2;
+		SplineBounds += P3;
+		if (RenderedSplineCount < 6 && SplineBounds.ExpandBy(Style.WidthOuter).Intersect(CurrentVisibleBounds))
 		{
 			FNovaBatchedSpline Spline;
 			Spline.P0         = P0;
@@ -759,7 +816,7 @@ bool SNovaOrbitalMap::AddOrbitInternal(const FNovaSplineOrbit& Orbit, const FNov
 			Spline.ColorOuter = Style.ColorOuter;
 			Spline.WidthInner = Style.WidthInner;
 			Spline.WidthOuter = Style.WidthOuter;
-			BatchedSplines.AddUnique(Spline);
+			BatchedSplines.Add(Spline);
 		}
 
 		RenderedSplineCount++;
@@ -774,10 +831,10 @@ bool SNovaOrbitalMap::AddOrbitInternal(const FNovaSplineOrbit& Orbit, const FNov
 
 void SNovaOrbitalMap::ClearBatches()
 {
-	BatchedSplines.Empty();
-	BatchedPoints.Empty();
-	BatchedBrushes.Empty();
-	BatchedTexts.Empty();
+	BatchedSplines.Reset();
+	BatchedPoints.Reset();
+	BatchedBrushes.Reset();
+	BatchedTexts.Reset();
 }
 
 int32 SNovaOrbitalMap::OnPaint(const FPaintArgs& PaintArgs, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
@@ -824,6 +881,23 @@ int32 SNovaOrbitalMap::OnPaint(const FPaintArgs& PaintArgs, const FGeometry& All
 			Spline.WidthInner * AllottedGeometry.Scale, ESlateDrawEffect::NoPixelSnapping, ColorInner);
 	}
 
+	// Draw retained points
+	for (const FNovaRetainedPoint& Retained : RetainedAsteroidPoints)
+	{
+		if (Retained.Visible)
+		{
+			const FNovaBatchedPoint& Point     = Retained.Point;
+			FVector2D                BrushSize = Point.Brush->GetImageSize() * Point.Scale;
+
+			FLinearColor Color = Point.Color;
+			Color.A            = CurrentAlpha.Get();
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 3,
+				AllottedGeometry.ToPaintGeometry(BrushSize, FSlateLayoutTransform(CurrentOrigin + Point.Pos - BrushSize / 2)), Point.Brush,
+				ESlateDrawEffect::NoPixelSnapping, Color);
+		}
+	}
+
 	// Draw batched points
 	for (const FNovaBatchedPoint& Point : BatchedPoints)
 	{
@@ -24,6 +24,13 @@ struct FNovaBatchedSpline
 		       ColorOuter == Other.ColorOuter && WidthInner == Other.WidthInner && WidthOuter == Other.WidthOuter;
 	}
 
+	friend uint32 GetTypeHash(const FNovaBatchedSpline& Spline)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Spline.P0), GetTypeHash(Spline.P3));
+		Hash        = HashCombine(Hash, HashCombine(GetTypeHash(Spline.P1), GetTypeHash(Spline.P2)));
+		return HashCombine(Hash, GetTypeHash(Spline.ColorOuter));
+	}
+
 	FVector2D    P0;
 	FVector2D    P1;
 	FVector2D    P2;
@@ -42,6 +49,11 @@ struct FNovaBatchedPoint
 		return Pos == Other.Pos && Color == Other.Color && Scale == Other.Scale;
 	}
 
+	friend uint32 GetTypeHash(const FNovaBatchedPoint& Point)
+	{
+		return HashCombine(GetTypeHash(Point.Pos), HashCombine(GetTypeHash(Point.Color), GetTypeHash(Point.Scale)));
+	}
+
 	FVector2D          Pos;
 	FLinearColor       Color;
 	float              Scale;
@@ -56,6 +68,11 @@ struct FNovaBatchedBrush
 		return Pos == Other.Pos && Brush == Other.Brush;
 	}
 
+	friend uint32 GetTypeHash(const FNovaBatchedBrush& Brush)
+	{
+		return HashCombine(GetTypeHash(Brush.Pos), PointerHash(Brush.Brush));
+	}
+
 	FVector2D          Pos;
 	const FSlateBrush* Brush;
 };
@@ -68,6 +85,21 @@ struct FNovaBatchedText
 	const FTextBlockStyle* TextStyle;
 };
 
+/** Retained point that persists across frames and is only rewritten when it changes */
+struct FNovaRetainedPoint
+{
+	FNovaRetainedPoint() : Visible(false)
+	{
+		Point.Pos   = FVector2D::ZeroVector;
+		Point.Color = FLinearColor::Transparent;
+		Point.Scale = 0;
+		Point.Brush = nullptr;
+	}
+
+	FNovaBatchedPoint Point;
+	bool              Visible;
+};
+
 /** Point of interest on the map */
 struct FNovaOrbitalObject
 {
@@ -130,6 +162,12 @@ struct FNovaOrbitalObject
 		return !operator==(Other);
 	}
 
+	friend uint32 GetTypeHash(const FNovaOrbitalObject& Object)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Object.Area), PointerHash(Object.Maneuver.Get()));
+		return HashCombine(Hash, HashCombine(GetTypeHash(Object.AsteroidIdentifier), GetTypeHash(Object.SpacecraftIdentifier)));
+	}
+
 	// Object data
 	TWeakObjectPtr<const class UNovaArea> Area;
 	FGuid                                 AsteroidIdentifier;
@@ -257,7 +295,7 @@ protected:
 
 	/** Draw an orbit */
 	bool AddOrbit(const FVector2D& Position, const TSharedPtr<FVector2D>& StartPosition, const FNovaOrbitGeometry& Geometry,
-		TArray<FNovaOrbitalObject>& Objects, const struct FNovaSplineStyle& Style, float InitialPhase = 0.0f);
+		TArrayView<const FNovaOrbitalObject> Objects, const struct FNovaSplineStyle& Style, float InitialPhase = 0.0f);
 
 	/** Draw an orbit based on processed 2D parameters */
 	bool AddOrbitInternal(const struct FNovaSplineOrbit& Orbit, const struct FNovaSplineStyle& Style);
@@ -265,6 +303,31 @@ protected:
 	/** Draw an interactive orbital object on the map */
 	void AddOrbitalObject(FNovaOrbitalObject Object, const FLinearColor& Color);
 
+	/** Add an object to the hovered list if it wasn't yet */
+	void AddHoveredObject(const FNovaOrbitalObject& Object)
+	{
+		bool IsAlreadyHovered = false;
+		HoveredObjectSet.Add(Object, &IsAlreadyHovered);
+		if (!IsAlreadyHovered)
+		{
+			HoveredOrbitalObjects.Add(Object);
+		}
+	}
+
+	/** Check whether a draw-scaled position is inside the visible area, extended by Margin */
+	bool IsVisible(const FVector2D& Position, float Margin) const
+	{
+		return Position.X >= CurrentVisibleBounds.Min.X - Margin && Position.X <= CurrentVisibleBounds.Max.X + Margin &&
+		       Position.Y >= CurrentVisibleBounds.Min.Y - Margin && Position.Y <= CurrentVisibleBounds.Max.Y + Margin;
+	}
+
+	/** Check whether a draw-scaled position is under the cursor */
+	bool IsHovered(const FVector2D& Position) const
+	{
+		constexpr float HoverRadius = 30;
+		return FVector2D::DistSquared(CurrentOrigin + Position, CurrentHoverPosition) < FMath::Square(HoverRadius);
+	}
+
 	/** Get the base altitude */
 	float GetObjectBaseAltitude(const UNovaCelestialBody* Body) const
 	{
@@ -305,7 +368,7 @@ protected:
 	    Batch renderer
 	----------------------------------------------------*/
 
-	/** Remove all drawing elements */
+	/** Remove all drawing elements, keeping the allocated memory for the next frame */
 	void ClearBatches();
 
 	virtual int32 OnPaint(const FPaintArgs& PaintArgs, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
@@ -337,6 +400,8 @@ protected:
 	FVector2D TargetPosition;
 	FVector2D CurrentPosition;
 	FVector2D CurrentVelocity;
+	FVector2D CurrentHoverPosition;
+	FBox2D    CurrentVisibleBounds;
 
 	// Preview system
 	FNovaTrajectory            CurrentPreviewTrajectory;
@@ -351,10 +416,12 @@ protected:
 
 	// Object system
 	TArray<FNovaOrbitalObject> HoveredOrbitalObjects;
+	TSet<FNovaOrbitalObject>   HoveredObjectSet;
 
 	// Batching system
-	TArray<FNovaBatchedSpline> BatchedSplines;
-	TArray<FNovaBatchedPoint>  BatchedPoints;
-	TArray<FNovaBatchedBrush>  BatchedBrushes;
+	TSet<FNovaBatchedSpline>   BatchedSplines;
+	TSet<FNovaBatchedPoint>    BatchedPoints;
+	TSet<FNovaBatchedBrush>    BatchedBrushes;
 	TArray<FNovaBatchedText>   BatchedTexts;
+	TArray<FNovaRetainedPoint> RetainedAsteroidPoints;
 };
@@ -18,10 +18,27 @@
 #include "Nova.h"
 
 #include "Widgets/Colors/SComplexGradient.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "SNovaTrajectoryCalculator"
 
-static constexpr int32 TrajectoryStartDelay = 2;
+static constexpr int32  TrajectoryStartDelay        = 2;
+static constexpr float  CoarseAltitudeStep          = 50;
+static constexpr float  RefinedAltitudeTolerance    = 0.5f;
+static constexpr double DurationDiscontinuityFactor = 0.25;
+
+/** Compute a trajectory cost at a phasing altitude, rejecting phasing at identical altitudes, for they produce null maneuvers */
+static FNovaTrajectoryCost ComputeCostAtAltitude(
+	const UNovaOrbitalSimulationComponent* OrbitalSimulation, const FNovaTrajectoryParameters& Parameters, float Altitude)
+{
+	if (Altitude != Parameters.DestinationAltitude && Altitude != Parameters.Source.Geometry.StartAltitude &&
+		Altitude != Parameters.Source.Geometry.OppositeAltitude)
+	{
+		return OrbitalSimulation->ComputeTrajectoryCost(Parameters, Altitude);
+	}
+
+	return FNovaTrajectoryCost();
+}
 
 /*----------------------------------------------------
     Construct
@@ -223,36 +240,7 @@ void SNovaTrajectoryCalculator::Tick(const FGeometry& AllottedGeometry, const do
 		{
 			NLOG("SNovaTrajectoryCalculator::Tick : updating trajectories");
 
-			// Generate the gradients
-			TrajectoryDeltaVGradientData.Empty();
-			TrajectoryDurationGradientData.Empty();
-			for (const TPair<float, FNovaTrajectory>& AltitudeAndTrajectory : SimulatedTrajectories)
-			{
-				const FNovaTrajectory& Trajectory = AltitudeAndTrajectory.Value;
-
-				if (Trajectory.IsValidExtended())
-				{
-					auto Transform = [](float Value)
-					{
-						return FMath::LogX(5, Value);
-					};
-
-					double DeltaVAlpha = FMath::Clamp(
-						(Transform(Trajectory.TotalDeltaV) - Transform(MinDeltaV)) / (Transform(MaxDeltaV) - Transform(MinDeltaV)), 0.0f,
-						1.0f);
-					double DurationAlpha = FMath::Clamp((Transform(Trajectory.TotalTravelDuration.AsMinutes()) - Transform(MinDuration)) /
-															(Transform(MaxDuration) - Transform(MinDuration)),
-						0.0f, 1.0f);
-
-					TrajectoryDeltaVGradientData.Add(FNeutronStyleSet::GetViridisColor(DeltaVAlpha));
-					TrajectoryDurationGradientData.Add(FNeutronStyleSet::GetViridisColor(DurationAlpha));
-				}
-				else
-				{
-					TrajectoryDeltaVGradientData.Add(FLinearColor::Black);
-					TrajectoryDurationGradientData.Add(FLinearColor::Black);
-				}
-			}
+			UpdateGradients();
 
 			CurrentTrajectoryDisplayTime = 0;
 			NeedTrajectoryDisplayUpdate  = false;
@@ -293,9 +281,11 @@ void SNovaTrajectoryCalculator::Reset()
 {
 	FLinearColor Translucent = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-	SimulatedTrajectories          = {};
+	SimulatedCosts                 = {};
+	CurrentTrajectory              = FNovaTrajectory();
 	TrajectoryDeltaVGradientData   = {Translucent, Translucent};
 	TrajectoryDurationGradientData = {Translucent, Translucent};
+	TrajectoryParameters.Reset();
 
 	MinDeltaV              = FLT_MAX;
 	MinDeltaVWithTolerance = FLT_MAX;
@@ -320,156 +310,328 @@ void SNovaTrajectoryCalculator::SimulateTrajectories(
 
 	Reset();
 
-	// Run trajectory calculations over a range of altitudes
-	PlayerIdentifiers = SpacecraftIdentifiers;
-	const FNovaTrajectoryParameters& Parameters =
-		OrbitalSimulation->PrepareTrajectory(Source, Destination, FNovaTime::FromMinutes(TrajectoryStartDelay), SpacecraftIdentifiers);
-	SimulatedTrajectories.Reserve((Slider->GetMaxValue() - Slider->GetMinValue()) / AltitudeStep + 1);
-	for (float Altitude = Slider->GetMinValue(); Altitude <= Slider->GetMaxValue(); Altitude += AltitudeStep)
-	{
-		// Reject phasing at identical altitudes, for they produce null maneuvers
-		if (Altitude != Parameters.DestinationAltitude && Altitude != Parameters.Source.Geometry.StartAltitude &&
-			Altitude != Parameters.Source.Geometry.OppositeAltitude)
-		{
-			FNovaTrajectory Trajectory = OrbitalSimulation->ComputeTrajectory(Parameters, Altitude);
-			SimulatedTrajectories.Add(Altitude, Trajectory);
-		}
-		else
-		{
-			SimulatedTrajectories.Add(Altitude, FNovaTrajectory());
-		}
-	}
+	// Prepare the parameters once, with a snapshot of the fleet, so that trajectories can be computed in parallel or on demand
+	PlayerIdentifiers    = SpacecraftIdentifiers;
+	TrajectoryParameters = MakeShared<FNovaTrajectoryParameters>(
+		OrbitalSimulation->PrepareTrajectory(Source, Destination, FNovaTime::FromMinutes(TrajectoryStartDelay), SpacecraftIdentifiers));
+	const FNovaTrajectoryParameters& Parameters = *TrajectoryParameters;
 
-	// Pre-process the trajectory data for absolute minimas and maximas
-	for (const TPair<float, FNovaTrajectory>& AltitudeAndTrajectory : SimulatedTrajectories)
+	// Build a coarse range of altitudes to simulate
+	TArray<float> Altitudes;
+	for (float Altitude = Slider->GetMinValue(); Altitude < Slider->GetMaxValue(); Altitude += CoarseAltitudeStep)
 	{
-		float                  Altitude   = AltitudeAndTrajectory.Key;
-		const FNovaTrajectory& Trajectory = AltitudeAndTrajectory.Value;
+		Altitudes.Add(Altitude);
+	}
+	Altitudes.Add(Slider->GetMaxValue());
 
-		if (Trajectory.IsValidExtended())
+	// Run coarse cost calculations in parallel
+	TArray<FNovaTrajectoryCost> Costs;
+	Costs.SetNum(Altitudes.Num());
+	ParallelFor(Altitudes.Num(),
+		[&](int32 Index)
 		{
-			double TotalTravelDuration = Trajectory.TotalTravelDuration.AsMinutes();
-
-			if (FMath::IsFinite(Trajectory.TotalDeltaV) && FMath::IsFinite(TotalTravelDuration))
-			{
-				if (Trajectory.TotalDeltaV < MinDeltaV)
-				{
-					MinDeltaV = Trajectory.TotalDeltaV;
-				}
-				if (Trajectory.TotalDeltaV > MaxDeltaV)
-				{
-					MaxDeltaV = Trajectory.TotalDeltaV;
-				}
-				if (TotalTravelDuration < MinDuration)
-				{
-					MinDuration         = TotalTravelDuration;
-					MinDurationAltitude = Altitude;
-				}
-				if (TotalTravelDuration > MaxDuration)
-				{
-					MaxDuration = TotalTravelDuration;
-				}
-			}
-		}
+			Costs[Index] = ComputeCostAtAltitude(OrbitalSimulation, Parameters, Altitudes[Index]);
+		});
+	for (int32 Index = 0; Index < Altitudes.Num(); Index++)
+	{
+		SimulatedCosts.Add(Altitudes[Index], MoveTemp(Costs[Index]));
 	}
 
-	// Pre-process the trajectory data again for a smarter minimum delta-V
-	float MinDurationWithinMinDeltaV = FLT_MAX;
-	for (const TPair<float, FNovaTrajectory>& AltitudeAndTrajectory : SimulatedTrajectories)
+	// Locate discontinuities in travel duration, which occur when the phasing orbit wraps around
+	for (int32 Index = 0; Index < Altitudes.Num() - 1; Index++)
 	{
-		float                  Altitude   = AltitudeAndTrajectory.Key;
-		const FNovaTrajectory& Trajectory = AltitudeAndTrajectory.Value;
+		RefineDiscontinuity(Altitudes[Index], Altitudes[Index + 1]);
+	}
 
-		if (Trajectory.IsValidExtended())
-		{
-			if (Trajectory.TotalDeltaV < 1.001f * MinDeltaV && Trajectory.TotalTravelDuration.AsMinutes() < MinDurationWithinMinDeltaV)
+	// Refine both minimas within the neighbouring coarse samples
+	UpdateMetrics();
+	if (MinDuration < FLT_MAX)
+	{
+		RefineMinimum(MinDurationAltitude,
+			[](const FNovaTrajectoryCost& Cost)
 			{
-				MinDeltaVWithTolerance     = Trajectory.TotalDeltaV;
-				MinDurationWithinMinDeltaV = Trajectory.TotalTravelDuration.AsMinutes();
-				MinDeltaVAltitude          = Altitude;
-			}
-		}
+				return Cost.TotalTravelDuration.AsMinutes();
+			});
+
+		// The delta-v minimum favors the shortest travel time within tolerance of the lowest delta-v
+		const double DeltaVThreshold = 1.001 * MinDeltaV;
+		const double DurationPenalty = MaxDuration;
+		RefineMinimum(MinDeltaVAltitude,
+			[DeltaVThreshold, DurationPenalty](const FNovaTrajectoryCost& Cost)
+			{
+				const double Duration = Cost.TotalTravelDuration.AsMinutes();
+				return Cost.TotalDeltaV < DeltaVThreshold ? Duration : DurationPenalty + Cost.TotalDeltaV;
+			});
+
+		UpdateMetrics();
 	}
 
 	// Complete display setup
 	NeedTrajectoryDisplayUpdate = true;
 	OptimizeForDeltaV();
 
-	NLOG("NovaTrajectoryCalculator::SimulateTrajectories : simulated %d trajectories in %.2fms", SimulatedTrajectories.Num(),
+	NLOG("NovaTrajectoryCalculator::SimulateTrajectories : simulated %d trajectories in %.2fms", SimulatedCosts.Num(),
 		FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - Cycles));
 }
 
 void SNovaTrajectoryCalculator::OptimizeForDeltaV()
 {
-	if (SimulatedTrajectories.Num())
+	if (SimulatedCosts.Num())
 	{
 		NLOG("SNovaTrajectoryCalculator::OptimizeForDeltaV");
 
 		Slider->SetCurrentValue(MinDeltaVAltitude);
-		OnAltitudeSliderChanged(MinDeltaVAltitude);
+		SelectAltitude(MinDeltaVAltitude);
 	}
 }
 
 void SNovaTrajectoryCalculator::OptimizeForDuration()
 {
-	if (SimulatedTrajectories.Num())
+	if (SimulatedCosts.Num())
 	{
 		NLOG("SNovaTrajectoryCalculator::OptimizeForDuration");
 
 		Slider->SetCurrentValue(MinDurationAltitude);
-		OnAltitudeSliderChanged(MinDurationAltitude);
+		SelectAltitude(MinDurationAltitude);
 	}
 }
 
 /*----------------------------------------------------
-    Callbacks
+    Internals
 ----------------------------------------------------*/
 
-FSlateColor SNovaTrajectoryCalculator::GetBorderColor() const
+const FNovaTrajectoryCost& SNovaTrajectoryCalculator::GetOrComputeCost(float Altitude)
 {
-	return MenuManager->GetInterfaceColor();
+	const FNovaTrajectoryCost* ExistingCost = SimulatedCosts.Find(Altitude);
+	if (ExistingCost)
+	{
+		return *ExistingCost;
+	}
+
+	const ANovaGameState* GameState = MenuManager->GetWorld()->GetGameState<ANovaGameState>();
+	NCHECK(GameState);
+	NCHECK(TrajectoryParameters.IsValid());
+
+	return SimulatedCosts.Add(Altitude, ComputeCostAtAltitude(GameState->GetOrbitalSimulation(), *TrajectoryParameters, Altitude));
 }
 
-bool SNovaTrajectoryCalculator::CanEditTrajectory() const
+void SNovaTrajectoryCalculator::RefineDiscontinuity(float LowerAltitude, float UpperAltitude)
 {
-	return SimulatedTrajectories.Num() > 0;
+	// Measure the relative jump in travel duration between two samples, with validity changes counting as infinite
+	auto GetDiscontinuity = [this](float AltitudeA, float AltitudeB)
+	{
+		const FNovaTrajectoryCost& CostA = SimulatedCosts.FindChecked(AltitudeA);
+		const FNovaTrajectoryCost& CostB = SimulatedCosts.FindChecked(AltitudeB);
+
+		if (CostA.IsValidExtended() != CostB.IsValidExtended())
+		{
+			return DBL_MAX;
+		}
+		else if (!CostA.IsValidExtended())
+		{
+			return 0.0;
+		}
+
+		const double DurationA = CostA.TotalTravelDuration.AsMinutes();
+		const double DurationB = CostB.TotalTravelDuration.AsMinutes();
+		return FMath::Abs(DurationA - DurationB) / FMath::Max(FMath::Min(DurationA, DurationB), 1.0);
+	};
+
+	// Bisect toward the largest jump, stopping when the interval is smooth again
+	while (UpperAltitude - LowerAltitude > AltitudeStep && GetDiscontinuity(LowerAltitude, UpperAltitude) > DurationDiscontinuityFactor)
+	{
+		const float MiddleAltitude = 0.5f * (LowerAltitude + UpperAltitude);
+		GetOrComputeCost(MiddleAltitude);
+
+		if (GetDiscontinuity(LowerAltitude, MiddleAltitude) > GetDiscontinuity(MiddleAltitude, UpperAltitude))
+		{
+			UpperAltitude = MiddleAltitude;
+		}
+		else
+		{
+			LowerAltitude = MiddleAltitude;
+		}
+	}
 }
 
-FText SNovaTrajectoryCalculator::GetDeltaVText() const
+void SNovaTrajectoryCalculator::RefineMinimum(float Altitude, TFunctionRef<double(const FNovaTrajectoryCost&)> Cost)
 {
-	const FNovaTrajectory* Trajectory = SimulatedTrajectories.Find(CurrentAltitude);
-	if (Trajectory && Trajectory->IsValid())
+	constexpr double InverseGoldenRatio = 0.6180339887498949;
+
+	auto Evaluate = [&](float SampleAltitude)
 	{
-		FNumberFormattingOptions NumberOptions;
-		NumberOptions.SetMaximumFractionalDigits(1);
+		const FNovaTrajectoryCost& SampleCost = GetOrComputeCost(SampleAltitude);
+		return SampleCost.IsValidExtended() ? Cost(SampleCost) : DBL_MAX;
+	};
+
+	// Bracket the minimum with the neighbouring coarse samples
+	float  LowerAltitude = FMath::Max(Altitude - CoarseAltitudeStep, Slider->GetMinValue());
+	float  UpperAltitude = FMath::Min(Altitude + CoarseAltitudeStep, Slider->GetMaxValue());
+	float  AltitudeA     = UpperAltitude - InverseGoldenRatio * (UpperAltitude - LowerAltitude);
+	float  AltitudeB     = LowerAltitude + InverseGoldenRatio * (UpperAltitude - LowerAltitude);
+	double CostA         = Evaluate(AltitudeA);
+	double CostB         = Evaluate(AltitudeB);
+
+	// Shrink the bracket, reusing one evaluation per iteration
+	while (UpperAltitude - LowerAltitude > RefinedAltitudeTolerance)
+	{
+		if (CostA < CostB)
+		{
+			UpperAltitude = AltitudeB;
+			AltitudeB     = AltitudeA;
+			CostB         = CostA;
+			AltitudeA     = UpperAltitude - InverseGoldenRatio * (UpperAltitude - LowerAltitude);
+			CostA         = Evaluate(AltitudeA);
+		}
+		else
+		{
+			LowerAltitude = AltitudeA;
+			AltitudeA     = AltitudeB;
+			CostA         = CostB;
+			AltitudeB     = LowerAltitude + InverseGoldenRatio * (UpperAltitude - LowerAltitude);
+			CostB         = Evaluate(AltitudeB);
+		}
+	}
+}
 
-		return FText::FormatNamed(
-			LOCTEXT("DeltaVFormat", "{deltav} m/s"), TEXT("deltav"), FText::AsNumber(Trajectory->TotalDeltaV, &NumberOptions));
+void SNovaTrajectoryCalculator::UpdateMetrics()
+{
+	MinDeltaV              = FLT_MAX;
+	MinDeltaVWithTolerance = FLT_MAX;
+	MaxDeltaV              = 0;
+	MinDuration            = FLT_MAX;
+	MaxDuration            = 0;
+
+	// Process the cost data for absolute minimas and maximas
+	for (const TPair<float, FNovaTrajectoryCost>& AltitudeAndCost : SimulatedCosts)
+	{
+		float                      Altitude = AltitudeAndCost.Key;
+		const FNovaTrajectoryCost& Cost     = AltitudeAndCost.Value;
+
+		if (Cost.IsValidExtended())
+		{
+			double TotalTravelDuration = Cost.TotalTravelDuration.AsMinutes();
+
+			if (FMath::IsFinite(Cost.TotalDeltaV) && FMath::IsFinite(TotalTravelDuration))
+			{
+				if (Cost.TotalDeltaV < MinDeltaV)
+				{
+					MinDeltaV = Cost.TotalDeltaV;
+				}
+				if (Cost.TotalDeltaV > MaxDeltaV)
+				{
+					MaxDeltaV = Cost.TotalDeltaV;
+				}
+				if (TotalTravelDuration < MinDuration)
+				{
+					MinDuration         = TotalTravelDuration;
+					MinDurationAltitude = Altitude;
+				}
+				if (TotalTravelDuration > MaxDuration)
+				{
+					MaxDuration = TotalTravelDuration;
+				}
+			}
+		}
 	}
 
-	return LOCTEXT("InvalidDeltaV", "No trajectory");
+	// Process the cost data again for a smarter minimum delta-V
+	float MinDurationWithinMinDeltaV = FLT_MAX;
+	for (const TPair<float, FNovaTrajectoryCost>& AltitudeAndCost : SimulatedCosts)
+	{
+		float                      Altitude = AltitudeAndCost.Key;
+		const FNovaTrajectoryCost& Cost     = AltitudeAndCost.Value;
+
+		if (Cost.IsValidExtended())
+		{
+			if (Cost.TotalDeltaV < 1.001f * MinDeltaV && Cost.TotalTravelDuration.AsMinutes() < MinDurationWithinMinDeltaV)
+			{
+				MinDeltaVWithTolerance     = Cost.TotalDeltaV;
+				MinDurationWithinMinDeltaV = Cost.TotalTravelDuration.AsMinutes();
+				MinDeltaVAltitude          = Altitude;
+			}
+		}
+	}
 }
 
-FText SNovaTrajectoryCalculator::GetDurationText() const
+void SNovaTrajectoryCalculator::UpdateGradients()
 {
-	const FNovaTrajectory* Trajectory = SimulatedTrajectories.Find(CurrentAltitude);
-	if (Trajectory && Trajectory->IsValid())
+	TrajectoryDeltaVGradientData.Empty();
+	TrajectoryDurationGradientData.Empty();
+
+	// Get the sorted samples
+	SimulatedCosts.KeySort(TLess<float>());
+	TArray<float> Altitudes;
+	SimulatedCosts.GenerateKeyArray(Altitudes);
+	if (Altitudes.Num() < 2)
 	{
-		return ::GetDurationText(Trajectory->TotalTravelDuration, 2);
+		return;
 	}
 
-	return LOCTEXT("InvalidDuration", "No trajectory");
+	auto Transform = [](float Value)
+	{
+		return FMath::LogX(5, Value);
+	};
+
+	// Generate one color per altitude step, interpolating between the neighbouring samples
+	int32 SampleIndex = 0;
+	for (float Altitude = Slider->GetMinValue(); Altitude <= Slider->GetMaxValue(); Altitude += AltitudeStep)
+	{
+		while (SampleIndex < Altitudes.Num() - 2 && Altitudes[SampleIndex + 1] < Altitude)
+		{
+			SampleIndex++;
+		}
+
+		const float                LowerAltitude = Altitudes[SampleIndex];
+		const float                UpperAltitude = Altitudes[SampleIndex + 1];
+		const FNovaTrajectoryCost& LowerCost     = SimulatedCosts.FindChecked(LowerAltitude);
+		const FNovaTrajectoryCost& UpperCost     = SimulatedCosts.FindChecked(UpperAltitude);
+		const float                Alpha         = FMath::Clamp((Altitude - LowerAltitude) / (UpperAltitude - LowerAltitude), 0.0f, 1.0f);
+
+		// Interpolate between valid samples, or fall back to the nearest one
+		double DeltaV;
+		double Duration;
+		if (LowerCost.IsValidExtended() && UpperCost.IsValidExtended())
+		{
+			const double LowerDuration = LowerCost.TotalTravelDuration.AsMinutes();
+			const double UpperDuration = UpperCost.TotalTravelDuration.AsMinutes();
+			DeltaV                     = FMath::Lerp(LowerCost.TotalDeltaV, UpperCost.TotalDeltaV, static_cast<double>(Alpha));
+			Duration                   = FMath::Lerp(LowerDuration, UpperDuration, static_cast<double>(Alpha));
+		}
+		else
+		{
+			const FNovaTrajectoryCost& NearestCost = Alpha < 0.5f ? LowerCost : UpperCost;
+			if (!NearestCost.IsValidExtended())
+			{
+				TrajectoryDeltaVGradientData.Add(FLinearColor::Black);
+				TrajectoryDurationGradientData.Add(FLinearColor::Black);
+				continue;
+			}
+
+			DeltaV   = NearestCost.TotalDeltaV;
+			Duration = NearestCost.TotalTravelDuration.AsMinutes();
+		}
+
+		double DeltaVAlpha =
+			FMath::Clamp((Transform(DeltaV) - Transform(MinDeltaV)) / (Transform(MaxDeltaV) - Transform(MinDeltaV)), 0.0f, 1.0f);
+		double DurationAlpha =
+			FMath::Clamp((Transform(Duration) - Transform(MinDuration)) / (Transform(MaxDuration) - Transform(MinDuration)), 0.0f, 1.0f);
+
+		TrajectoryDeltaVGradientData.Add(FNeutronStyleSet::GetViridisColor(DeltaVAlpha));
+		TrajectoryDurationGradientData.Add(FNeutronStyleSet::GetViridisColor(DurationAlpha));
+	}
 }
 
-void SNovaTrajectoryCalculator::OnAltitudeSliderChanged(float Altitude)
+void SNovaTrajectoryCalculator::SelectAltitude(float Altitude)
 {
-	CurrentAltitude =
-		Slider->GetMinValue() + FMath::RoundToInt((Altitude - Slider->GetMinValue()) / static_cast<float>(AltitudeStep)) * AltitudeStep;
+	CurrentAltitude = Altitude;
 
 	FString TrajectoryDetails;
 
-	const FNovaTrajectory* Trajectory = SimulatedTrajectories.Find(CurrentAltitude);
-	if (Trajectory)
+	// Only the selected trajectory is fully built, with the same parameters as the sampled costs
+	const FNovaTrajectoryCost* Cost = TrajectoryParameters.IsValid() ? &GetOrComputeCost(CurrentAltitude) : nullptr;
+	CurrentTrajectory               = FNovaTrajectory();
+	if (Cost)
 	{
 		bool HasEnoughPropellant = true;
 
@@ -490,7 +652,9 @@ void SNovaTrajectoryCalculator::OnAltitudeSliderChanged(float Altitude)
 
 					// Process remaining propellant
 					float PropellantRemaining = PropellantSystem->GetCurrentPropellantMass();
-					float PropellantUsed = Trajectory->GetTotalPropellantUsed(CurrentSpacecraftIndex, Spacecraft->GetPropulsionMetrics());
+					float PropellantUsed = Cost->PropellantUsed.IsValidIndex(CurrentSpacecraftIndex)
+						                     ? Cost->PropellantUsed[CurrentSpacecraftIndex]
+						                     : 0.0f;
 					if (HasEnoughPropellant && PropellantUsed > PropellantRemaining)
 					{
 						HasEnoughPropellant = false;
@@ -522,18 +686,68 @@ void SNovaTrajectoryCalculator::OnAltitudeSliderChanged(float Altitude)
 				IsValid(GameState) && Spacecraft ? GameState->GetSpacecraftSystem<UNovaSpacecraftCrewSystem>(Spacecraft) : nullptr;
 			if (CrewSystem)
 			{
-				FNovaCredits Cost = FMath::CeilToInt(Trajectory->TotalTravelDuration.AsDays()) * CrewSystem->GetDailyCost();
+				FNovaCredits CrewCost = FMath::CeilToInt(Cost->TotalTravelDuration.AsDays()) * CrewSystem->GetDailyCost();
 				TrajectoryDetails += TEXT("\n• ");
 				TrajectoryDetails += FText::FormatNamed(
-					LOCTEXT("FlightPlanCrewFormat", "Your crew will require {credits} in pay"), TEXT("credits"), GetPriceText(Cost))
+					LOCTEXT("FlightPlanCrewFormat", "Your crew will require {credits} in pay"), TEXT("credits"), GetPriceText(CrewCost))
 				                         .ToString();
 			}
 		}
 
-		OnTrajectoryChanged.ExecuteIfBound(*Trajectory, HasEnoughPropellant);
+		// Build the trajectory itself
+		if (Cost->IsValid())
+		{
+			CurrentTrajectory = GameState->GetOrbitalSimulation()->ComputeTrajectory(*TrajectoryParameters, CurrentAltitude);
+		}
+
+		OnTrajectoryChanged.ExecuteIfBound(CurrentTrajectory, HasEnoughPropellant);
 	}
 
 	PropellantText->SetText(FText::FromString(TrajectoryDetails));
 }
 
+/*----------------------------------------------------
+    Callbacks
+----------------------------------------------------*/
+
+FSlateColor SNovaTrajectoryCalculator::GetBorderColor() const
+{
+	return MenuManager->GetInterfaceColor();
+}
+
+bool SNovaTrajectoryCalculator::CanEditTrajectory() const
+{
+	return SimulatedCosts.Num() > 0;
+}
+
+FText SNovaTrajectoryCalculator::GetDeltaVText() const
+{
+	if (CurrentTrajectory.IsValid())
+	{
+		FNumberFormattingOptions NumberOptions;
+		NumberOptions.SetMaximumFractionalDigits(1);
+
+		return FText::FormatNamed(
+			LOCTEXT("DeltaVFormat", "{deltav} m/s"), TEXT("deltav"), FText::AsNumber(CurrentTrajectory.TotalDeltaV, &NumberOptions));
+	}
+
+	return LOCTEXT("InvalidDeltaV", "No trajectory");
+}
+
+FText SNovaTrajectoryCalculator::GetDurationText() const
+{
+	if (CurrentTrajectory.IsValid())
+	{
+		return ::GetDurationText(CurrentTrajectory.TotalTravelDuration, 2);
+	}
+
+	return LOCTEXT("InvalidDuration", "No trajectory");
+}
+
+void SNovaTrajectoryCalculator::OnAltitudeSliderChanged(float Altitude)
+{
+	SelectAltitude(
+		Slider->GetMinValue() + FMath::RoundToInt((Altitude - Slider->GetMinValue()) / static_cast<float>(AltitudeStep)) * AltitudeStep);
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -69,6 +69,30 @@ public:
 	/** Optimize for travel time */
 	void OptimizeForDuration();
 
+	/*----------------------------------------------------
+	    Internals
+	----------------------------------------------------*/
+
+protected:
+
+	/** Get the trajectory cost for a phasing altitude, computing it if it wasn't sampled yet */
+	const FNovaTrajectoryCost& GetOrComputeCost(float Altitude);
+
+	/** Sample the interval between two altitudes until the discontinuity in travel duration it contains is narrower than AltitudeStep */
+	void RefineDiscontinuity(float LowerAltitude, float UpperAltitude);
+
+	/** Refine a minimum found around Altitude with a golden-section search on Cost */
+	void RefineMinimum(float Altitude, TFunctionRef<double(const FNovaTrajectoryCost&)> Cost);
+
+	/** Compute the extremas and optimal altitudes from all samples */
+	void UpdateMetrics();
+
+	/** Generate the gradients by interpolating between samples */
+	void UpdateGradients();
+
+	/** Select a phasing altitude, build the full trajectory and notify it */
+	void SelectAltitude(float Altitude);
+
 	/*----------------------------------------------------
 	    Callbacks
 	----------------------------------------------------*/
@@ -107,15 +131,17 @@ protected:
 	int32                               AltitudeStep;
 
 	// Trajectory data
-	TArray<FGuid>                PlayerIdentifiers;
-	TMap<float, FNovaTrajectory> SimulatedTrajectories;
-	float                        MinDeltaV;
-	float                        MinDeltaVWithTolerance;
-	float                        MaxDeltaV;
-	float                        MinDuration;
-	float                        MaxDuration;
-	float                        MinDeltaVAltitude;
-	float                        MinDurationAltitude;
+	TArray<FGuid>                                PlayerIdentifiers;
+	TSharedPtr<struct FNovaTrajectoryParameters> TrajectoryParameters;
+	TMap<float, FNovaTrajectoryCost>             SimulatedCosts;
+	FNovaTrajectory                              CurrentTrajectory;
+	float                                        MinDeltaV;
+	float                                        MinDeltaVWithTolerance;
+	float                                        MaxDeltaV;
+	float                                        MinDuration;
+	float                                        MaxDuration;
+	float                                        MinDeltaVAltitude;
+	float                                        MinDurationAltitude;
 
 	// Display data
 	TArray<FLinearColor> TrajectoryDeltaVGradientData;